@@ -2,20 +2,31 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <bit>
 #include <bitset>
 #include <cassert>
+#include <chrono>
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <deque>
 #include <exception>
 #include <filesystem>
 #include <fstream>
 #include <functional>
 #include <iostream>
+#include <limits>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <new>
 #include <optional>
 #include <queue>
 #include <set>
+#include <span>
+#include <unordered_map>
 #include <unordered_set>
 #include <sstream>
 #include <string>
@@ -27,6 +38,8 @@
 #include <variant>
 #include <vector>
 #include <concepts>
+#include <condition_variable>
+#include <coroutine>
 #include <ranges>
 
 #include "avk/avk_log.hpp"
@@ -71,6 +84,24 @@
 #define AVK_STAGING_BUFFER_READBACK_MEMORY_USAGE avk::memory_usage::host_visible
 #endif
 
+/** CONFIG SETTING: AVK_COMMAND_FUNCTION_INLINE_CAPACITY
+ *
+ *	The following setting CAN be set BEFORE including avk.hpp in order to change the
+ *	number of bytes which the recording functions of state_type_command and action_type_command
+ *	can store inline (see avk::inline_function). Lambdas whose captures fit into this
+ *	capacity do not cause any heap allocation when being recorded.
+ *
+ *	Every state_type_command and action_type_command contains this storage (the latter twice, for
+ *	its begin and end functions), i.e., a larger capacity increases the size of every recorded command.
+ *	By default, 64 bytes are used, which is enough for the recording functions of the factory functions
+ *	for binding pipelines and descriptors, draw calls with up to two vertex buffers (indexed draw calls
+ *	with one), dispatches, buffer copies, and for push constants of up to 48 bytes. Larger callables
+ *	are stored on the heap.
+ */
+#if !defined(AVK_COMMAND_FUNCTION_INLINE_CAPACITY)
+#define AVK_COMMAND_FUNCTION_INLINE_CAPACITY 64
+#endif
+
 /** CONFIG SETTING: AVK_USE_CORE_INSTEAD_OF_SYNCHRONIZATION2
  *	If this is defined BEFORE including avk.hpp, the Vulkan API core functions are used 
  *	instead of the Synchronization2 extension functions (which were promoted to core with
@@ -130,6 +161,16 @@ namespace avk
  *	        can find VMA under <vma/vk_mem_alloc.h>. This can be accomplished by installing VMA
  *			through the Vulkan SDK. On Linux it is probably <vk_mem_alloc.h>. Both paths are considered.
  */
+
+/** CONFIG SETTING: AVK_USE_BLOCK_ALLOCATOR
+ *
+ *	Define the macro AVK_USE_BLOCK_ALLOCATOR (and not AVK_USE_VMA) to sub-allocate all resources
+ *	from large per-memory-type blocks via avk::block_allocator instead of making one memory
+ *	allocation per resource. The root's memory_allocator() must then return an avk::block_allocator*
+ *	which outlives all resources that have been created through it.
+ */
+#include "avk/block_allocator.hpp"
+
 #if defined(AVK_USE_VMA)
 #if __has_include(<vma/vk_mem_alloc.h>)
 #define AVK_USES_VMA
@@ -150,6 +191,17 @@ static_assert(false, "Unable to find include <vma/vk_mem_alloc.h> or <vk_mem_all
 #define AVK_MEM_BUFFER_HANDLE        avk::vma_handle<vk::Buffer>
 #endif
 #include "avk/vma_handle.hpp"
+#elif defined(AVK_USE_BLOCK_ALLOCATOR)
+#if !defined(AVK_MEM_ALLOCATOR_TYPE)
+#define AVK_MEM_ALLOCATOR_TYPE       avk::block_allocator*
+#endif
+#if !defined(AVK_MEM_IMAGE_HANDLE)
+#define AVK_MEM_IMAGE_HANDLE         avk::block_handle<vk::Image>
+#endif
+#if !defined(AVK_MEM_BUFFER_HANDLE)
+#define AVK_MEM_BUFFER_HANDLE        avk::block_handle<vk::Buffer>
+#endif
+#include "avk/block_handle.hpp"
 #else
 #include "avk/mem_handle.hpp"
 #endif
@@ -221,6 +273,7 @@ namespace avk
 }
 
 #include "avk/buffer.hpp"
+#include "avk/baked_parameters.hpp"
 #include "avk/shader_info.hpp"
 
 #include "avk/shader_binding_table.hpp"
@@ -229,6 +282,7 @@ namespace avk
 
 #include "avk/semaphore.hpp"
 #include "avk/fence.hpp"
+#include "avk/event.hpp"
 
 #include "avk/image.hpp"
 #include "avk/image_view.hpp"
@@ -269,7 +323,22 @@ namespace avk
 #include "avk/bindings.hpp"
 
 #include "avk/commands.hpp"
+#include "avk/resource_state_tracker.hpp"
+#include "avk/sync_analysis.hpp"
+#include "avk/command_stream.hpp"
 #include "avk/queue.hpp"
+#include "avk/submission_batcher.hpp"
+#include "avk/submission_service.hpp"
+#include "avk/retirement_queue.hpp"
+#include "avk/command_buffer_recycler.hpp"
+#include "avk/sync_object_pools.hpp"
+#include "avk/completion_set.hpp"
+#include "avk/cross_queue_scheduler.hpp"
+#include "avk/completion_reactor.hpp"
+#include "avk/frame_context.hpp"
+#include "avk/staging_ring.hpp"
+#include "avk/upload_batcher.hpp"
+#include "avk/worker_pool.hpp"
 
 namespace avk
 {
@@ -294,6 +363,23 @@ namespace avk
 		virtual const DISPATCH_LOADER_EXT_TYPE& dispatch_loader_ext() const		= 0;
 		virtual const AVK_MEM_ALLOCATOR_TYPE& memory_allocator() const			= 0;
 
+		/**	The queue which resources can be retired into, s.t. they are destroyed once the GPU is done with them.
+		 *	Not provided by default; override this in order to make a retirement_queue available to all users of the root.
+		 */
+		virtual retirement_queue* resource_retirement_queue() { return nullptr; }
+
+		/**	The ring which buffer_t::fill stages its uploads to device-local buffers in.
+		 *	Not provided by default, i.e., a dedicated staging buffer is created per upload; override this in order to
+		 *	make a staging_ring available to all users of the root.
+		 */
+		virtual staging_ring* upload_staging_ring() const { return nullptr; }
+
+		/**	The pool which recorded_commands::split_barriers acquires its events from.
+		 *	Not provided by default, i.e., new events are created for every invocation; override this in order to make
+		 *	an event_pool available to all users of the root.
+		 */
+		virtual event_pool* split_barrier_event_pool() const { return nullptr; }
+
 #pragma region root helper functions
 		/** Prints all the different memory types that are available on the device along with its memory property flags. */
 		void print_available_memory_types();
@@ -534,6 +620,14 @@ namespace avk
 		//}
 #pragma endregion
 
+#pragma region baked parameters
+		/**	Create a block of parameters which can be patched between submissions of a command buffer
+		 *	that has been recorded only once. See baked_parameters_t for details.
+		 *	@param	aSizeInBytes	Capacity of the block. Parameters are declared via baked_parameters_t::declare.
+		 */
+		baked_parameters create_baked_parameters(vk::DeviceSize aSizeInBytes);
+#pragma endregion
+
 #pragma region buffer view
 		/**	Create a buffer view over the given buffer in the specified format.
 		 *
@@ -653,6 +747,11 @@ namespace avk
 		set_of_descriptor_set_layouts create_set_of_descriptor_set_layouts_from_template(const set_of_descriptor_set_layouts& aTemplate);
 #pragma endregion
 
+#pragma region event
+		static event create_event(vk::Device aDevice, const DISPATCH_LOADER_CORE_TYPE& aDispatchLoader, std::function<void(event_t&)> aAlterConfigBeforeCreation = {});
+		event create_event(std::function<void(event_t&)> aAlterConfigBeforeCreation = {});
+#pragma endregion
+
 #pragma region fence
 		static fence create_fence(vk::Device aDevice, const DISPATCH_LOADER_CORE_TYPE& aDispatchLoader, bool aCreateInSignalledState = false, std::function<void(fence_t&)> aAlterConfigBeforeCreation = {});
 		fence create_fence(bool aCreateInSignalledState = false, std::function<void(fence_t&)> aAlterConfigBeforeCreation = {});
@@ -975,6 +1074,16 @@ namespace avk
 #pragma region semaphore
 		static semaphore create_semaphore(vk::Device aDevice, const DISPATCH_LOADER_CORE_TYPE& aDispatchLoader, std::function<void(semaphore_t&)> aAlterConfigBeforeCreation = {});
 		semaphore create_semaphore(std::function<void(semaphore_t&)> aAlterConfigBeforeCreation = {});
+
+		/**	Create a timeline semaphore, i.e., a semaphore with a 64-bit counter value which only ever increases.
+		 *	One timeline semaphore per queue can replace the per-frame fences and binary semaphores: every submission
+		 *	signals the next counter value, and both, the host and other submissions wait for the value they depend on.
+		 *	Requires Vulkan 1.2 or VK_KHR_timeline_semaphore, and the timelineSemaphore device feature to be enabled.
+		 *	@param	aInitialValue				The counter value which the semaphore has after creation.
+		 *	@param	aAlterConfigBeforeCreation	Use it to alter the semaphore_t configuration before it is actually being created.
+		 */
+		static semaphore create_timeline_semaphore(vk::Device aDevice, const DISPATCH_LOADER_CORE_TYPE& aDispatchLoader, uint64_t aInitialValue = 0, std::function<void(semaphore_t&)> aAlterConfigBeforeCreation = {});
+		semaphore create_timeline_semaphore(uint64_t aInitialValue = 0, std::function<void(semaphore_t&)> aAlterConfigBeforeCreation = {});
 #pragma endregion
 
 #pragma region shader
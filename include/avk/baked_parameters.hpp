@@ -0,0 +1,126 @@
+#pragma once
+#include "avk/avk.hpp"
+
+namespace avk
+{
+	/**	A handle to one parameter which has been declared in a baked_parameters_t block.
+	 *	It stores nothing but the parameter's byte offset into the block's buffer, i.e., it can be
+	 *	passed to commands which read from the buffer (like command::dispatch_indirect,
+	 *	command::draw_indirect, or command::draw_indexed_indirect) or used as the offset of a
+	 *	uniform/storage buffer range.
+	 */
+	template <typename T>
+	struct baked_parameter
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable types can be patched through device memory.");
+
+		/**	Byte offset of this parameter into baked_parameters_t::buffer() */
+		vk::DeviceSize mOffset = 0;
+
+		/**	Size of this parameter in bytes */
+		static constexpr vk::DeviceSize size() { return static_cast<vk::DeviceSize>(sizeof(T)); }
+	};
+
+	/**	A block of parameters which can be changed between submissions of a command buffer
+	 *	without having to record the command buffer again.
+	 *
+	 *	All parameters live in one host-coherent buffer which stays persistently mapped. Commands
+	 *	which are recorded once read their parameters from this buffer (e.g., indirect dispatch or
+	 *	draw arguments, or uniform/storage buffer ranges that replace push constants), and the
+	 *	parameters are patched via set() before each submission. That makes steady-state frames
+	 *	independent of the number of recorded commands.
+	 *
+	 *	Only the contents of the buffer can be patched. Which range of it a shader reads is fixed at
+	 *	record time: even the dynamic offset of a dynamic uniform/storage buffer is baked into the
+	 *	command buffer when its descriptor set is bound. Hence, parameters which shall be patched
+	 *	must be read from a range that is bound at their declared offset, and changing which
+	 *	parameter is read requires recording again:
+	 *
+	 *	auto params = root.create_baked_parameters(1024);
+	 *	auto dispatchSize = params->declare(vk::DispatchIndirectCommand{ 1, 1, 1 });
+	 *	auto cmdBfr = commandPool->alloc_command_buffer(); // not vk::CommandBufferUsageFlagBits::eOneTimeSubmit
+	 *	// Record once:
+	 *	... command::dispatch_indirect(params->buffer(), dispatchSize.mOffset) ...
+	 *	// Every frame:
+	 *	params->set(dispatchSize, vk::DispatchIndirectCommand{ x, y, 1 });
+	 *	queue.submit(cmdBfr.get()) ...
+	 *
+	 *	Patching happens on the host, i.e., a parameter must not be set while a previous submission
+	 *	which reads it might still be executing. With multiple frames in flight, create one
+	 *	baked_parameters block (and one baked command buffer) per frame in flight.
+	 */
+	class baked_parameters_t
+	{
+		friend class root;
+
+	public:
+		baked_parameters_t() = default;
+		baked_parameters_t(const baked_parameters_t&) = delete;
+		baked_parameters_t(baked_parameters_t&&) noexcept = default;
+		baked_parameters_t& operator=(const baked_parameters_t&) = delete;
+		baked_parameters_t& operator=(baked_parameters_t&&) noexcept = default;
+		~baked_parameters_t() = default;
+
+		/**	Reserve space for a parameter of type T in this block and write its initial value.
+		 *	@param	aInitialValue	The value the parameter shall have until it is set() for the first time.
+		 *	@param	aAlignment		Additional alignment requirement for the parameter's offset. The offset is
+		 *							always aligned to alignof(T) and to the device's minimum uniform and storage
+		 *							buffer offset alignments, s.t. it can be used as the offset of a buffer range
+		 *							(or as a dynamic offset, which is fixed at record time, too).
+		 *	@return	A handle to the parameter, which contains its byte offset into buffer().
+		 */
+		template <typename T>
+		baked_parameter<T> declare(const T& aInitialValue = T{}, vk::DeviceSize aAlignment = 0)
+		{
+			const auto alignment = std::max({ static_cast<vk::DeviceSize>(alignof(T)), aAlignment, mMinAlignment, vk::DeviceSize{ 1 } });
+			const auto offset = (mNextOffset + alignment - 1) / alignment * alignment;
+			if (offset + sizeof(T) > size_in_bytes()) {
+				throw avk::runtime_error("Not enough space left in the baked_parameters block to declare a parameter of " + std::to_string(sizeof(T)) + " bytes. Its size is " + std::to_string(size_in_bytes()) + " bytes, and " + std::to_string(mNextOffset) + " bytes are already in use.");
+			}
+			mNextOffset = offset + sizeof(T);
+
+			baked_parameter<T> result{ offset };
+			set(result, aInitialValue);
+			return result;
+		}
+
+		/**	Patch the value of a parameter. The new value will be read by all submissions which are issued afterwards. */
+		template <typename T>
+		void set(const baked_parameter<T>& aParameter, const T& aValue)
+		{
+			assert(aParameter.mOffset + sizeof(T) <= mNextOffset);
+			std::memcpy(static_cast<std::byte*>(mMappedMemory) + aParameter.mOffset, &aValue, sizeof(T));
+		}
+
+		/**	Get the value which has most recently been set for the given parameter. */
+		template <typename T>
+		T get(const baked_parameter<T>& aParameter) const
+		{
+			assert(aParameter.mOffset + sizeof(T) <= mNextOffset);
+			T result;
+			std::memcpy(&result, static_cast<const std::byte*>(mMappedMemory) + aParameter.mOffset, sizeof(T));
+			return result;
+		}
+
+		/**	The buffer which stores all the parameters of this block. */
+		const buffer_t& buffer() const { return mBuffer.get(); }
+
+		/**	A (shared) owning handle to the buffer, s.t. its lifetime can be handled by a command buffer. */
+		const avk::buffer& buffer_resource() const { return mBuffer; }
+
+		/**	Total capacity of this block in bytes. */
+		vk::DeviceSize size_in_bytes() const { return mBuffer->meta_at_index<buffer_meta>().total_size(); }
+
+		/**	Number of bytes which are already occupied by declared parameters (including alignment padding). */
+		vk::DeviceSize size_in_use() const { return mNextOffset; }
+
+	private:
+		avk::buffer mBuffer;
+		std::optional<scoped_mapping<AVK_MEM_BUFFER_HANDLE>> mMapping;
+		void* mMappedMemory = nullptr;
+		vk::DeviceSize mNextOffset = 0;
+		vk::DeviceSize mMinAlignment = 1;
+	};
+
+	using baked_parameters = avk::owning_resource<baked_parameters_t>;
+}
@@ -0,0 +1,217 @@
+#pragma once
+#include "avk/avk.hpp"
+
+namespace avk
+{
+	/**	Manages the free space of one contiguous range of memory, e.g., of one vk::DeviceMemory block, in terms of offsets.
+	 *	Free chunks are kept in a two-level segregated fit (TLSF) structure: The first level partitions chunk sizes into powers
+	 *	of two, the second level subdivides each of them linearly. Two bitmaps indicate which lists are non-empty, s.t. both,
+	 *	allocate and free, are O(1). Adjacent free chunks are always merged.
+	 */
+	class tlsf_free_list
+	{
+	public:
+		/** Value of a chunk index which does not refer to any chunk */
+		static constexpr uint32_t no_chunk = std::numeric_limits<uint32_t>::max();
+
+		/**	@param	aSize	Size of the managed range, which is entirely free initially. */
+		explicit tlsf_free_list(vk::DeviceSize aSize);
+		tlsf_free_list(const tlsf_free_list&) = default;
+		tlsf_free_list(tlsf_free_list&&) noexcept = default;
+		tlsf_free_list& operator=(const tlsf_free_list&) = default;
+		tlsf_free_list& operator=(tlsf_free_list&&) noexcept = default;
+		~tlsf_free_list() = default;
+
+		/**	Allocate a range of the given size, whose offset is a multiple of the given alignment.
+		 *	@return	The offset of the range and the index of its chunk (which is required to free it),
+		 *			or no value if there is no free chunk which is large enough.
+		 */
+		std::optional<std::tuple<vk::DeviceSize, uint32_t>> allocate(vk::DeviceSize aSize, vk::DeviceSize aAlignment);
+
+		/**	Allocate a range of the given size at offset 0, which satisfies every alignment. In contrast to allocate, this
+		 *	succeeds whenever the whole managed range is free and at least as large as the requested size.
+		 *	@return	The offset of the range (i.e., 0) and the index of its chunk, or no value if anything is allocated already.
+		 */
+		std::optional<std::tuple<vk::DeviceSize, uint32_t>> allocate_front(vk::DeviceSize aSize);
+
+		/**	Free a range which has been allocated before. */
+		void free(uint32_t aChunk);
+
+		/** Size of the managed range */
+		vk::DeviceSize size() const { return mSize; }
+
+		/** Number of bytes which are currently allocated (including alignment padding that could not be split off) */
+		vk::DeviceSize size_in_use() const { return mSizeInUse; }
+
+		/** True if nothing is allocated */
+		bool empty() const { return 0 == mSizeInUse; }
+
+	private:
+		static constexpr uint32_t sl_bits = 4;
+		static constexpr uint32_t sl_count = 1u << sl_bits;
+		static constexpr uint32_t fl_count = 64 - sl_bits + 1;
+
+		struct chunk
+		{
+			vk::DeviceSize mOffset;
+			vk::DeviceSize mSize;
+			// Neighbors in terms of offsets:
+			uint32_t mPrevPhysical;
+			uint32_t mNextPhysical;
+			// Neighbors within the same free list:
+			uint32_t mPrevFree;
+			uint32_t mNextFree;
+			bool mIsFree;
+		};
+
+		// The first- and second-level index of the free list which a chunk of the given size belongs to
+		static std::tuple<uint32_t, uint32_t> list_index(vk::DeviceSize aSize);
+
+		// Marks the given free chunk (which must have been removed from its free list) as allocated, and splits off the remainder behind aSize:
+		std::tuple<vk::DeviceSize, uint32_t> take(uint32_t aChunk, vk::DeviceSize aSize);
+
+		uint32_t new_chunk();
+		void release_chunk(uint32_t aChunk);
+		void insert_free(uint32_t aChunk);
+		void remove_free(uint32_t aChunk);
+
+		std::vector<chunk> mChunks;
+		std::vector<uint32_t> mUnusedChunks;
+		uint64_t mFlBitmap = 0;
+		std::array<uint32_t, fl_count> mSlBitmaps;
+		std::array<std::array<uint32_t, sl_count>, fl_count> mFreeHeads;
+		vk::DeviceSize mSize;
+		vk::DeviceSize mSizeInUse = 0;
+	};
+
+	/**	A range of a vk::DeviceMemory block, which has been handed out by a block_allocator. */
+	struct block_allocation
+	{
+		vk::DeviceMemory mMemory;
+		vk::DeviceSize mOffset = 0;
+		vk::DeviceSize mSize = 0;
+		uint32_t mMemoryTypeIndex = 0;
+		vk::MemoryPropertyFlags mMemoryPropertyFlags;
+		/** Address of the range if the memory is host visible (blocks stay mapped for their whole lifetime), nullptr otherwise */
+		void* mMappedMemory = nullptr;
+
+		// Where the range has been allocated from, s.t. the block_allocator can free it:
+		uint32_t mBlockList = 0;
+		uint32_t mBlock = 0;
+		uint32_t mChunk = tlsf_free_list::no_chunk;
+	};
+
+	/**	Statistics of a block_allocator. */
+	struct block_allocator_statistics
+	{
+		/** Number of vk::DeviceMemory allocations which currently exist */
+		uint32_t mNumDeviceMemoryAllocations = 0;
+		/** Number of ranges which are currently handed out */
+		uint32_t mNumAllocations = 0;
+		/** Total size of all vk::DeviceMemory allocations */
+		vk::DeviceSize mAllocatedBytes = 0;
+		/** Number of bytes within them which are currently handed out */
+		vk::DeviceSize mUsedBytes = 0;
+	};
+
+	/**	Sub-allocates memory for resources from large vk::DeviceMemory blocks, instead of performing one driver allocation
+	 *	per resource. Used by block_handle if AVK_USE_BLOCK_ALLOCATOR is defined.
+	 *
+	 *	There are separate lists of blocks per memory type. If bufferImageGranularity is greater than 1, linear resources
+	 *	(buffers and linearly tiled images) and optimally tiled images are placed in separate blocks, s.t. they never end up
+	 *	next to each other. Resources which require memory with the device address flag are placed in separate blocks, too.
+	 *	The free space of every block is managed by a tlsf_free_list. Host visible blocks are mapped persistently.
+	 *	Resources which are larger than half a block get a dedicated block. Empty blocks are freed, except for one per list.
+	 *
+	 *	The allocation logic does not depend on a device: The constructor which takes the memory properties and the functions
+	 *	that allocate, free, and map vk::DeviceMemory can be fed with made-up memory types and fake functions.
+	 *	All member functions are thread-safe.
+	 */
+	class block_allocator
+	{
+	public:
+		static constexpr vk::DeviceSize default_block_size = 256 * 1024 * 1024;
+
+		/**	Create a block allocator which allocates through the given device.
+		 *	@param	aPreferredBlockSize		Size of the blocks, which is reduced to an eighth of a heap's size for small heaps.
+		 */
+		block_allocator(vk::PhysicalDevice aPhysicalDevice, vk::Device aDevice, vk::DeviceSize aPreferredBlockSize = default_block_size);
+
+		/**	Create a block allocator which allocates through the given functions.
+		 *	@param	aMemoryProperties			The memory types and heaps to allocate from.
+		 *	@param	aBufferImageGranularity		See VkPhysicalDeviceLimits::bufferImageGranularity
+		 *	@param	aNonCoherentAtomSize		See VkPhysicalDeviceLimits::nonCoherentAtomSize
+		 *	@param	aAllocateMemory				Allocates a block of the given memory type index and size, with the given flags.
+		 *	@param	aFreeMemory					Frees a block.
+		 *	@param	aMapMemory					Maps a whole host visible block.
+		 *	@param	aPreferredBlockSize			Size of the blocks, which is reduced to an eighth of a heap's size for small heaps.
+		 */
+		block_allocator(
+			const vk::PhysicalDeviceMemoryProperties& aMemoryProperties,
+			vk::DeviceSize aBufferImageGranularity,
+			vk::DeviceSize aNonCoherentAtomSize,
+			std::function<vk::DeviceMemory(uint32_t, vk::DeviceSize, vk::MemoryAllocateFlags)> aAllocateMemory,
+			std::function<void(vk::DeviceMemory)> aFreeMemory,
+			std::function<void*(vk::DeviceMemory)> aMapMemory,
+			vk::DeviceSize aPreferredBlockSize = default_block_size
+		);
+
+		block_allocator(const block_allocator&) = delete;
+		block_allocator(block_allocator&&) noexcept = delete;
+		block_allocator& operator=(const block_allocator&) = delete;
+		block_allocator& operator=(block_allocator&&) noexcept = delete;
+		/**	Frees all blocks. All allocations must have been freed before. */
+		~block_allocator();
+
+		/**	Allocate memory for a resource with the given requirements.
+		 *	@param	aMemoryProperties	Minimum memory properties; the first memory type which has all of them is used.
+		 *	@param	aLinearResource		true for buffers and linearly tiled images, false for optimally tiled images.
+		 *	@param	aAllocateFlags		Flags which the block must have been allocated with, e.g., eDeviceAddress.
+		 */
+		block_allocation allocate(const vk::MemoryRequirements& aRequirements, vk::MemoryPropertyFlags aMemoryProperties, bool aLinearResource, vk::MemoryAllocateFlags aAllocateFlags = {});
+
+		/**	Free an allocation. The resource which has been bound to it must have been destroyed before. */
+		void free(const block_allocation& aAllocation);
+
+		/**	The index of the first memory type which is included in aMemoryTypeBits and has (at least) the given properties,
+		 *	and that memory type's actual properties. */
+		std::tuple<uint32_t, vk::MemoryPropertyFlags> find_memory_type_index(uint32_t aMemoryTypeBits, vk::MemoryPropertyFlags aMemoryProperties) const;
+
+		/** The physical device which this allocator has been created for (none if it has been created with custom functions) */
+		vk::PhysicalDevice physical_device() const { return mPhysicalDevice; }
+
+		/** The device which this allocator has been created for (none if it has been created with custom functions) */
+		vk::Device device() const { return mDevice; }
+
+		vk::DeviceSize non_coherent_atom_size() const { return mNonCoherentAtomSize; }
+
+		block_allocator_statistics statistics() const;
+
+	private:
+		struct memory_block
+		{
+			vk::DeviceMemory mMemory;
+			void* mMappedMemory;
+			tlsf_free_list mFreeList;
+			bool mIsDedicated;
+		};
+
+		// The block list for the given memory type and kind of resource:
+		uint32_t block_list_index(uint32_t aMemoryTypeIndex, bool aLinearResource, vk::MemoryAllocateFlags aAllocateFlags) const;
+
+		vk::PhysicalDeviceMemoryProperties mMemoryProperties;
+		vk::DeviceSize mBufferImageGranularity;
+		vk::DeviceSize mNonCoherentAtomSize;
+		std::function<vk::DeviceMemory(uint32_t, vk::DeviceSize, vk::MemoryAllocateFlags)> mAllocateMemory;
+		std::function<void(vk::DeviceMemory)> mFreeMemory;
+		std::function<void*(vk::DeviceMemory)> mMapMemory;
+		std::vector<vk::DeviceSize> mBlockSizes; // per memory type
+		vk::PhysicalDevice mPhysicalDevice;
+		vk::Device mDevice;
+
+		mutable std::mutex mMutex;
+		// Four lists per memory type: { optimal, linear } x { without, with device address }
+		std::vector<std::vector<std::unique_ptr<memory_block>>> mBlockLists;
+		uint32_t mNumAllocations = 0;
+	};
+}
@@ -0,0 +1,236 @@
+#pragma once
+#include "avk/avk.hpp"
+
+namespace avk
+{
+	/**	Class handling the lifetime of one resource + its range of a block which has been sub-allocated via avk::block_allocator.
+	 *	Also provides some convenience methods.
+	 */
+	template <typename T>
+	struct block_handle
+	{
+		/** Construct emptyness */
+		block_handle() : mAllocator{nullptr}, mAllocation{}, mResource{nullptr}
+		{ }
+
+		/**	Create the resource, sub-allocate memory for it, and bind it.
+		 *	This is only implemented for certain types via template specialization: vk::Buffer, vk::Image
+		 */
+		template <typename C>
+		block_handle(block_allocator* aAllocator, vk::MemoryPropertyFlags aMemPropFlags, const C& aResourceCreateInfo);
+
+		/** Move-construct a block_handle */
+		block_handle(block_handle&& aOther) noexcept : mAllocator{nullptr}, mAllocation{}, mResource{nullptr}
+		{
+			std::swap(mAllocator,  aOther.mAllocator);
+			std::swap(mAllocation, aOther.mAllocation);
+			std::swap(mResource,   aOther.mResource);
+		}
+
+		block_handle(const block_handle& aOther) = delete;
+
+		/** Move-assign a block_handle */
+		block_handle& operator=(block_handle&& aOther) noexcept
+		{
+			std::swap(mAllocator,  aOther.mAllocator);
+			std::swap(mAllocation, aOther.mAllocation);
+			std::swap(mResource,   aOther.mResource);
+			return *this;
+		}
+
+		block_handle& operator=(const block_handle& aOther) = delete;
+
+		/** Destroy the resource and free its range of the block
+		 *	This is only implemented for certain types via template specialization: vk::Buffer, vk::Image
+		 *	That also means that this type is only usable with certain resource types.
+		 */
+		~block_handle();
+
+		/** Get the allocator that was used to allocate this resource */
+		auto allocator() const
+		{
+			return mAllocator;
+		}
+
+		/** Get the range of the block which this resource is bound to. */
+		const block_allocation& allocation() const
+		{
+			return mAllocation;
+		}
+
+		/** Get the resource handle. */
+		T resource() const
+		{
+			return mResource;
+		}
+
+		/** Get the memory properties from the allocation */
+		vk::MemoryPropertyFlags memory_properties() const
+		{
+			return mAllocation.mMemoryPropertyFlags;
+		}
+
+		/**	Get a pointer to the memory in order to write data into, or read data from it. Host visible blocks are mapped
+		 *	persistently, i.e., this does not map anything. If data shall be read from it and the memory is not host coherent,
+		 *	an invalidate-instruction will be issued for aRange.
+		 *
+		 *	Hint: Consider using avk::scoped_mapping instead of calling this method directly.
+		 *
+		 *	@param	aAccess		Specify your intent: Are you going to read from the memory, or write into it, or both?
+		 *	@param	aRange		The range which is going to be read from.
+		 *	@return	Pointer to the mapped memory.
+		 */
+		void* map_memory(mapping_access aAccess, mapped_range aRange = {}) const
+		{
+			const auto memProps = memory_properties();
+			assert(has_flag(memProps, vk::MemoryPropertyFlagBits::eHostVisible)); // => Allocation ended up in mappable memory. You can map it and access it directly.
+
+			if (has_flag(aAccess, mapping_access::read) && !has_flag(memProps, vk::MemoryPropertyFlagBits::eHostCoherent)) {
+				invalidate({ aRange });
+			}
+
+			return mAllocation.mMappedMemory;
+		}
+
+		/**	Counterpart to block_handle::map_memory. The memory stays mapped.
+		 *	If data shall be written to it and the memory is not host coherent, a flush-instruction will be issued for aWrittenRanges.
+		 *
+		 *	Hint: Consider using avk::scoped_mapping instead of calling this method directly.
+		 *
+		 *	@param	aAccess			Specify your intent: Are you going to read from the memory, or write into it, or both?
+		 *	@param	aWrittenRanges	The ranges which have been written to.
+		 */
+		void unmap_memory(mapping_access aAccess, const std::vector<mapped_range>& aWrittenRanges = { mapped_range{} }) const
+		{
+			const auto memProps = memory_properties();
+			assert(has_flag(memProps, vk::MemoryPropertyFlagBits::eHostVisible)); // => Allocation ended up in mappable memory. You can map it and access it directly.
+
+			if (has_flag(aAccess, mapping_access::write) && !has_flag(memProps, vk::MemoryPropertyFlagBits::eHostCoherent)) {
+				flush(aWrittenRanges);
+			}
+		}
+
+		/**	Make host writes to the given ranges available to the device with one vkFlushMappedMemoryRanges call.
+		 *	The ranges are rounded to multiples of nonCoherentAtomSize. Only required for memory which is not host coherent.
+		 */
+		void flush(const std::vector<mapped_range>& aRanges) const
+		{
+			const auto ranges = to_mapped_memory_ranges(mAllocation.mMemory, mAllocation.mOffset, mAllocation.mSize, mAllocator->non_coherent_atom_size(), aRanges);
+			if (!ranges.empty()) {
+				auto result = mAllocator->device().flushMappedMemoryRanges(static_cast<uint32_t>(ranges.size()), ranges.data());
+				assert(static_cast<VkResult>(result) >= 0);
+			}
+		}
+
+		/**	Make device writes to the given ranges visible to the host with one vkInvalidateMappedMemoryRanges call.
+		 *	The ranges are rounded to multiples of nonCoherentAtomSize. Only required for memory which is not host coherent.
+		 */
+		void invalidate(const std::vector<mapped_range>& aRanges) const
+		{
+			const auto ranges = to_mapped_memory_ranges(mAllocation.mMemory, mAllocation.mOffset, mAllocation.mSize, mAllocator->non_coherent_atom_size(), aRanges);
+			if (!ranges.empty()) {
+				auto result = mAllocator->device().invalidateMappedMemoryRanges(static_cast<uint32_t>(ranges.size()), ranges.data());
+				assert(static_cast<VkResult>(result) >= 0);
+			}
+		}
+
+		block_allocator* mAllocator;
+		block_allocation mAllocation;
+		T mResource;
+	};
+
+	// Fail if not used with either vk::Buffer or vk::Image
+	template <typename T>
+	template <typename C>
+	block_handle<T>::block_handle(block_allocator* aAllocator, vk::MemoryPropertyFlags aMemPropFlags, const C& aResourceCreateInfo)
+	{
+		throw avk::runtime_error(std::string("Memory allocation not implemented for type ") + typeid(T).name());
+	}
+
+	// Constructor's template specialization for vk::Buffer
+	template <>
+	template <>
+	inline block_handle<vk::Buffer>::block_handle(block_allocator* aAllocator, vk::MemoryPropertyFlags aMemPropFlags, const vk::BufferCreateInfo& aResourceCreateInfo)
+		: mAllocator{ aAllocator }
+	{
+		auto device = mAllocator->device();
+
+		auto vkBuffer = device.createBuffer(aResourceCreateInfo);
+		const auto memRequirements = device.getBufferMemoryRequirements(vkBuffer);
+
+		vk::MemoryAllocateFlags allocateFlags;
+#if VK_HEADER_VERSION >= 135
+		// Buffers with device addresses must be bound to memory which has been allocated with VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT
+		if (avk::has_flag(aResourceCreateInfo.usage, vk::BufferUsageFlagBits::eShaderDeviceAddress) || avk::has_flag(aResourceCreateInfo.usage, vk::BufferUsageFlagBits::eShaderDeviceAddressKHR) || avk::has_flag(aResourceCreateInfo.usage, vk::BufferUsageFlagBits::eShaderDeviceAddressEXT)) {
+			allocateFlags |= vk::MemoryAllocateFlagBits::eDeviceAddress;
+		}
+#endif
+
+		try {
+			mAllocation = mAllocator->allocate(memRequirements, aMemPropFlags, true, allocateFlags);
+		}
+		catch (...) {
+			device.destroyBuffer(vkBuffer);
+			throw;
+		}
+		device.bindBufferMemory(vkBuffer, mAllocation.mMemory, mAllocation.mOffset);
+
+		mResource = vkBuffer;
+	}
+
+	// Constructor's template specialization for vk::Image
+	template <>
+	template <>
+	inline block_handle<vk::Image>::block_handle(block_allocator* aAllocator, vk::MemoryPropertyFlags aMemPropFlags, const vk::ImageCreateInfo& aResourceCreateInfo)
+		: mAllocator{ aAllocator }
+	{
+		auto device = mAllocator->device();
+
+		auto vkImage = device.createImage(aResourceCreateInfo);
+		const auto memRequirements = device.getImageMemoryRequirements(vkImage);
+
+		try {
+			mAllocation = mAllocator->allocate(memRequirements, aMemPropFlags, vk::ImageTiling::eLinear == aResourceCreateInfo.tiling);
+		}
+		catch (...) {
+			device.destroyImage(vkImage);
+			throw;
+		}
+		device.bindImageMemory(vkImage, mAllocation.mMemory, mAllocation.mOffset);
+
+		mResource = vkImage;
+	}
+
+	// Fail if not used with either vk::Buffer or vk::Image
+	template <typename T>
+	block_handle<T>::~block_handle()
+	{
+		throw avk::runtime_error(std::string("Memory allocation not implemented for type ") + typeid(T).name());
+	}
+
+	// Destructor's template specialization for vk::Buffer
+	template <>
+	inline block_handle<vk::Buffer>::~block_handle()
+	{
+		if (static_cast<bool>(mResource)) {
+			mAllocator->device().destroyBuffer(mResource);
+			mResource = nullptr;
+			mAllocator->free(mAllocation);
+			mAllocation = {};
+			mAllocator = nullptr;
+		}
+	}
+
+	// Destructor's template specialization for vk::Image
+	template <>
+	inline block_handle<vk::Image>::~block_handle()
+	{
+		if (static_cast<bool>(mResource)) {
+			mAllocator->device().destroyImage(mResource);
+			mResource = nullptr;
+			mAllocator->free(mAllocation);
+			mAllocation = {};
+			mAllocator = nullptr;
+		}
+	}
+}
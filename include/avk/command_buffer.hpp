@@ -11,6 +11,7 @@ namespace avk
 	//class command_buffer_t;
 	class command_pool_t;
 	class compute_pipeline_t;
+	class event_t;
 	class fence_t;
 	class framebuffer_t;
 	class graphics_pipeline_t;
@@ -38,6 +39,7 @@ namespace avk
 	//using command_buffer = avk::owning_resource<command_buffer_t>;
 	using command_pool = avk::owning_resource<command_pool_t>;
 	using compute_pipeline = avk::owning_resource<compute_pipeline_t>;
+	using event = avk::owning_resource<event_t>;
 	using fence = avk::owning_resource<fence_t>;
 	using framebuffer = avk::owning_resource<framebuffer_t>;
 	using graphics_pipeline = avk::owning_resource<graphics_pipeline_t>;
@@ -69,6 +71,7 @@ namespace avk
 		command_buffer,
 		command_pool,
 		compute_pipeline,
+		event,
 		fence,
 		framebuffer,
 		graphics_pipeline,
@@ -121,6 +124,7 @@ namespace avk
 		friend class root;
 		friend class queue;
 		friend class command_pool_t;
+		friend class command_buffer_recycler;
 		
 	public:
 		command_buffer_t() = default;
@@ -156,6 +160,11 @@ namespace avk
 		// TODO: comment
 		command_buffer_t& handle_lifetime_of(any_owning_resource_t aResource);
 
+		/** Keep the given object alive until this command buffer is reused or destroyed, e.g., a lease on memory which the GPU reads from.
+		 *	In contrast to set_custom_deleter, no functions are nested, i.e., this can be called arbitrarily often between two reuses.
+		 */
+		command_buffer_t& keep_alive_until_reuse(std::shared_ptr<void> aObject);
+
 		/** Set a post execution handler function.
 		 *	This is (among possible other use cases) used for keeping the C++-side of things in sync with the GPU-side,
 		 *	e.g., to update image layout transitions after command buffers with renderpasses have been submitted.
@@ -183,6 +192,9 @@ namespace avk
 		void invoke_post_execution_handler() const;
 
 		void begin_recording();
+		/**	Begins recording a secondary command buffer, which inherits the given information from the primary command buffer.
+		 */
+		void begin_recording(const vk::CommandBufferInheritanceInfo& aInheritanceInfo);
 		void end_recording();
 
 		/**	Record a given state-type command directly into the given command buffer.
@@ -246,6 +258,9 @@ namespace avk
 		std::optional<avk::unique_function<void()>> mCustomDeleter;
 		
 		std::vector<any_owning_resource_t> mLifetimeHandledResources;
+
+		/** Objects which are kept alive until this command buffer is reused or destroyed (see keep_alive_until_reuse) */
+		std::vector<std::shared_ptr<void>> mKeptAliveObjects;
 	};
 
 	// Typedef for a variable representing an owner of a command_buffer
@@ -0,0 +1,92 @@
+#pragma once
+#include "avk/avk.hpp"
+
+namespace avk
+{
+	/**	Hands out command buffers which are recycled instead of being allocated anew every frame.
+	 *
+	 *	There is one command pool per (thread, queue family, frame slot), which is created lazily when a thread requests
+	 *	a command buffer for a given queue family and frame slot for the first time. Command buffers which have been handed
+	 *	out for a frame slot stay valid until that frame slot is recycled, which resets all of its command pools with one
+	 *	vkResetCommandPool each (instead of resetting command buffers individually) and makes all of its command buffers
+	 *	available again:
+	 *
+	 *	avk::command_buffer_recycler recycler{ &root, numFramesInFlight };
+	 *	// Every frame:
+	 *	recycler.recycle(frameSlot); // waits for the completion signal of the frame slot's previous use
+	 *	auto& cmdBfr = recycler.get_command_buffer(queue.family_index(), frameSlot);  // on any thread
+	 *	...
+	 *	auto token = submissionService.enqueue(...);
+	 *	recycler.set_completion_signal(frameSlot, submissionService.timeline_semaphore(), token.mTimelineValue);
+	 *
+	 *	get_command_buffer can be used concurrently from multiple threads. A frame slot must not be recycled while
+	 *	command buffers are being requested for it.
+	 */
+	class command_buffer_recycler
+	{
+	public:
+		/**	@param	aRoot			The root which command pools are created through.
+		 *	@param	aNumFrameSlots	Number of frame slots, e.g., the number of frames in flight.
+		 */
+		command_buffer_recycler(root* aRoot, uint32_t aNumFrameSlots);
+		command_buffer_recycler(const command_buffer_recycler&) = delete;
+		command_buffer_recycler(command_buffer_recycler&&) noexcept = delete;
+		command_buffer_recycler& operator=(const command_buffer_recycler&) = delete;
+		command_buffer_recycler& operator=(command_buffer_recycler&&) noexcept = delete;
+		~command_buffer_recycler() = default;
+
+		/**	Get a command buffer from the calling thread's command pool for the given queue family and frame slot.
+		 *	A recycled command buffer is returned if there is one, otherwise a new one is allocated.
+		 *	The command buffer stays valid and must not be reset individually until the frame slot is recycled.
+		 */
+		command_buffer_t& get_command_buffer(uint32_t aQueueFamilyIndex, uint32_t aFrameSlot, vk::CommandBufferUsageFlags aUsageFlags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit, vk::CommandBufferLevel aLevel = vk::CommandBufferLevel::ePrimary);
+
+		/**	Set the signal which indicates that the GPU has completed all command buffers of the given frame slot. */
+		void set_completion_signal(uint32_t aFrameSlot, const semaphore_t& aTimelineSemaphore, uint64_t aValue);
+		void set_completion_signal(uint32_t aFrameSlot, const fence_t& aFence);
+
+		/**	Recycle the given frame slot if its completion signal has fired (or if it has none), without blocking.
+		 *	@return	true if the frame slot has been recycled.
+		 */
+		bool try_recycle(uint32_t aFrameSlot);
+
+		/**	Wait until the completion signal of the given frame slot has fired (if it has one), and recycle the frame slot. */
+		void recycle(uint32_t aFrameSlot);
+
+		/**	Number of command buffers which have been allocated so far, across all pools. */
+		uint32_t num_allocated_command_buffers() const { return mNumAllocatedCommandBuffers.load(std::memory_order_relaxed); }
+
+		/**	Number of command buffers which have been handed out again after recycling. */
+		uint32_t num_recycled_command_buffers() const { return mNumRecycledCommandBuffers.load(std::memory_order_relaxed); }
+
+	private:
+		// The command pool of one (thread, queue family, frame slot), and all command buffers that have been allocated from it
+		struct pool_entry
+		{
+			command_pool mCommandPool;
+			std::vector<command_buffer> mPrimaryCommandBuffers;
+			std::vector<command_buffer> mSecondaryCommandBuffers;
+			size_t mNumPrimaryInUse = 0;
+			size_t mNumSecondaryInUse = 0;
+		};
+
+		using pool_key = std::tuple<uint32_t, uint32_t, std::thread::id>; // (frame slot, queue family, thread)
+
+		struct frame_slot_signal
+		{
+			const semaphore_t* mTimelineSemaphore = nullptr;
+			uint64_t mValue = 0;
+			const fence_t* mFence = nullptr;
+		};
+
+		// Resets all command pools of the given frame slot and makes their command buffers available again
+		void reset_frame_slot(uint32_t aFrameSlot);
+
+		root* mRoot;
+		std::mutex mMutex;
+		std::map<pool_key, pool_entry> mPools;
+		std::vector<frame_slot_signal> mSignals;
+		std::atomic<uint32_t> mNumAllocatedCommandBuffers{ 0 };
+		std::atomic<uint32_t> mNumRecycledCommandBuffers{ 0 };
+	};
+}
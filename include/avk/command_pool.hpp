@@ -35,6 +35,11 @@ namespace avk
 			
 		command_buffer alloc_command_buffer(vk::CommandBufferUsageFlags aUsageFlags = {}, vk::CommandBufferLevel aLevel = vk::CommandBufferLevel::ePrimary);
 
+		/**	Reset the whole command pool with vkResetCommandPool, which returns all command buffers allocated from it to the initial state.
+		 *	None of its command buffers must be pending execution. This does not invoke prepare_for_reuse on the command buffers.
+		 */
+		void reset(vk::CommandPoolResetFlags aFlags = {});
+
 		[[nodiscard]] const auto* root_ptr() const { return mRoot; }
 
 	private:
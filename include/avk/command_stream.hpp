@@ -0,0 +1,312 @@
+#pragma once
+#include "avk/avk.hpp"
+
+namespace avk
+{
+	/**	Operation codes of the commands stored in a command_stream
+	 */
+	enum struct command_stream_op : uint32_t
+	{
+		bind_pipeline,
+		bind_descriptor_sets,
+		push_constants,
+		bind_vertex_buffers,
+		bind_index_buffer,
+		draw,
+		draw_indexed,
+		dispatch,
+		copy_buffer,
+		pipeline_barrier,
+		callback
+	};
+
+	/**	A compact alternative to std::vector<recorded_commands_t>:
+	 *	All commands are stored in one contiguous byte buffer, each one consisting of a command_header,
+	 *	followed by a POD payload, followed by the payload's arrays (e.g., the descriptor sets to be bound,
+	 *	the data of push constants, or the barriers of a pipeline barrier). All parts are aligned to
+	 *	command_stream::alignment bytes.
+	 *
+	 *	Frequently used commands (binding pipelines, descriptor sets, vertex and index buffers, push
+	 *	constants, draw calls, dispatches, buffer copies, and pipeline barriers) can be appended directly
+	 *	to a command_stream. All other commands are stored as callbacks which are invoked during replay.
+	 *
+	 *	A list of recorded commands can be lowered into a command_stream via append_lowered (or via
+	 *	recorded_commands::into_command_stream). Thereby, all barriers are resolved (see
+	 *	sync::resource_state_tracker) and batched into as few pipeline_barrier commands as possible.
+	 *	Commands which have a compact description (see command::lowered_command, which is created on demand for
+	 *	the commands of the factory functions for binding pipelines and descriptors, push constants, draw calls,
+	 *	dispatches, and buffer copies) become the corresponding packed commands; all other commands become callbacks.
+	 *
+	 *	Call clear() in order to reuse the command_stream (and its allocated memory) for the next frame.
+	 */
+	class command_stream
+	{
+	public:
+		static constexpr size_t alignment = 8;
+
+		/** Precedes every command within the stream */
+		struct command_header
+		{
+			command_stream_op mOp;
+			/** Size of the payload in bytes, including its arrays and the padding, i.e., the next command_header follows at this offset after the current command_header. */
+			uint32_t mPayloadSize;
+		};
+
+		struct bind_pipeline_data
+		{
+			vk::PipelineBindPoint mBindPoint;
+			vk::Pipeline mPipeline;
+		};
+
+		/** Followed by vk::DescriptorSet[mDescriptorSetCount] and uint32_t[mDynamicOffsetCount] */
+		struct bind_descriptor_sets_data
+		{
+			vk::PipelineBindPoint mBindPoint;
+			vk::PipelineLayout mLayout;
+			uint32_t mFirstSet;
+			uint32_t mDescriptorSetCount;
+			uint32_t mDynamicOffsetCount;
+		};
+
+		/** Followed by mSize bytes of data */
+		struct push_constants_data
+		{
+			vk::PipelineLayout mLayout;
+			vk::ShaderStageFlags mStages;
+			uint32_t mOffset;
+			uint32_t mSize;
+		};
+
+		/** Followed by vk::Buffer[mBindingCount] and vk::DeviceSize[mBindingCount] */
+		struct bind_vertex_buffers_data
+		{
+			uint32_t mFirstBinding;
+			uint32_t mBindingCount;
+		};
+
+		struct bind_index_buffer_data
+		{
+			vk::Buffer mBuffer;
+			vk::DeviceSize mOffset;
+			vk::IndexType mIndexType;
+		};
+
+		struct draw_data
+		{
+			uint32_t mVertexCount;
+			uint32_t mInstanceCount;
+			uint32_t mFirstVertex;
+			uint32_t mFirstInstance;
+		};
+
+		struct draw_indexed_data
+		{
+			uint32_t mIndexCount;
+			uint32_t mInstanceCount;
+			uint32_t mFirstIndex;
+			int32_t  mVertexOffset;
+			uint32_t mFirstInstance;
+		};
+
+		struct dispatch_data
+		{
+			uint32_t mGroupCountX;
+			uint32_t mGroupCountY;
+			uint32_t mGroupCountZ;
+		};
+
+		/** Followed by vk::BufferCopy[mRegionCount] */
+		struct copy_buffer_data
+		{
+			vk::Buffer mSrcBuffer;
+			vk::Buffer mDstBuffer;
+			uint32_t mRegionCount;
+		};
+
+		/** Followed by vk::MemoryBarrier2KHR[mMemoryBarrierCount], vk::ImageMemoryBarrier2KHR[mImageMemoryBarrierCount], and vk::BufferMemoryBarrier2KHR[mBufferMemoryBarrierCount] */
+		struct pipeline_barrier_data
+		{
+			uint32_t mMemoryBarrierCount;
+			uint32_t mImageMemoryBarrierCount;
+			uint32_t mBufferMemoryBarrierCount;
+		};
+
+		/** Refers to an entry of the command_stream's callbacks */
+		struct callback_data
+		{
+			uint32_t mCallbackIndex;
+		};
+
+		using rec_fun = command::state_type_command::rec_fun;
+
+		command_stream() = default;
+		command_stream(command_stream&&) noexcept = default;
+		command_stream(const command_stream&) = default;
+		command_stream& operator=(command_stream&&) noexcept = default;
+		command_stream& operator=(const command_stream&) = default;
+		~command_stream() = default;
+
+		command_stream& bind_pipeline(vk::PipelineBindPoint aBindPoint, vk::Pipeline aPipeline)
+		{
+			append(command_stream_op::bind_pipeline, bind_pipeline_data{ aBindPoint, aPipeline });
+			return *this;
+		}
+
+		command_stream& bind_descriptor_sets(vk::PipelineBindPoint aBindPoint, vk::PipelineLayout aLayout, uint32_t aFirstSet, std::span<const vk::DescriptorSet> aDescriptorSets, std::span<const uint32_t> aDynamicOffsets = {})
+		{
+			append(command_stream_op::bind_descriptor_sets,
+				bind_descriptor_sets_data{ aBindPoint, aLayout, aFirstSet, static_cast<uint32_t>(aDescriptorSets.size()), static_cast<uint32_t>(aDynamicOffsets.size()) },
+				aDescriptorSets, aDynamicOffsets);
+			return *this;
+		}
+
+		command_stream& push_constants(vk::PipelineLayout aLayout, vk::ShaderStageFlags aStages, uint32_t aOffset, std::span<const std::byte> aData)
+		{
+			append(command_stream_op::push_constants, push_constants_data{ aLayout, aStages, aOffset, static_cast<uint32_t>(aData.size()) }, aData);
+			return *this;
+		}
+
+		template <typename D>
+		command_stream& push_constants(vk::PipelineLayout aLayout, vk::ShaderStageFlags aStages, const D& aData, uint32_t aOffset = 0)
+		{
+			static_assert(std::is_trivially_copyable_v<D>, "Push constants data must be trivially copyable.");
+			return push_constants(aLayout, aStages, aOffset, std::as_bytes(std::span<const D, 1>{ &aData, 1 }));
+		}
+
+		command_stream& bind_vertex_buffers(uint32_t aFirstBinding, std::span<const vk::Buffer> aBuffers, std::span<const vk::DeviceSize> aOffsets)
+		{
+			if (aBuffers.size() != aOffsets.size()) {
+				throw avk::logic_error("The number of vertex buffers (" + std::to_string(aBuffers.size()) + ") does not match the number of offsets (" + std::to_string(aOffsets.size()) + ").");
+			}
+			append(command_stream_op::bind_vertex_buffers, bind_vertex_buffers_data{ aFirstBinding, static_cast<uint32_t>(aBuffers.size()) }, aBuffers, aOffsets);
+			return *this;
+		}
+
+		command_stream& bind_index_buffer(vk::Buffer aBuffer, vk::DeviceSize aOffset, vk::IndexType aIndexType)
+		{
+			append(command_stream_op::bind_index_buffer, bind_index_buffer_data{ aBuffer, aOffset, aIndexType });
+			return *this;
+		}
+
+		command_stream& draw(uint32_t aVertexCount, uint32_t aInstanceCount, uint32_t aFirstVertex, uint32_t aFirstInstance)
+		{
+			append(command_stream_op::draw, draw_data{ aVertexCount, aInstanceCount, aFirstVertex, aFirstInstance });
+			return *this;
+		}
+
+		command_stream& draw_indexed(uint32_t aIndexCount, uint32_t aInstanceCount, uint32_t aFirstIndex, int32_t aVertexOffset, uint32_t aFirstInstance)
+		{
+			append(command_stream_op::draw_indexed, draw_indexed_data{ aIndexCount, aInstanceCount, aFirstIndex, aVertexOffset, aFirstInstance });
+			return *this;
+		}
+
+		command_stream& dispatch(uint32_t aGroupCountX, uint32_t aGroupCountY, uint32_t aGroupCountZ)
+		{
+			append(command_stream_op::dispatch, dispatch_data{ aGroupCountX, aGroupCountY, aGroupCountZ });
+			return *this;
+		}
+
+		command_stream& copy_buffer(vk::Buffer aSrcBuffer, vk::Buffer aDstBuffer, std::span<const vk::BufferCopy> aRegions)
+		{
+			append(command_stream_op::copy_buffer, copy_buffer_data{ aSrcBuffer, aDstBuffer, static_cast<uint32_t>(aRegions.size()) }, aRegions);
+			return *this;
+		}
+
+		command_stream& pipeline_barrier(std::span<const vk::MemoryBarrier2KHR> aMemoryBarriers, std::span<const vk::ImageMemoryBarrier2KHR> aImageMemoryBarriers, std::span<const vk::BufferMemoryBarrier2KHR> aBufferMemoryBarriers)
+		{
+			append(command_stream_op::pipeline_barrier,
+				pipeline_barrier_data{ static_cast<uint32_t>(aMemoryBarriers.size()), static_cast<uint32_t>(aImageMemoryBarriers.size()), static_cast<uint32_t>(aBufferMemoryBarriers.size()) },
+				aMemoryBarriers, aImageMemoryBarriers, aBufferMemoryBarriers);
+			return *this;
+		}
+
+		/**	Appends an opaque command which is recorded by invoking the given function during replay.
+		 */
+		command_stream& callback(rec_fun aFun)
+		{
+			append(command_stream_op::callback, callback_data{ static_cast<uint32_t>(mCallbacks.size()) });
+			mCallbacks.push_back(std::move(aFun));
+			return *this;
+		}
+
+		/**	Lowers the given list of recorded commands into this command_stream.
+		 *	All their barriers are resolved and batched into pipeline_barrier commands. Commands with a compact
+		 *	description become packed commands. The remaining state_type_commands, and the begin and end functions
+		 *	of the remaining action_type_commands become callbacks.
+		 */
+		command_stream& append_lowered(const std::vector<recorded_commands_t>& aRecordedCommandsAndSyncInstructions);
+
+		/**	Takes care of the lifetime of the given resource.
+		 *	It will be deleted when this command_stream is cleared or goes out of scope.
+		 */
+		command_stream& handle_lifetime_of(any_owning_resource_t aResource)
+		{
+			mLifetimeHandledResources.push_back(std::move(aResource));
+			return *this;
+		}
+
+		/**	Records all commands of this command_stream into the given command buffer.
+		 *	The command buffer must be in recording state.
+		 */
+		void record_into(command_buffer_t& aCommandBuffer) const;
+
+		/**	Removes all commands, callbacks, and lifetime-handled resources, but keeps the allocated memory for reuse.
+		 */
+		void clear()
+		{
+			mData.clear();
+			mCallbacks.clear();
+			mLifetimeHandledResources.clear();
+			mNumCommands = 0u;
+		}
+
+		[[nodiscard]] bool empty() const { return 0u == mNumCommands; }
+		[[nodiscard]] uint32_t num_commands() const { return mNumCommands; }
+		[[nodiscard]] size_t size_in_bytes() const { return mData.size(); }
+		[[nodiscard]] const std::byte* data() const { return mData.data(); }
+
+	private:
+		static constexpr size_t aligned_size(size_t aSize)
+		{
+			return (aSize + alignment - 1) & ~(alignment - 1);
+		}
+
+		template <typename T>
+		static constexpr size_t array_size(std::span<const T> aArray)
+		{
+			return aligned_size(aArray.size_bytes());
+		}
+
+		// Appends the packed command(s) which correspond to the given compact description of a command:
+		void append_lowered_command(const command::lowered_command& aLoweredCommand);
+
+		// Appends the header, the payload, and all the payload's arrays to mData:
+		template <typename P, typename... T>
+		void append(command_stream_op aOp, const P& aPayload, std::span<const T>... aArrays)
+		{
+			static_assert(std::is_trivially_copyable_v<P> && (std::is_trivially_copyable_v<T> && ...), "Only trivially copyable data can be stored in a command_stream.");
+			static_assert(alignof(P) <= alignment && ((alignof(T) <= alignment) && ...), "Data in a command_stream must not be over-aligned.");
+			const size_t payloadSize = aligned_size(sizeof(P)) + (static_cast<size_t>(0) + ... + array_size(aArrays));
+			const auto header = command_header{ aOp, static_cast<uint32_t>(payloadSize) };
+
+			size_t offset = mData.size();
+			mData.resize(offset + aligned_size(sizeof(command_header)) + payloadSize);
+			std::memcpy(mData.data() + offset, &header, sizeof(command_header));
+			offset += aligned_size(sizeof(command_header));
+			std::memcpy(mData.data() + offset, &aPayload, sizeof(P));
+			offset += aligned_size(sizeof(P));
+			([&] {
+				if (!aArrays.empty()) {
+					std::memcpy(mData.data() + offset, aArrays.data(), aArrays.size_bytes());
+				}
+				offset += array_size(aArrays);
+			}(), ...);
+			++mNumCommands;
+		}
+
+		std::vector<std::byte> mData;
+		std::vector<rec_fun> mCallbacks;
+		std::vector<any_owning_resource_t> mLifetimeHandledResources;
+		uint32_t mNumCommands = 0u;
+	};
+}
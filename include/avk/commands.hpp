@@ -6,6 +6,7 @@
 
 namespace avk
 {
+	class command_pool_t;
 	class framebuffer_t;
 	class graphics_pipeline_t;
 	class semaphore_t;
@@ -28,10 +29,18 @@ namespace avk
 			 */
 			std::optional<stage_and_access_precisely> mSrcForSubsequentCmds = {};
 
-			// TODO: I think it would be pretty hard to incorporate the following two in a meaningful manner:
-			//       (If possible, we'd need to track their respective vk::Image and vk::Buffer handles.)
-			//std::optional<vk::ImageSubresourceRange> mImageSubresourceRangeAffected;
-			//std::optional<std::tuple<vk::DeviceSize, vk::DeviceSize>> mBufferOffsetSizeAffected;
+			/**	Only relevant for resource-specific sync hints of images:
+			 *	Which subresources does the associated command use? If not set, the whole image is assumed to be used.
+			 *	Barriers for the image only synchronize with the command if their subresource ranges overlap.
+			 */
+			std::optional<vk::ImageSubresourceRange> mImageSubresourceRangeAffected = {};
+
+			/**	Only relevant for resource-specific sync hints of buffers:
+			 *	Which bytes (offset and size, size may be VK_WHOLE_SIZE) does the associated command use? 
+			 *	If not set, the whole buffer is assumed to be used.
+			 *	Barriers for the buffer only synchronize with the command if their ranges overlap.
+			 */
+			std::optional<std::tuple<vk::DeviceSize, vk::DeviceSize>> mBufferOffsetSizeAffected = {};
 		};
 
 		struct queue_family_info
@@ -54,29 +63,53 @@ namespace avk
 			std::optional<avk::layout::image_layout_transition> mLayoutTransition;
 		};
 
+		/**	Which half of a split barrier a sync_type_command represents. */
+		enum struct split_barrier_half
+		{
+			/** Recorded via vkCmdSetEvent2 right after the producing commands */
+			signal,
+			/** Recorded via vkCmdWaitEvents2 (followed by vkCmdResetEvent2) right before the consuming commands */
+			wait
+		};
+
+		struct event_sync_info
+		{
+			vk::Event mEvent;
+			split_barrier_half mHalf;
+		};
+
 		class sync_type_command final
 		{
 		public:
 			// Constructs a global execution barrier:
 			sync_type_command(avk::stage::execution_dependency aStages)
-				: mStages{ aStages }, mAccesses{}, mQueueFamilyOwnershipTransfer{}, mSpecificData{} {}
+				: mStages{ aStages }, mAccesses{}, mQueueFamilyOwnershipTransfer{}, mSpecificData{}, mSplitBarrierEvent{} {}
 
 			// Constructs a global memory barrier:
 			sync_type_command(avk::stage::execution_dependency aStages, avk::access::memory_dependency aAccesses)
-				: mStages{ aStages }, mAccesses{ aAccesses }, mQueueFamilyOwnershipTransfer{}, mSpecificData{} {}
+				: mStages{ aStages }, mAccesses{ aAccesses }, mQueueFamilyOwnershipTransfer{}, mSpecificData{}, mSplitBarrierEvent{} {}
 
 			// Constructs an image memory barrier:
 			sync_type_command(avk::stage::execution_dependency aStages, avk::access::memory_dependency aAccesses, const avk::image_t& aImage, vk::ImageSubresourceRange aSubresourceRange)
 				: mStages{ aStages }, mAccesses{ aAccesses }, mQueueFamilyOwnershipTransfer{}
 				, mSpecificData{ image_sync_info{ aImage.handle(), aSubresourceRange, std::optional<avk::layout::image_layout_transition>{} } } 
+				, mSplitBarrierEvent{}
 			{}
 
 			// Constructs a buffer memory barrier:
 			sync_type_command(avk::stage::execution_dependency aStages, avk::access::memory_dependency aAccesses, const avk::buffer_t& aBuffer, vk::DeviceSize aOffset, vk::DeviceSize aSize)
 				: mStages{ aStages }, mAccesses{ aAccesses }, mQueueFamilyOwnershipTransfer{}
 				, mSpecificData{ buffer_sync_info{ aBuffer.handle(), aOffset, aSize } } 
+				, mSplitBarrierEvent{}
 			{}
 
+			// Replaces the stages of this sync_type_command:
+			sync_type_command& with_stages(avk::stage::execution_dependency aStages)
+			{
+				mStages = aStages;
+				return *this;
+			}
+
 			// Adds memory access, potentially turning a execution barrier into a memory barrier.
 			sync_type_command& with_memory_access(avk::access::memory_dependency aMemoryAccess)
 			{
@@ -125,6 +158,13 @@ namespace avk
 				return *this;
 			}
 
+			// Turns this sync_type_command into one half of a split barrier which is established through the given event:
+			sync_type_command& as_split_barrier_half(vk::Event aEvent, split_barrier_half aHalf)
+			{
+				mSplitBarrierEvent = event_sync_info{ aEvent, aHalf };
+				return *this;
+			}
+
 			[[nodiscard]] bool is_global_execution_barrier() const {
 				return !mAccesses.has_value() && !mQueueFamilyOwnershipTransfer.has_value() && std::holds_alternative<std::monostate>(mSpecificData);
 			}
@@ -141,6 +181,10 @@ namespace avk
 				return std::holds_alternative<buffer_sync_info>(mSpecificData);
 			}
 
+			[[nodiscard]] bool is_split_barrier_half() const {
+				return mSplitBarrierEvent.has_value();
+			}
+
 			[[nodiscard]] bool is_ill_formed() const {
 				return !(is_global_execution_barrier() || is_global_memory_barrier() || is_image_memory_barrier() || is_buffer_memory_barrier());
 			}
@@ -162,11 +206,16 @@ namespace avk
 				assert(is_image_memory_barrier());
 				return std::get<image_sync_info>(mSpecificData);
 			}
+			[[nodiscard]] auto split_barrier_event_data() const {
+				assert(is_split_barrier_half());
+				return mSplitBarrierEvent.value();
+			}
 		private:
 			avk::stage::execution_dependency mStages;
 			std::optional<avk::access::memory_dependency> mAccesses;
 			std::optional<queue_family_info> mQueueFamilyOwnershipTransfer;
 			std::variant<std::monostate, buffer_sync_info, image_sync_info> mSpecificData;
+			std::optional<event_sync_info> mSplitBarrierEvent;
 		};
 
 		/**	Create a global execution barrier which only has execution dependencies, but no memory dependencies (i.e., both access scopes set to eNone).
@@ -289,6 +338,56 @@ namespace avk
 		{
 			return buffer_memory_barrier(aBuffer, aDependency.mSrc.mStage >> aDependency.mDst.mStage, aDependency.mSrc.mAccess >> aDependency.mDst.mAccess);
 		}
+
+		/**	Turn a barrier into the signal half of a split barrier, which is recorded via vkCmdSetEvent2.
+		 *	Place it right after the commands which produce the data, and place the matching wait half (see wait_split_barrier),
+		 *	which must be created from the same barrier and the same event, right before the commands which consume the data.
+		 *	Commands in between the two halves can execute while the dependency is being resolved, which is not the case for
+		 *	a pipeline barrier at the position of the wait half.
+		 *
+		 *	auto_stage/auto_access parts are resolved like for pipeline barriers: The source scopes w.r.t. the commands before
+		 *	the signal half, and the destination scopes w.r.t. the commands after the wait half.
+		 *	Events must not be set within a render pass instance, and both halves must be submitted to the same queue.
+		 *	The event is reset after the wait half, i.e., the same event can be used again in subsequent submissions.
+		 *
+		 *	Example:    sync::signal_split_barrier(myEvent, sync::buffer_memory_barrier(myBuffer, stage::auto_stage >> stage::auto_stage, access::auto_access >> access::auto_access))
+		 *
+		 *	@param	aEvent		The event which connects the signal half with the wait half.
+		 *	@param	aBarrier	The barrier to be split up.
+		 *	@return	An avk::sync::sync_type_command instance which represents the signal half of the split barrier
+		 */
+		inline static sync_type_command signal_split_barrier(const avk::event_t& aEvent, sync_type_command aBarrier)
+		{
+			return aBarrier.as_split_barrier_half(aEvent.handle(), split_barrier_half::signal);
+		}
+
+		/**	Turn a barrier into the wait half of a split barrier, which is recorded via vkCmdWaitEvents2, followed by vkCmdResetEvent2.
+		 *	See signal_split_barrier for details.
+		 *	@param	aEvent		The event which connects the signal half with the wait half.
+		 *	@param	aBarrier	The barrier to be split up. Must be the same as the one passed to signal_split_barrier.
+		 *	@return	An avk::sync::sync_type_command instance which represents the wait half of the split barrier
+		 */
+		inline static sync_type_command wait_split_barrier(const avk::event_t& aEvent, sync_type_command aBarrier)
+		{
+			return aBarrier.as_split_barrier_half(aEvent.handle(), split_barrier_half::wait);
+		}
+	}
+
+	namespace sync
+	{
+		/**	Counts the barriers which have been removed by recorded_commands::eliminate_redundant_barriers.
+		 */
+		struct barrier_elimination_statistics
+		{
+			/** Barriers with an empty source or destination scope, and neither a layout transition nor a queue family ownership transfer */
+			uint32_t mNumNoOpBarriersRemoved = 0u;
+			/** Barriers which have been fully covered by an earlier barrier with no action_type_command in between */
+			uint32_t mNumCoveredBarriersRemoved = 0u;
+			/** Barriers which have been merged into an earlier barrier with no action_type_command in between, by widening the latter */
+			uint32_t mNumMergedBarriersRemoved = 0u;
+
+			[[nodiscard]] uint32_t num_barriers_removed() const { return mNumNoOpBarriersRemoved + mNumCoveredBarriersRemoved + mNumMergedBarriersRemoved; }
+		};
 	}
 
 	// Define recorded* type:
@@ -296,6 +395,101 @@ namespace avk
 	
 	namespace command
 	{
+		/**	Compact descriptions of the commands which are created by frequently used factory functions, s.t.
+		 *	command_stream::append_lowered can store them as packed operations instead of as callbacks (which
+		 *	would have to copy the whole recording function). They describe exactly what the recording function does.
+		 */
+		namespace lowered
+		{
+			struct bind_pipeline
+			{
+				vk::PipelineBindPoint mBindPoint;
+				vk::Pipeline mPipeline;
+			};
+
+			/** Descriptor sets and their set ids; consecutively numbered sets are bound at once */
+			struct bind_descriptors
+			{
+				vk::PipelineBindPoint mBindPoint;
+				vk::PipelineLayout mLayout;
+				std::vector<std::tuple<uint32_t, vk::DescriptorSet>> mSets;
+			};
+
+			struct push_constants
+			{
+				vk::PipelineLayout mLayout;
+				vk::ShaderStageFlags mStages;
+				uint32_t mOffset;
+				std::vector<std::byte> mData;
+			};
+
+			/** The vertex buffers (if any) are bound starting at binding 0 before drawing */
+			struct draw
+			{
+				std::vector<vk::Buffer> mVertexBuffers;
+				std::vector<vk::DeviceSize> mVertexBufferOffsets;
+				uint32_t mVertexCount;
+				uint32_t mInstanceCount;
+				uint32_t mFirstVertex;
+				uint32_t mFirstInstance;
+			};
+
+			/** The vertex buffers are bound starting at binding 0, and the index buffer is bound at offset 0 before drawing */
+			struct draw_indexed
+			{
+				std::vector<vk::Buffer> mVertexBuffers;
+				std::vector<vk::DeviceSize> mVertexBufferOffsets;
+				vk::Buffer mIndexBuffer;
+				vk::IndexType mIndexType;
+				uint32_t mIndexCount;
+				uint32_t mInstanceCount;
+				uint32_t mFirstIndex;
+				int32_t mVertexOffset;
+				uint32_t mFirstInstance;
+			};
+
+			struct dispatch
+			{
+				uint32_t mGroupCountX;
+				uint32_t mGroupCountY;
+				uint32_t mGroupCountZ;
+			};
+
+			struct copy_buffer
+			{
+				vk::Buffer mSrcBuffer;
+				vk::Buffer mDstBuffer;
+				vk::BufferCopy mRegion;
+			};
+		}
+
+		/** Empty for commands which do not have a compact description */
+		using lowered_command = std::variant<std::monostate, lowered::bind_pipeline, lowered::bind_descriptors, lowered::push_constants, lowered::draw, lowered::draw_indexed, lowered::dispatch, lowered::copy_buffer>;
+
+		/**	Creates the compact description of what a recording function records. The description is only created on demand
+		 *	(e.g., by command_stream::append_lowered), s.t. creating a command does not allocate any memory for it.
+		 */
+		using lower_fun = lowered_command(*)(const avk::inline_function<void(avk::command_buffer_t&), AVK_COMMAND_FUNCTION_INLINE_CAPACITY>&);
+
+		/**	True for the parameter type with which a lowerable recording function is invoked in order to write its
+		 *	compact description instead of recording into a command buffer (see lower_recording_function).
+		 */
+		template <typename T>
+		inline constexpr bool is_lowering_target_v = std::is_same_v<std::decay_t<T>, lowered_command>;
+
+		/**	A lower_fun for recording functions of type Fn, which must be callable with an avk::command_buffer_t& (in order to
+		 *	record) and with a lowered_command& (in order to write the compact description of what they record).
+		 */
+		template <typename Fn>
+		lowered_command lower_recording_function(const avk::inline_function<void(avk::command_buffer_t&), AVK_COMMAND_FUNCTION_INLINE_CAPACITY>& aFun)
+		{
+			lowered_command result;
+			const auto* fn = aFun.template target<Fn>();
+			assert(nullptr != fn);
+			(*fn)(result);
+			return result;
+		}
+
 		struct state_type_command final
 		{
 			//state_type_command(const state_type_command&) = delete;
@@ -304,9 +498,18 @@ namespace avk
 			//state_type_command& operator=(state_type_command&&) noexcept = default;
 			//~state_type_command() = default;
 
-			using rec_fun = std::function<void(avk::command_buffer_t&)>;
+			using rec_fun = avk::inline_function<void(avk::command_buffer_t&), AVK_COMMAND_FUNCTION_INLINE_CAPACITY>;
 
 			rec_fun mFun;
+
+			/** Creates the compact description of what mFun records, if it has been created by one of the frequently used factory functions */
+			lower_fun mLower = nullptr;
+
+			/** The compact description of what mFun records, or std::monostate if there is none */
+			lowered_command lowered() const
+			{
+				return nullptr != mLower ? mLower(mFun) : lowered_command{};
+			}
 		};
 
 		template <typename PL, typename D>
@@ -331,22 +534,31 @@ namespace avk
 				}
 			}
 
-			return state_type_command{
-				[
+			auto fun = [
 					lLayoutHandle = std::get<const vk::PipelineLayout>(aPipelineLayoutTuple),
 					lStageFlags = stageFlags.value_or(vk::ShaderStageFlagBits::eAll),
 					lDataSize = dataSize,
 					aData
-				] (avk::command_buffer_t& cb) {
-					cb.handle().pushConstants(
-						lLayoutHandle,
-						lStageFlags,
-						0, // TODO: How to deal with offset?
-						lDataSize,
-						&aData
-					);
-				}
-			};
+				] (auto& aTarget) {
+					if constexpr (is_lowering_target_v<decltype(aTarget)>) {
+						const auto* dataBytes = reinterpret_cast<const std::byte*>(&aData);
+						aTarget = lowered::push_constants{ lLayoutHandle, lStageFlags, 0u, std::vector<std::byte>(dataBytes, dataBytes + lDataSize) };
+					}
+					else {
+						aTarget.handle().pushConstants(
+							lLayoutHandle,
+							lStageFlags,
+							0, // TODO: How to deal with offset?
+							lDataSize,
+							&aData
+						);
+					}
+				};
+			auto result = state_type_command{ fun };
+			if constexpr (std::is_trivially_copyable_v<D>) {
+				result.mLower = &lower_recording_function<decltype(fun)>;
+			}
+			return result;
 		};
 
 		template <typename PL, typename D>
@@ -388,6 +600,29 @@ namespace avk
 			};
 		};
 
+		/**	Describes how an action_type_command relates to render passes.
+		 *	This matters when recording in parallel (see recorded_commands::into_command_buffer_in_parallel),
+		 *	because render passes can only be begun, advanced, and ended in primary command buffers.
+		 */
+		struct render_pass_boundary
+		{
+			enum struct kind
+			{
+				none,
+				begin,
+				next_subpass,
+				end,
+				whole
+			};
+
+			kind mKind = kind::none;
+			/** For kind::begin and kind::next_subpass: Whether the contents of the (next) subpass are provided via secondary command buffers */
+			bool mSubpassContentsInSecondaryCommandBuffers = false;
+			/** For kind::begin: The render pass and framebuffer which secondary command buffers must be recorded for */
+			vk::RenderPass mRenderPass = {};
+			vk::Framebuffer mFramebuffer = {};
+		};
+
 		struct action_type_command final
 		{
 			//action_type_command(const action_type_command&) = delete;
@@ -396,7 +631,7 @@ namespace avk
 			//action_type_command& operator=(action_type_command&&) noexcept = default;
 			//~action_type_command() = default;
 
-			using rec_fun = std::function<void(avk::command_buffer_t&)>;
+			using rec_fun = avk::inline_function<void(avk::command_buffer_t&), AVK_COMMAND_FUNCTION_INLINE_CAPACITY>;
 
 			avk::sync::sync_hint mSyncHint = {};
 			std::vector<std::tuple<std::variant<vk::Image, vk::Buffer>, avk::sync::sync_hint>> mResourceSpecificSyncHints;
@@ -486,6 +721,18 @@ namespace avk
 			}
 
 			std::vector<any_owning_resource_t> mLifetimeHandledResources;
+
+			/**	Set for commands which begin a render pass, advance to its next subpass, end it, or contain a whole render pass. */
+			render_pass_boundary mRenderPassBoundary = {};
+
+			/** Creates the compact description of what mBeginFun records, if it has been created by one of the frequently used factory functions */
+			lower_fun mLower = nullptr;
+
+			/** The compact description of what mBeginFun records, or std::monostate if there is none */
+			lowered_command lowered() const
+			{
+				return nullptr != mLower ? mLower(mBeginFun) : lowered_command{};
+			}
 		};
 
 		/**	A utility function that creates an action_type_command which consists solely of custom commmands.
@@ -579,6 +826,17 @@ namespace avk
 
 		extern action_type_command draw(uint32_t aVertexCount, uint32_t aInstanceCount, uint32_t aFirstVertex, uint32_t aFirstInstance);
 
+		/**	Perform an indirect draw call with the draw parameters read from a buffer, without binding any vertex buffers (like draw).
+		 *	The parameters are read when the command is executed, not when it is recorded. Hence, they can be changed
+		 *	between submissions of a command buffer which has been recorded only once (see baked_parameters_t).
+		 *	@param	aParametersBuffer	Buffer which contains aNumberOfDraws vk::DrawIndirectCommand structures
+		 *	@param	aNumberOfDraws		Number of draws to execute
+		 *	@param	aParametersOffset	Byte offset into aParametersBuffer where the first vk::DrawIndirectCommand structure begins
+		 *	@param	aParametersStride	Byte stride between successive vk::DrawIndirectCommand structures in aParametersBuffer
+		 *	@return An action_type_command instance which you must submit to a queue.
+		 */
+		extern action_type_command draw_indirect(const buffer_t& aParametersBuffer, uint32_t aNumberOfDraws = 1, vk::DeviceSize aParametersOffset = 0, uint32_t aParametersStride = static_cast<uint32_t>(sizeof(vk::DrawIndirectCommand)));
+
 		template <typename... Rest>
 		void bind_vertex_buffer(vk::Buffer* aHandlePtr, vk::DeviceSize* aOffsetPtr)
 		{
@@ -622,7 +880,27 @@ namespace avk
 			std::array<vk::DeviceSize, N> offsets;
 			bind_vertex_buffer(&handles[0], &offsets[0], aVertexBuffer, aFurtherBuffers...);
 
-			return action_type_command{
+			auto fun = [
+					handles, offsets,
+					aNumberOfVertices, aNumberOfInstances, aFirstVertex, aFirstInstance
+				](auto& aTarget) {
+					if constexpr (is_lowering_target_v<decltype(aTarget)>) {
+						aTarget = lowered::draw{
+							std::vector<vk::Buffer>(std::begin(handles), std::end(handles)),
+							std::vector<vk::DeviceSize>(std::begin(offsets), std::end(offsets)),
+							aNumberOfVertices, aNumberOfInstances, aFirstVertex, aFirstInstance
+						};
+					}
+					else {
+						aTarget.handle().bindVertexBuffers(
+							0u, // TODO: Should the first binding really always be 0?
+							static_cast<uint32_t>(N), handles.data(), offsets.data()
+						);
+						aTarget.handle().draw(aNumberOfVertices, aNumberOfInstances, aFirstVertex, aFirstInstance);
+					}
+				};
+
+			auto result = action_type_command{
 				avk::sync::sync_hint {
 					{{ // DESTINATION dependencies for previous commands:
 						vk::PipelineStageFlagBits2KHR::eAllGraphics,
@@ -634,18 +912,10 @@ namespace avk
 					}}
 				},
 				{}, // no resource-specific sync hints
-				[
-					lBindingCount = static_cast<uint32_t>(N),
-					handles, offsets, 
-					aNumberOfVertices, aNumberOfInstances, aFirstVertex, aFirstInstance
-				](avk::command_buffer_t& cb) {
-					cb.handle().bindVertexBuffers(
-						0u, // TODO: Should the first binding really always be 0?
-						static_cast<uint32_t>(N), handles.data(), offsets.data()
-					);
-					cb.handle().draw(aNumberOfVertices, aNumberOfInstances, aFirstVertex, aFirstInstance);
-				}
+				fun
 			};
+			result.mLower = &lower_recording_function<decltype(fun)>;
+			return result;
 		}
 
 		/**	Draw vertices with vertex buffer bindings starting at BUFFER-BINDING #0 top to the number of total buffers passed -1.
@@ -718,7 +988,32 @@ namespace avk
 				default: AVK_LOG_ERROR("The given size[" + std::to_string(indexMeta.sizeof_one_element()) + "] does not correspond to a valid vk::IndexType"); break;
 			}
 
-			return action_type_command{
+			auto fun = [
+					lBindingCount = static_cast<uint32_t>(N),
+					handles, offsets, indexType,
+					lNumElemments = static_cast<uint32_t>(indexMeta.num_elements()),
+					lIndexBufferHandle = aIndexBuffer.handle(),
+					aNumberOfInstances, aFirstIndex, aVertexOffset, aFirstInstance
+				](auto& aTarget) {
+					if constexpr (is_lowering_target_v<decltype(aTarget)>) {
+						aTarget = lowered::draw_indexed{
+							std::vector<vk::Buffer>(std::begin(handles), std::end(handles)),
+							std::vector<vk::DeviceSize>(std::begin(offsets), std::end(offsets)),
+							lIndexBufferHandle, indexType,
+							lNumElemments, aNumberOfInstances, aFirstIndex, static_cast<int32_t>(aVertexOffset), aFirstInstance
+						};
+					}
+					else {
+						aTarget.handle().bindVertexBuffers(
+							0u, // TODO: Should the first binding really always be 0?
+							lBindingCount, handles.data(), offsets.data()
+						);
+						aTarget.handle().bindIndexBuffer(lIndexBufferHandle, 0u, indexType);
+						aTarget.handle().drawIndexed(lNumElemments, aNumberOfInstances, aFirstIndex, aVertexOffset, aFirstInstance);
+					}
+				};
+
+			auto result = action_type_command{
 				avk::sync::sync_hint {
 					{{ // DESTINATION dependencies for previous commands:
 						vk::PipelineStageFlagBits2KHR::eAllGraphics,
@@ -730,21 +1025,10 @@ namespace avk
 					}}
 				},
 				{}, // no resource-specific sync hints
-				[
-					lBindingCount = static_cast<uint32_t>(N),
-					handles, offsets, indexType,
-					lNumElemments = static_cast<uint32_t>(indexMeta.num_elements()),
-					lIndexBufferHandle = aIndexBuffer.handle(),
-					aNumberOfInstances, aFirstIndex, aVertexOffset, aFirstInstance
-				](avk::command_buffer_t& cb) {
-					cb.handle().bindVertexBuffers(
-						0u, // TODO: Should the first binding really always be 0?
-						lBindingCount, handles.data(), offsets.data()
-					);
-					cb.handle().bindIndexBuffer(lIndexBufferHandle, 0u, indexType);
-					cb.handle().drawIndexed(lNumElemments, aNumberOfInstances, aFirstIndex, aVertexOffset, aFirstInstance);
-				}
+				fun
 			};
+			result.mLower = &lower_recording_function<decltype(fun)>;
+			return result;
 		}
 
 		/**	Perform an indexed draw call with vertex buffer bindings starting at BUFFER-BINDING #0 top to the number of total vertex buffers passed -1.
@@ -938,6 +1222,15 @@ namespace avk
          */
         extern action_type_command dispatch(uint32_t aGroupCountX, uint32_t aGroupCountY, uint32_t aGroupCountZ);
 
+		/**	Perform an indirect dispatch call, i.e., invoke a compute shader with the number of workgroups read from a buffer.
+		 *	The parameters are read when the command is executed, not when it is recorded. Hence, they can be changed
+		 *	between submissions of a command buffer which has been recorded only once (see baked_parameters_t).
+		 *	@param	aParametersBuffer	Buffer which contains a vk::DispatchIndirectCommand structure
+		 *	@param	aParametersOffset	Byte offset into aParametersBuffer where the vk::DispatchIndirectCommand structure begins
+		 *	@return An action_type_command instance which you must submit to a queue.
+		 */
+		extern action_type_command dispatch_indirect(const buffer_t& aParametersBuffer, vk::DeviceSize aParametersOffset = 0);
+
 		/**
 		 * \brief Invoke a graphics mesh pipeline-type draw call using an API function provided by VK_NV_mesh_shader.
 		 * \param aTaskCount The number of local workgroups to dispatch in the X dimension. Y and Z dimension are implicitly set to one.
@@ -1113,6 +1406,15 @@ namespace avk
 	{
 		avk::resource_argument<avk::semaphore_t> mWaitSemaphore;
 		avk::stage::pipeline_stage_flags mDstStage;
+		/** The counter value to wait for if mWaitSemaphore is a timeline semaphore; ignored for binary semaphores */
+		uint64_t mValue = 0;
+
+		/** Wait until the timeline semaphore has reached the given counter value, like: (timelineSem >> stage::transfer).at_value(42) */
+		semaphore_wait_info at_value(uint64_t aValue) &&
+		{
+			mValue = aValue;
+			return std::move(*this);
+		}
 	};
 
 	inline semaphore_wait_info operator>> (avk::resource_argument<avk::semaphore_t> a, avk::stage::pipeline_stage_flags b)
@@ -1125,6 +1427,15 @@ namespace avk
 	{
 		avk::stage::pipeline_stage_flags mSrcStage;
 		avk::resource_argument<avk::semaphore_t> mSignalSemaphore;
+		/** The counter value to set if mSignalSemaphore is a timeline semaphore; ignored for binary semaphores */
+		uint64_t mValue = 0;
+
+		/** Set the timeline semaphore to the given counter value, like: (stage::transfer >> timelineSem).at_value(42) */
+		semaphore_signal_info at_value(uint64_t aValue) &&
+		{
+			mValue = aValue;
+			return std::move(*this);
+		}
 	};
 
 	inline semaphore_signal_info operator>> (avk::stage::pipeline_stage_flags a, avk::resource_argument<avk::semaphore_t> b)
@@ -1134,6 +1445,8 @@ namespace avk
 
 
 	class recorded_command_buffer;
+	class completion_reactor;
+	class gpu_completion;
 
 	// Something that submits stuff to a queue.
 	// The submission itself either happens in submit() or in this class' destructor, if submit()/go()/do_it() has never been invoked before.
@@ -1165,7 +1478,11 @@ namespace avk
 
 		submission_data& submit_to(const queue& aQueue);
 		submission_data& waiting_for(avk::semaphore_wait_info aWaitInfo);
+		// Wait until the given timeline semaphore has reached (at least) aValue before aDstStage is executed
+		submission_data& waiting_for(avk::resource_argument<avk::semaphore_t> aTimelineSemaphore, uint64_t aValue, avk::stage::pipeline_stage_flags aDstStage = avk::stage::all_commands);
 		submission_data& signaling_upon_completion(semaphore_signal_info aSignalInfo);
+		// Set the given timeline semaphore to aValue after aSrcStage has completed
+		submission_data& signaling_upon_completion(avk::resource_argument<avk::semaphore_t> aTimelineSemaphore, uint64_t aValue, avk::stage::pipeline_stage_flags aSrcStage = avk::stage::all_commands);
 		submission_data& signaling_upon_completion(avk::resource_argument<avk::fence_t> aFence);
 
 		bool is_sane() const { return nullptr != mRoot; }
@@ -1174,9 +1491,24 @@ namespace avk
 		void go() { submit(); }
 		void do_it() { submit(); }
 
+		/**	Submit (unless that has already happened) and get a co_await-able object which resumes the awaiting coroutine when the
+		 *	GPU work has completed. The completion is determined by the fence, if one has been set, or otherwise by a timeline
+		 *	semaphore which is signalled. If there is neither, a fence is created for this submission, unless it has already been
+		 *	submitted, in which case an avk::logic_error is thrown.
+		 *	The fence or timeline semaphore and the command buffer are moved into the returned object, i.e., the submission_data
+		 *	must not be used anymore afterwards.
+		 */
+		gpu_completion completion(completion_reactor& aReactor);
+
 		const auto* recorded_command_buffer_ptr() const { return mDangerousRecordedCommandBufferPointer; }
 
 	private:
+		friend class submission_batcher;
+		friend class submission_service;
+
+		// Resolves the stages of all semaphore waits and signals and appends one submit info for each of them
+		void gather_semaphore_submit_infos(std::vector<vk::SemaphoreSubmitInfoKHR>& aWaitInfos, std::vector<vk::SemaphoreSubmitInfoKHR>& aSignalInfos) const;
+
 		const root* mRoot = nullptr;
 		avk::resource_argument<avk::command_buffer_t> mCommandBufferToSubmit;
 		const queue* mQueueToSubmitTo;
@@ -1188,6 +1520,24 @@ namespace avk
 	};
 
 	class recorded_commands;
+	class command_stream;
+	class worker_pool;
+	class event_pool;
+
+	/**	Configuration for recording a list of commands into secondary command buffers in parallel
+	 *	(see recorded_commands::into_command_buffer_in_parallel).
+	 */
+	struct parallel_recording_config
+	{
+		/** One command pool per recording job, where the first one is used by the calling thread. All of them must have been
+		 *	created for the queue family of the primary command buffer, and they must not be used by any other thread during recording.
+		 *	The number of command pools determines the maximum number of secondary command buffers which are recorded concurrently. */
+		std::vector<std::reference_wrapper<command_pool_t>> mPerThreadCommandPools;
+		/** The long-lived threads which execute the recording jobs. If not set, worker_pool::shared() is used. */
+		worker_pool* mWorkerPool = nullptr;
+		/** Parallelizable ranges of commands are only split into multiple secondary command buffers if each one gets at least this many commands. */
+		uint32_t mMinCommandsPerSecondaryCommandBuffer = 64u;
+	};
 
 	// This class turns a std::vector<recorded_commands_t> into an actual command buffer
 	class recorded_command_buffer final
@@ -1195,6 +1545,8 @@ namespace avk
 	public:
 		// The constructor performs all the parsing, therefore, there's no std::vector<recorded_commands_t> member.
 		recorded_command_buffer(const root* aRoot, const std::vector<recorded_commands_t>& aRecordedCommandsAndSyncInstructions, avk::resource_argument<avk::command_buffer_t> aCommandBuffer, const avk::recorded_commands* aDangerousRecordedCommandsPointer = nullptr, bool aBeginEnd = true);
+		// Like the constructor above, but records the commands in parallel into secondary command buffers (see recorded_commands::into_command_buffer_in_parallel).
+		recorded_command_buffer(const root* aRoot, const std::vector<recorded_commands_t>& aRecordedCommandsAndSyncInstructions, avk::resource_argument<avk::command_buffer_t> aCommandBuffer, const parallel_recording_config& aParallelRecordingConfig, const avk::recorded_commands* aDangerousRecordedCommandsPointer = nullptr, bool aBeginEnd = true);
 		
 		recorded_command_buffer(const recorded_command_buffer&) = default;
 		recorded_command_buffer(recorded_command_buffer&&) noexcept = default;
@@ -1214,10 +1566,16 @@ namespace avk
 
 		const auto* recorded_commands_ptr() const { return mDangerousRecordedComandsPointer; }
 
+		/** Consecutive sync_type_commands are merged into as few vkCmdPipelineBarrier2 calls as possible during recording.
+		 *	@return	The number of vkCmdPipelineBarrier2 calls that have been saved compared to recording one call per barrier.
+		 */
+		uint32_t num_pipeline_barrier_calls_saved() const { return mNumPipelineBarrierCallsSaved; }
+
 	private:
 		const root* mRoot;
 		avk::resource_argument<avk::command_buffer_t> mCommandBufferToRecordInto;
 		const avk::recorded_commands* mDangerousRecordedComandsPointer;
+		uint32_t mNumPipelineBarrierCallsSaved = 0u;
 	};
 
 	// This class gathers recorded commands which can then be recorded into a command buffer via into_command_buffer()
@@ -1239,15 +1597,80 @@ namespace avk
 
 		recorded_commands& handle_lifetime_of(any_owning_resource_t aResource);
 
+		/**	Optional optimization pass which is intended to be invoked before into_command_buffer.
+		 *	It removes barriers which are provably no-ops (i.e., their source or destination scopes are empty, as
+		 *	it happens after host-visible buffer_t::fill operations), barriers which are fully covered by an earlier
+		 *	barrier with no action_type_command in between, and merges barriers for the same resources (or global
+		 *	barriers) with no action_type_command in between into one by widening the earlier barrier.
+		 *	Barriers with queue family ownership transfers are never touched. Nested commands are processed as well.
+		 *	The number of removed barriers can be queried via barrier_elimination_stats().
+		 */
+		recorded_commands& eliminate_redundant_barriers();
+
+		/**	How many barriers have been removed by (all invocations of) eliminate_redundant_barriers() on this instance.
+		 */
+		const auto& barrier_elimination_stats() const { return mBarrierEliminationStats; }
+
+		/**	Optional optimization pass which is intended to be invoked before into_command_buffer.
+		 *	It converts top-level image memory barriers and buffer memory barriers into split barriers (see sync::signal_split_barrier
+		 *	and sync::wait_split_barrier) if there is unrelated work between the command which produces the data and the barrier:
+		 *	The signal half is placed right after the producing command, and the wait half replaces the barrier. Thereby, the unrelated
+		 *	work in between can execute while the dependency is being resolved.
+		 *	Both halves get the stages and accesses which the barrier's auto_stage/auto_access parts have been resolved to.
+		 *
+		 *	Only the resource-specific sync hints of action_type_commands are regarded for determining the producing command and
+		 *	unrelated work. An action_type_command without any resource-specific sync hints might access the resource, therefore,
+		 *	the signal half is never moved above it. Barriers with queue family ownership transfers, and barriers whose halves would
+		 *	be placed within a render pass instance or across an action_type_command with nested commands, are not converted.
+		 *	The required events are kept alive by the command buffer which the commands are recorded into.
+		 *	@param	aMinNumUnrelatedCommands	Minimum number of unrelated action_type_commands between the producing command and the barrier.
+		 *	@param	aEventPool					The pool to acquire the required events from. If not set, root::split_barrier_event_pool
+		 *										is used, and if the root does not provide one either, new events are created.
+		 */
+		recorded_commands& split_barriers(uint32_t aMinNumUnrelatedCommands = 1u, event_pool* aEventPool = nullptr);
+
+		/**	How many barriers have been converted into split barriers by (all invocations of) split_barriers() on this instance.
+		 */
+		uint32_t num_split_barriers() const { return mNumSplitBarriers; }
+
 		std::vector<recorded_commands_t> and_store();
+
+		/**	Lowers the recorded commands into a compact command_stream (see command_stream::append_lowered),
+		 *	which takes over the lifetime handling of all resources whose lifetimes have been handled by this instance.
+		 */
+		command_stream into_command_stream();
+
 		recorded_command_buffer into_command_buffer(avk::resource_argument<avk::command_buffer_t> aCommandBuffer, bool aBeginEnd = true);
 
+		/**	Records the commands into the given primary command buffer, whereby large parts of them are recorded in parallel into
+		 *	secondary command buffers by multiple threads, which are then executed via vkCmdExecuteCommands.
+		 *	All auto_stage/auto_access parts of barriers are resolved for the whole list of commands before it is split up.
+		 *
+		 *	The top-level commands are split at render pass boundaries (see command::render_pass_boundary). Commands in subpasses
+		 *	whose contents are inline (which is the default for begin_render_pass_for_framebuffer), render passes with nested commands,
+		 *	and the begin/next_subpass/end commands themselves are recorded into the primary command buffer. Commands outside of
+		 *	render passes, and commands in subpasses whose contents are provided via secondary command buffers (i.e., aSubpassesInline
+		 *	has been set to false), are split into chunks which are recorded into secondary command buffers.
+		 *	Since secondary command buffers do not inherit any state, the top-level state_type_commands which precede a chunk are
+		 *	recorded into it again, i.e., state_type_commands are assumed to only set state (e.g., bind pipelines or descriptor sets).
+		 *	Pipeline binds, descriptor set binds, and push constants which have been replaced by later ones are not recorded again.
+		 *
+		 *	The secondary command buffers are allocated from the command pools of aParallelRecordingConfig and are kept alive by the
+		 *	primary command buffer. They are recorded by the threads of parallel_recording_config::mWorkerPool.
+		 */
+		recorded_command_buffer into_command_buffer_in_parallel(avk::resource_argument<avk::command_buffer_t> aCommandBuffer, const parallel_recording_config& aParallelRecordingConfig, bool aBeginEnd = true);
+
 		const auto& recorded_commands_and_sync_instructions() const { return mRecordedCommandsAndSyncInstructions; }
 
 	private:
 		const root* mRoot;
 		std::vector<recorded_commands_t> mRecordedCommandsAndSyncInstructions;
 		std::vector<any_owning_resource_t> mLifetimeHandledResources;
+		sync::barrier_elimination_statistics mBarrierEliminationStats;
+		uint32_t mNumSplitBarriers = 0u;
+
+		// Hands the lifetime-handled resources over to the given recorded command buffer:
+		void transfer_lifetime_handled_resources_to(recorded_command_buffer& aRecordedCommandBuffer);
 	};
 
 
@@ -0,0 +1,125 @@
+#pragma once
+#include "avk/avk.hpp"
+
+namespace avk
+{
+	/**	Runs continuations once GPU work has completed. A dedicated thread waits for all pending fences and timeline
+	 *	semaphore values at once (see completion_set::wait_any) and invokes the continuations of those which have completed.
+	 *	This drives the co_await-able gpu_completion, i.e., coroutines which await GPU work are resumed on the reactor's thread.
+	 */
+	class completion_reactor
+	{
+	public:
+		/**	Create a completion reactor and start its thread.
+		 *	@param	aRoot				The root which the fences and semaphores to wait for belong to.
+		 *	@param	aMaxWaitSliceNs		The thread does not wait longer than this in one driver call, s.t. newly registered
+		 *								completion points are picked up after at most this time.
+		 */
+		completion_reactor(const root* aRoot, uint64_t aMaxWaitSliceNs = 1000000);
+		completion_reactor(const completion_reactor&) = delete;
+		completion_reactor(completion_reactor&&) noexcept = delete;
+		completion_reactor& operator=(const completion_reactor&) = delete;
+		completion_reactor& operator=(completion_reactor&&) noexcept = delete;
+		/**	Waits until all pending completion points have completed and their continuations have been invoked. */
+		~completion_reactor();
+
+		/**	Invoke the given continuation on the reactor's thread once the timeline semaphore has reached the given value.
+		 *	The semaphore must stay alive until then. */
+		void when_complete(const semaphore_t& aTimelineSemaphore, uint64_t aValue, avk::unique_function<void()> aContinuation);
+
+		/**	Invoke the given continuation on the reactor's thread once the fence has been signalled.
+		 *	The fence must stay alive until then. */
+		void when_complete(const fence_t& aFence, avk::unique_function<void()> aContinuation);
+
+	private:
+		// A fence (if mFence is set) or a timeline value, and what to do when it has completed
+		struct waiter
+		{
+			const fence_t* mFence = nullptr;
+			const semaphore_t* mSemaphore = nullptr;
+			uint64_t mValue = 0;
+			avk::unique_function<void()> mContinuation;
+		};
+
+		void reactor_loop();
+
+		const root* mRoot;
+		uint64_t mMaxWaitSliceNs;
+		std::mutex mMutex;
+		std::condition_variable mCondition;
+		std::vector<waiter> mNewWaiters;
+		bool mStopRequested = false;
+		std::thread mReactorThread;
+	};
+
+	/**	The co_await-able completion of a submission (see submission_data::completion):
+	 *
+	 *	co_await queue.submit(cmdBfr).completion(reactor);
+	 *
+	 *	The awaiting coroutine is resumed on the completion_reactor's thread after the GPU work has completed. Before it is
+	 *	resumed, the submitted command buffer's post-execution handler is invoked, i.e., data which has been read back with
+	 *	buffer_t::read_into is available afterwards (also see gpu_result).
+	 */
+	class gpu_completion
+	{
+		friend class submission_data;
+
+	public:
+		gpu_completion(const gpu_completion&) = delete;
+		gpu_completion(gpu_completion&&) noexcept = default;
+		gpu_completion& operator=(const gpu_completion&) = delete;
+		gpu_completion& operator=(gpu_completion&&) noexcept = default;
+		~gpu_completion() = default;
+
+		/**	True if the GPU work has completed. Does not block. */
+		bool is_complete() const;
+
+		bool await_ready() const { return is_complete(); }
+		void await_suspend(std::coroutine_handle<> aCoroutine);
+		void await_resume();
+
+	private:
+		gpu_completion(completion_reactor* aReactor) : mReactor{ aReactor } {}
+
+		// Invokes the command buffer's post-execution handler, but only once
+		void handle_post_execution();
+
+		completion_reactor* mReactor;
+		std::optional<avk::resource_argument<avk::fence_t>> mFence;
+		std::optional<avk::resource_argument<avk::semaphore_t>> mTimelineSemaphore;
+		uint64_t mTimelineValue = 0;
+		std::optional<avk::resource_argument<avk::command_buffer_t>> mCommandBuffer;
+		bool mPostExecutionHandled = false;
+	};
+
+	/**	A gpu_completion which resumes with a value that has been written by the GPU work, e.g., by a readback:
+	 *
+	 *	auto data = std::make_unique<std::array<float, 64>>();
+	 *	auto completion = root.record({ buffer->read_into(data.get(), 0) })
+	 *		.into_command_buffer(cmdBfr)
+	 *		.then_submit_to(queue)
+	 *		.completion(reactor);
+	 *	std::array<float, 64> values = co_await avk::gpu_result{ std::move(completion), std::move(data) };
+	 */
+	template <typename T>
+	class gpu_result
+	{
+	public:
+		gpu_result(gpu_completion aCompletion, std::unique_ptr<T> aStorage)
+			: mCompletion{ std::move(aCompletion) }
+			, mStorage{ std::move(aStorage) }
+		{}
+
+		bool await_ready() const { return mCompletion.await_ready(); }
+		void await_suspend(std::coroutine_handle<> aCoroutine) { mCompletion.await_suspend(aCoroutine); }
+		T await_resume()
+		{
+			mCompletion.await_resume();
+			return std::move(*mStorage);
+		}
+
+	private:
+		gpu_completion mCompletion;
+		std::unique_ptr<T> mStorage;
+	};
+}
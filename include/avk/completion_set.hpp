@@ -0,0 +1,106 @@
+#pragma once
+#include "avk/avk.hpp"
+
+namespace avk
+{
+	/**	A set of GPU completion points, each of which is either a fence or a value of a timeline semaphore, which can be
+	 *	waited on as a whole with as few driver calls as possible, or polled without blocking:
+	 *
+	 *	avk::completion_set inFlight{ &root };
+	 *	std::unordered_map<avk::completion_set::completion_id, transfer*> transferOfId;
+	 *	for (auto& transfer : transfers) {
+	 *		transferOfId[inFlight.add(transfer.mFence)] = &transfer;
+	 *	}
+	 *	while (!inFlight.empty()) {
+	 *		inFlight.wait_any();
+	 *		for (auto id : inFlight.remove_completed()) { ... transferOfId[id] ... }
+	 *	}
+	 *
+	 *	Fences are waited on with one vkWaitForFences, timeline values with one vkWaitSemaphores. Only if a set contains both,
+	 *	wait_any has to alternate between the two, with a time slice of aMixedWaitSliceNs each.
+	 *	The fences and semaphores must stay alive as long as they are part of the set.
+	 */
+	class completion_set
+	{
+	public:
+		/**	Identifies a completion point within a set. Ids are not reused by the same set, i.e., an id stays valid (and refers to the
+		 *	same completion point) until that completion point is removed, regardless of which other ones are added or removed.
+		 */
+		using completion_id = uint64_t;
+
+		completion_set(const root* aRoot) : mRoot{ aRoot } {}
+		completion_set(const completion_set&) = default;
+		completion_set(completion_set&&) noexcept = default;
+		completion_set& operator=(const completion_set&) = default;
+		completion_set& operator=(completion_set&&) noexcept = default;
+		~completion_set() = default;
+
+		/**	Add a fence to the set.
+		 *	@return	The id of this completion point, which poll and remove_completed return once it is complete.
+		 */
+		completion_id add(const fence_t& aFence);
+
+		/**	Add a value of a timeline semaphore to the set, which is complete once the semaphore has reached (at least) that value.
+		 *	@return	The id of this completion point, which poll and remove_completed return once it is complete.
+		 */
+		completion_id add(const semaphore_t& aTimelineSemaphore, uint64_t aValue);
+
+		/**	Wait until all completion points of the set are complete.
+		 *	@param	aTimeout	Timeout in nanoseconds. If not set, wait indefinitely.
+		 *	@return	true if all are complete, false if the timeout has expired before.
+		 */
+		bool wait_all(std::optional<uint64_t> aTimeout = {}) const;
+
+		/**	Wait until at least one completion point of the set is complete. Returns immediately if the set is empty.
+		 *	@param	aTimeout			Timeout in nanoseconds. If not set, wait indefinitely.
+		 *	@param	aMixedWaitSliceNs	Only relevant if the set contains fences as well as timeline values, see above.
+		 *	@return	true if at least one is complete, false if the timeout has expired before.
+		 */
+		bool wait_any(std::optional<uint64_t> aTimeout = {}, uint64_t aMixedWaitSliceNs = 100000) const;
+
+		/**	Query, without blocking, which completion points are complete. They remain part of the set, i.e., wait_any keeps
+		 *	returning immediately until they have been removed (see remove_completed).
+		 *	Every timeline semaphore's value is queried only once, regardless of how many of its values are part of the set.
+		 *	@return	The ids of all complete completion points, in the order in which they have been added.
+		 */
+		std::vector<completion_id> poll() const;
+
+		/**	Remove the completion point with the given id from the set. */
+		void remove(completion_id aId);
+
+		/**	Query, without blocking, which completion points are complete (like poll), and remove them from the set.
+		 *	@return	The ids of the removed completion points, in the order in which they have been added.
+		 */
+		std::vector<completion_id> remove_completed();
+
+		/**	Number of completion points in the set. */
+		uint32_t size() const { return static_cast<uint32_t>(mPoints.size()); }
+		bool empty() const { return mPoints.empty(); }
+
+		/**	Remove all completion points from the set. */
+		void clear();
+
+	private:
+		// A fence (if mFence is set) or a timeline value
+		struct completion_point
+		{
+			completion_id mId;
+			vk::Fence mFence;
+			vk::Semaphore mSemaphore;
+			uint64_t mValue = 0;
+		};
+
+		bool wait_fences(bool aWaitAll, uint64_t aTimeout) const;
+		bool wait_semaphores(bool aWaitAll, uint64_t aTimeout) const;
+		void rebuild_wait_arrays();
+
+		const root* mRoot;
+		completion_id mNextId = 0;
+		// In the order in which they have been added, i.e., in ascending order of their ids:
+		std::vector<completion_point> mPoints;
+		// The same data as in mPoints, but in the layout vkWaitForFences and vkWaitSemaphores expect:
+		std::vector<vk::Fence> mFences;
+		std::vector<vk::Semaphore> mSemaphores;
+		std::vector<uint64_t> mValues;
+	};
+}
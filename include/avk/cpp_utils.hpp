@@ -816,6 +816,206 @@ namespace avk
 		return static_cast<bool>(f);
 	}
 
+	/**	A type-erased and copyable callable with the signature T, i.e., like std::function<T>, but which stores
+	 *	callables of up to Capacity bytes inline, i.e., without any heap allocation.
+	 *	Only callables which are larger than Capacity, over-aligned, or not nothrow-move-constructible are
+	 *	moved onto the heap.
+	 */
+	template<typename T, size_t Capacity>
+	class inline_function;
+
+	template<typename R, typename... Args, size_t Capacity>
+	class inline_function<R(Args...), Capacity>
+	{
+		static_assert(Capacity >= sizeof(void*), "The inline storage must at least be able to hold a pointer.");
+
+		// Type-specific operations. There is one (static) instance per stored callable type:
+		struct operations
+		{
+			R    (*mInvoke) (void* aStorage, Args&&... aArgs);
+			void (*mCopy)   (void* aTarget, const void* aSource);
+			void (*mMove)   (void* aTarget, void* aSource) noexcept;
+			void (*mDestroy)(void* aStorage) noexcept;
+		};
+
+		template<typename Fn>
+		static constexpr bool stored_inline_v = sizeof(Fn) <= Capacity && alignof(Fn) <= alignof(std::max_align_t) && std::is_nothrow_move_constructible_v<Fn>;
+
+		template<typename Fn>
+		static const operations* operations_for() noexcept
+		{
+			if constexpr (stored_inline_v<Fn>) {
+				static constexpr operations sOperations{
+					[](void* aStorage, Args&&... aArgs) -> R { return std::invoke(*std::launder(static_cast<Fn*>(aStorage)), std::forward<Args>(aArgs)...); },
+					[](void* aTarget, const void* aSource) { new (aTarget) Fn(*std::launder(static_cast<const Fn*>(aSource))); },
+					[](void* aTarget, void* aSource) noexcept {
+						auto* source = std::launder(static_cast<Fn*>(aSource));
+						new (aTarget) Fn(std::move(*source));
+						source->~Fn();
+					},
+					[](void* aStorage) noexcept { std::launder(static_cast<Fn*>(aStorage))->~Fn(); }
+				};
+				return &sOperations;
+			}
+			else {
+				// The inline storage only holds a pointer to the heap-allocated callable:
+				static constexpr operations sOperations{
+					[](void* aStorage, Args&&... aArgs) -> R { return std::invoke(**static_cast<Fn**>(aStorage), std::forward<Args>(aArgs)...); },
+					[](void* aTarget, const void* aSource) { new (aTarget) Fn*(new Fn(**static_cast<Fn* const*>(aSource))); },
+					[](void* aTarget, void* aSource) noexcept { new (aTarget) Fn*(*static_cast<Fn**>(aSource)); },
+					[](void* aStorage) noexcept { delete *static_cast<Fn**>(aStorage); }
+				};
+				return &sOperations;
+			}
+		}
+
+		template<typename Fn>
+		static bool is_empty_callable(const Fn& aFn) noexcept
+		{
+			if constexpr (std::is_pointer_v<Fn> || std::is_member_pointer_v<Fn> || std::is_same_v<Fn, std::function<R(Args...)>>) {
+				return !static_cast<bool>(aFn);
+			}
+			else {
+				return false;
+			}
+		}
+
+	public:
+		inline_function() noexcept = default;
+		inline_function(std::nullptr_t) noexcept {}
+
+		inline_function(const inline_function& aOther)
+		{
+			if (nullptr != aOther.mOperations) {
+				aOther.mOperations->mCopy(mStorage, aOther.mStorage);
+				mOperations = aOther.mOperations;
+			}
+		}
+
+		inline_function(inline_function&& aOther) noexcept
+		{
+			if (nullptr != aOther.mOperations) {
+				aOther.mOperations->mMove(mStorage, aOther.mStorage);
+				mOperations = aOther.mOperations;
+				aOther.mOperations = nullptr;
+			}
+		}
+
+		template<typename F, typename Fn = std::decay_t<F>>
+			requires (!std::is_same_v<Fn, inline_function> && std::is_copy_constructible_v<Fn> && std::is_invocable_r_v<R, Fn&, Args...>)
+		inline_function(F&& aFn)
+		{
+			if (is_empty_callable(aFn)) {
+				return;
+			}
+			if constexpr (stored_inline_v<Fn>) {
+				new (static_cast<void*>(mStorage)) Fn(std::forward<F>(aFn));
+			}
+			else {
+				new (static_cast<void*>(mStorage)) Fn*(new Fn(std::forward<F>(aFn)));
+			}
+			mOperations = operations_for<Fn>();
+		}
+
+		~inline_function()
+		{
+			reset();
+		}
+
+		inline_function& operator=(const inline_function& aOther)
+		{
+			if (this != &aOther) {
+				inline_function copy(aOther);
+				*this = std::move(copy);
+			}
+			return *this;
+		}
+
+		inline_function& operator=(inline_function&& aOther) noexcept
+		{
+			if (this != &aOther) {
+				reset();
+				if (nullptr != aOther.mOperations) {
+					aOther.mOperations->mMove(mStorage, aOther.mStorage);
+					mOperations = aOther.mOperations;
+					aOther.mOperations = nullptr;
+				}
+			}
+			return *this;
+		}
+
+		inline_function& operator=(std::nullptr_t) noexcept
+		{
+			reset();
+			return *this;
+		}
+
+		template<typename F, typename Fn = std::decay_t<F>>
+			requires (!std::is_same_v<Fn, inline_function> && std::is_copy_constructible_v<Fn> && std::is_invocable_r_v<R, Fn&, Args...>)
+		inline_function& operator=(F&& aFn)
+		{
+			return *this = inline_function(std::forward<F>(aFn));
+		}
+
+		R operator()(Args... aArgs) const
+		{
+			if (nullptr == mOperations) {
+				throw std::bad_function_call();
+			}
+			return mOperations->mInvoke(mStorage, std::forward<Args>(aArgs)...);
+		}
+
+		explicit operator bool() const noexcept
+		{
+			return nullptr != mOperations;
+		}
+
+		/**	Returns a pointer to the stored callable if it is of type Fn, or nullptr otherwise (like std::function::target). */
+		template<typename Fn>
+		const Fn* target() const noexcept
+		{
+			if constexpr (!std::is_invocable_r_v<R, Fn&, Args...>) {
+				return nullptr; // Could not have been stored
+			}
+			else {
+				if (nullptr == mOperations || operations_for<Fn>() != mOperations) {
+					return nullptr;
+				}
+				if constexpr (stored_inline_v<Fn>) {
+					return std::launder(reinterpret_cast<const Fn*>(mStorage));
+				}
+				else {
+					return *std::launder(reinterpret_cast<Fn* const*>(mStorage));
+				}
+			}
+		}
+
+		void swap(inline_function& aOther) noexcept
+		{
+			inline_function tmp(std::move(aOther));
+			aOther = std::move(*this);
+			*this = std::move(tmp);
+		}
+
+	private:
+		void reset() noexcept
+		{
+			if (nullptr != mOperations) {
+				mOperations->mDestroy(mStorage);
+				mOperations = nullptr;
+			}
+		}
+
+		alignas(std::max_align_t) mutable std::byte mStorage[Capacity];
+		const operations* mOperations = nullptr;
+	};
+
+	template<typename R, typename... Args, size_t Capacity>
+	static void swap(inline_function<R(Args...), Capacity>& lhs, inline_function<R(Args...), Capacity>& rhs) noexcept
+	{
+		lhs.swap(rhs);
+	}
+
 	/*	Combines multiple hash values.
 	 *  Inspiration and implementation largely taken from: https://stackoverflow.com/questions/2590677/how-do-i-combine-hash-values-in-c0x/54728293#54728293
 	 *  TODO: Should a larger magic constant be used since we're only supporting x64 and hence, size_t will always be 64bit?!
@@ -0,0 +1,149 @@
+#pragma once
+#include "avk/avk.hpp"
+
+namespace avk
+{
+	/**	The role of a queue in a cross_queue_scheduler. */
+	enum struct queue_role
+	{
+		graphics,
+		async_compute,
+		transfer
+	};
+
+	/**	Refers to one group of commands which has been added to a cross_queue_scheduler.
+	 *	It has completed on the GPU once mTimelineSemaphore has reached mTimelineValue.
+	 */
+	struct scheduled_work
+	{
+		const queue* mQueue = nullptr;
+		const semaphore_t* mTimelineSemaphore = nullptr;
+		uint64_t mTimelineValue = 0;
+	};
+
+	/**	Distributes groups of recorded commands to a graphics queue, an async compute queue, and a transfer queue, and inserts
+	 *	the synchronization between the queues automatically:
+	 *	 - Every queue has a timeline semaphore, and every group of commands signals the next value of its queue's timeline semaphore.
+	 *	 - If a group uses a resource which has last been used by a group on a different queue, it waits for that group's timeline value.
+	 *	 - If, additionally, the two queues belong to different queue families and the resource has been created with exclusive
+	 *	   sharing mode, a release barrier is appended to the earlier group and a matching acquire barrier is prepended to the later
+	 *	   group (i.e., a queue family ownership transfer). Their stages and accesses are determined via auto_stage and auto_access.
+	 *
+	 *	Only resources which have been registered via track are considered. Which resources a group uses is determined from the
+	 *	resource-specific sync hints of its action_type_commands and from its image and buffer memory barriers. The layout which an
+	 *	image is handed over in is the layout after the most recent layout transition of a group which has been added before.
+	 *
+	 *	avk::cross_queue_scheduler scheduler{ &root, graphicsQueue, &computeQueue, &transferQueue };
+	 *	scheduler.track(particleBuffer).track(heightmap, avk::layout::shader_read_only_optimal);
+	 *	scheduler.add(avk::queue_role::transfer, { avk::command::copy_buffer_to_image(...) });
+	 *	scheduler.add(avk::queue_role::async_compute, { avk::command::dispatch(...) });
+	 *	scheduler.add(avk::queue_role::graphics, { ... });
+	 *	scheduler.submit();
+	 *
+	 *	Groups on the same queue are submitted in the order they have been added. Synchronization between groups on the same
+	 *	queue is not inserted by the scheduler, i.e., it is expressed through barriers within the groups as usual.
+	 *	The scheduler is conservative in that it does not distinguish between reads and writes: Every use of a tracked resource
+	 *	on a different queue than its previous use establishes a dependency.
+	 */
+	class cross_queue_scheduler
+	{
+	public:
+		/**	@param	aRoot				The root which command pools and timeline semaphores are created through.
+		 *	@param	aGraphicsQueue		The queue for queue_role::graphics.
+		 *	@param	aAsyncComputeQueue	The queue for queue_role::async_compute. If nullptr, the graphics queue is used.
+		 *	@param	aTransferQueue		The queue for queue_role::transfer. If nullptr, the async compute queue is used (or the graphics queue).
+		 */
+		cross_queue_scheduler(root* aRoot, const queue& aGraphicsQueue, const queue* aAsyncComputeQueue = nullptr, const queue* aTransferQueue = nullptr);
+		cross_queue_scheduler(const cross_queue_scheduler&) = delete;
+		cross_queue_scheduler(cross_queue_scheduler&&) noexcept = delete;
+		cross_queue_scheduler& operator=(const cross_queue_scheduler&) = delete;
+		cross_queue_scheduler& operator=(cross_queue_scheduler&&) noexcept = delete;
+		/**	Waits until all submitted work has completed. */
+		~cross_queue_scheduler();
+
+		/**	Register an image, whose ownership shall be transferred automatically between queues.
+		 *	@param	aCurrentLayout	The layout which the image is in before the first group that uses it.
+		 */
+		cross_queue_scheduler& track(const image_t& aImage, avk::layout::image_layout aCurrentLayout);
+
+		/**	Register a buffer, whose ownership shall be transferred automatically between queues. */
+		cross_queue_scheduler& track(const buffer_t& aBuffer);
+
+		/**	Add a group of commands which shall be executed on the queue of the given role.
+		 *	@param	aDependencies	Additional work which this group must wait for, regardless of the tracked resources.
+		 */
+		scheduled_work add(queue_role aRole, std::vector<recorded_commands_t> aCommands, std::vector<scheduled_work> aDependencies = {});
+
+		/**	Record all groups which have been added since the last submit into command buffers and submit them to their queues.
+		 *	Command buffers of earlier submissions which have completed are released.
+		 */
+		void submit();
+
+		/**	True if the given work has completed on the GPU. Does not block. */
+		bool is_complete(const scheduled_work& aWork) const;
+
+		/**	Wait on the host until all submitted work has completed. */
+		void wait_idle() const;
+
+		const queue& queue_for(queue_role aRole) const { return *mQueueSlots[slot_of(aRole)].mQueue; }
+		const semaphore_t& timeline_semaphore_for(queue_role aRole) const { return mQueueSlots[slot_of(aRole)].mTimelineSemaphore.get(); }
+
+	private:
+		// One distinct queue, which might serve multiple roles
+		struct queue_slot
+		{
+			const queue* mQueue;
+			avk::semaphore mTimelineSemaphore;
+			avk::command_pool mCommandPool;
+			// The timeline value which has been assigned to the most recently added group:
+			uint64_t mLastValue = 0;
+			// The timeline value of the most recently submitted group:
+			uint64_t mLastSubmittedValue = 0;
+		};
+
+		// A group of commands which has been added, but not submitted yet
+		struct pending_group
+		{
+			size_t mQueueSlot;
+			uint64_t mTimelineValue;
+			std::vector<recorded_commands_t> mCommands;
+			// Timeline value to wait for, per queue slot (0 = nothing to wait for)
+			std::vector<uint64_t> mWaitValues;
+			std::vector<sync::sync_type_command> mAcquireBarriers;
+			std::vector<sync::sync_type_command> mReleaseBarriers;
+		};
+
+		// The state of a tracked image or buffer
+		struct tracked_resource
+		{
+			const image_t* mImage = nullptr;
+			const buffer_t* mBuffer = nullptr;
+			bool mConcurrentSharing = false;
+			vk::ImageLayout mLayout = vk::ImageLayout::eUndefined;
+			// Where the resource has been used most recently:
+			std::optional<size_t> mLastQueueSlot;
+			uint64_t mLastTimelineValue = 0;
+			// Index into mPendingGroups if the most recent use has not been submitted yet:
+			std::optional<size_t> mLastPendingGroup;
+		};
+
+		// A submitted command buffer which is kept alive until the GPU has completed it
+		struct in_flight_command_buffer
+		{
+			avk::command_buffer mCommandBuffer;
+			size_t mQueueSlot;
+			uint64_t mTimelineValue;
+		};
+
+		size_t slot_of(queue_role aRole) const { return mSlotOfRole[static_cast<size_t>(aRole)]; }
+		pending_group& add_pending_group(size_t aQueueSlot, std::vector<recorded_commands_t> aCommands);
+
+		root* mRoot;
+		std::vector<queue_slot> mQueueSlots;
+		std::array<size_t, 3> mSlotOfRole;
+		std::unordered_map<VkImage, tracked_resource> mTrackedImages;
+		std::unordered_map<VkBuffer, tracked_resource> mTrackedBuffers;
+		std::vector<pending_group> mPendingGroups;
+		std::deque<in_flight_command_buffer> mInFlight;
+	};
+}
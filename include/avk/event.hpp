@@ -0,0 +1,47 @@
+#pragma once
+#include "avk/avk.hpp"
+
+namespace avk
+{
+	/** A synchronization object which allows fine-grained GPU->GPU synchronization within one queue,
+	 *	in particular, splitting a barrier into a signal half and a wait half (see sync::signal_split_barrier
+	 *	and sync::wait_split_barrier).
+	 */
+	class event_t
+	{
+		friend class root;
+		friend class event_pool;
+
+	public:
+		event_t() = default;
+		event_t(const event_t&) = delete;
+		event_t(event_t&&) noexcept = default;
+		event_t& operator=(const event_t&) = delete;
+		event_t& operator=(event_t&&) noexcept = default;
+		~event_t();
+
+		const auto& create_info() const { return mCreateInfo; }
+		auto& create_info()				{ return mCreateInfo; }
+		const auto& handle() const { return mEvent.get(); }
+		const auto* handle_ptr() const { return &mEvent.get(); }
+
+		/**	Query the status of this event from the host.
+		 *	@return	true if the event is in the signaled state, false otherwise.
+		 */
+		bool is_set() const;
+
+		/**	Set this event to the unsignaled state from the host. It must not be used by
+		 *	any command buffer which is currently executing.
+		 */
+		void reset();
+
+	private:
+		vk::EventCreateInfo mCreateInfo;
+		vk::UniqueHandle<vk::Event, DISPATCH_LOADER_CORE_TYPE> mEvent;
+
+		/** If set, the event handle is handed over to this function upon destruction instead of being destroyed (see event_pool) */
+		std::optional<avk::unique_function<void(vk::UniqueHandle<vk::Event, DISPATCH_LOADER_CORE_TYPE>&&)>> mReturnHandleTo;
+	};
+
+	using event = avk::owning_resource<event_t>;
+}
@@ -7,6 +7,7 @@ namespace avk
 	class fence_t
 	{
 		friend class root;
+		friend class fence_pool;
 		
 	public:
 		fence_t() = default;
@@ -40,6 +41,8 @@ namespace avk
 		const auto* handle_ptr() const { return &mFence.get(); }
 
 		void wait_until_signalled(std::optional<uint64_t> aTimeout = {}) const;
+		/** Query the status of this fence from the host, without blocking. */
+		bool is_signalled() const;
 		void reset();
 
 	private:
@@ -52,6 +55,9 @@ namespace avk
 		std::optional<avk::unique_function<void()>> mCustomDeleter;
 
 		std::vector<any_owning_resource_t> mLifetimeHandledResources;
+
+		/** If set, the fence handle is handed over to this function upon destruction instead of being destroyed (see fence_pool) */
+		std::optional<avk::unique_function<void(vk::UniqueHandle<vk::Fence, DISPATCH_LOADER_CORE_TYPE>&&)>> mReturnHandleTo;
 	};
 
 	using fence = avk::owning_resource<fence_t>;
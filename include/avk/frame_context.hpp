@@ -0,0 +1,138 @@
+#pragma once
+#include "avk/avk.hpp"
+
+namespace avk
+{
+	/**	A range of a frame_context's upload arena, which is mapped persistently and can be written to on the host
+	 *	until the frame slot which it has been allocated for is recycled.
+	 */
+	struct frame_upload_allocation
+	{
+		const buffer_t* mBuffer = nullptr;
+		vk::DeviceSize mOffset = 0;
+		vk::DeviceSize mSize = 0;
+		void* mMappedMemory = nullptr;
+	};
+
+	/**	Manages the resources of N frames in flight, s.t. recording frame N+1 on the CPU overlaps with the GPU executing frame N.
+	 *
+	 *	Every frame slot has its own command pools, a linear upload arena in host-coherent memory, transient descriptor pools,
+	 *	and a list of resources which have been retired during the frame. All of them are recycled at once when the frame
+	 *	slot is used again, i.e., without any per-object bookkeeping: Command pools and descriptor pools are reset, the upload
+	 *	arena's offset is set back to zero, and the retired resources are destroyed.
+	 *
+	 *	Frame f signals value f of the frame_context's timeline semaphore. begin_frame waits until the frame which has used the
+	 *	same frame slot before has reached its value. Therefore, the last submission of every frame must signal frame_value():
+	 *
+	 *	avk::frame_context frames{ &root, 2, 4 * 1024 * 1024, { { vk::DescriptorType::eUniformBuffer, 256 } }, 64 };
+	 *	// Every frame:
+	 *	frames.begin_frame();
+	 *	auto& cmdBfr = frames.get_command_buffer(queue.family_index());
+	 *	auto params = frames.upload(perFrameData);
+	 *	...
+	 *	queue.submit(cmdBfr)
+	 *		.signaling_upon_completion(frames.timeline_semaphore(), frames.frame_value())
+	 *		.submit();
+	 *
+	 *	Command buffers can be requested from multiple threads concurrently. All other member functions must only be used
+	 *	from the thread which calls begin_frame.
+	 */
+	class frame_context
+	{
+	public:
+		/**	@param	aRoot						The root which all resources are created through.
+		 *	@param	aNumFrameSlots				Number of frames in flight.
+		 *	@param	aUploadArenaSize			Initial size of every frame slot's upload arena in bytes. An arena grows by
+		 *										further blocks of (at least) this size if a frame requires more space.
+		 *	@param	aDescriptorPoolSizes		Capacity of every transient descriptor pool. If a frame requires more
+		 *										descriptors, further pools are created.
+		 *	@param	aMaxDescriptorSetsPerPool	Maximum number of descriptor sets of every transient descriptor pool.
+		 */
+		frame_context(root* aRoot, uint32_t aNumFrameSlots, vk::DeviceSize aUploadArenaSize, std::vector<vk::DescriptorPoolSize> aDescriptorPoolSizes = {}, uint32_t aMaxDescriptorSetsPerPool = 0);
+		frame_context(const frame_context&) = delete;
+		frame_context(frame_context&&) noexcept = delete;
+		frame_context& operator=(const frame_context&) = delete;
+		frame_context& operator=(frame_context&&) noexcept = delete;
+		/**	Waits until the most recent frame has completed on the GPU, i.e., its frame_value() must have been submitted for signalling. */
+		~frame_context();
+
+		/**	Begin the next frame: Wait until the previous frame which has used the next frame slot has completed on the GPU,
+		 *	and recycle that frame slot.
+		 *	@return	The index of the frame slot of the new frame.
+		 */
+		uint32_t begin_frame();
+
+		/**	Get a command buffer from the current frame slot's command pool for the given queue family.
+		 *	It stays valid until the current frame slot is recycled. Can be called from multiple threads concurrently.
+		 */
+		command_buffer_t& get_command_buffer(uint32_t aQueueFamilyIndex, vk::CommandBufferLevel aLevel = vk::CommandBufferLevel::ePrimary);
+
+		/**	Allocate a range of the current frame slot's upload arena.
+		 *	@param	aAlignment	Alignment of the range's offset. If 0, the minimum alignment of uniform and storage buffer
+		 *						offsets is used.
+		 */
+		frame_upload_allocation allocate_upload(vk::DeviceSize aSize, vk::DeviceSize aAlignment = 0);
+
+		/**	Allocate a range of the current frame slot's upload arena and copy the given data into it. */
+		frame_upload_allocation upload(const void* aData, vk::DeviceSize aSize, vk::DeviceSize aAlignment = 0);
+
+		template <typename T>
+		frame_upload_allocation upload(const T& aData, vk::DeviceSize aAlignment = 0)
+		{
+			static_assert(std::is_trivially_copyable_v<T>);
+			return upload(&aData, sizeof(T), aAlignment);
+		}
+
+		/**	Allocate descriptor sets from the current frame slot's transient descriptor pools.
+		 *	They stay valid until the current frame slot is recycled.
+		 */
+		std::vector<vk::DescriptorSet> allocate_descriptor_sets(const std::vector<std::reference_wrapper<const descriptor_set_layout>>& aLayouts);
+
+		/**	Keep the given resource alive until the current frame has completed on the GPU. */
+		void retire(any_owning_resource_t aResource);
+
+		/**	The timeline semaphore which signals the completion of frames. */
+		const semaphore_t& timeline_semaphore() const { return mTimelineSemaphore.get(); }
+
+		/**	The value of the timeline semaphore which the current frame's last submission must signal. */
+		uint64_t frame_value() const { return mFrameValue; }
+
+		/**	The index of the current frame's frame slot. */
+		uint32_t current_frame_slot() const { return static_cast<uint32_t>((mFrameValue + mSlots.size() - 1) % mSlots.size()); }
+
+		uint32_t num_frame_slots() const { return static_cast<uint32_t>(mSlots.size()); }
+
+	private:
+		// One block of an upload arena, which stays mapped for its whole lifetime
+		struct upload_block
+		{
+			avk::buffer mBuffer;
+			std::optional<scoped_mapping<AVK_MEM_BUFFER_HANDLE>> mMapping;
+			void* mMappedMemory = nullptr;
+		};
+
+		struct frame_slot
+		{
+			// The frame which has used this slot most recently, i.e., the timeline value to wait for before recycling it:
+			uint64_t mFrameValue = 0;
+			std::vector<upload_block> mUploadBlocks;
+			size_t mCurrentUploadBlock = 0;
+			vk::DeviceSize mUploadOffset = 0;
+			std::vector<descriptor_pool> mDescriptorPools;
+			size_t mNumDescriptorPoolsInUse = 0;
+			std::vector<any_owning_resource_t> mRetiredResources;
+		};
+
+		upload_block create_upload_block(vk::DeviceSize aSize) const;
+		frame_slot& current_slot() { return mSlots[current_frame_slot()]; }
+
+		root* mRoot;
+		avk::semaphore mTimelineSemaphore;
+		command_buffer_recycler mCommandBuffers;
+		std::vector<frame_slot> mSlots;
+		uint64_t mFrameValue = 0;
+		vk::DeviceSize mUploadArenaSize;
+		vk::DeviceSize mMinUploadAlignment = 1;
+		descriptor_alloc_request mDescriptorPoolCapacity;
+	};
+}
@@ -30,4 +30,22 @@ namespace avk
 	{
 		return a = a & b;
 	}
+
+	/**	A range of bytes of mapped memory, relative to the start of a resource's memory. */
+	struct mapped_range
+	{
+		vk::DeviceSize mOffset = 0;
+		vk::DeviceSize mSize = VK_WHOLE_SIZE;
+	};
+
+	/**	Turn ranges of an allocation into ranges which can be passed to vkFlushMappedMemoryRanges or vkInvalidateMappedMemoryRanges
+	 *	with one call: They are rounded to multiples of nonCoherentAtomSize, clamped to the allocation, and overlapping or adjacent
+	 *	ones are merged.
+	 *	@param	aMemory					The memory which the allocation belongs to.
+	 *	@param	aAllocationOffset		Offset of the allocation within aMemory.
+	 *	@param	aAllocationSize			Size of the allocation.
+	 *	@param	aNonCoherentAtomSize	See VkPhysicalDeviceLimits::nonCoherentAtomSize
+	 *	@param	aRanges					The ranges, relative to the allocation.
+	 */
+	extern std::vector<vk::MappedMemoryRange> to_mapped_memory_ranges(vk::DeviceMemory aMemory, vk::DeviceSize aAllocationOffset, vk::DeviceSize aAllocationSize, vk::DeviceSize aNonCoherentAtomSize, const std::vector<mapped_range>& aRanges);
 }
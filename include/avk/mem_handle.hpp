@@ -10,7 +10,7 @@ namespace avk
 	struct mem_handle
 	{
 		/** Construct emptyness */
-		mem_handle() : mAllocator{}, mMemoryPropertyFlags{}, mMemory{nullptr}, mResource{nullptr}
+		mem_handle() : mAllocator{}, mMemoryPropertyFlags{}, mMemory{nullptr}, mResource{nullptr}, mMappedMemory{nullptr}
 		{ }
 
 		/** Initialize with VMA structs and the already created resource. */
@@ -19,6 +19,7 @@ namespace avk
 			, mMemoryPropertyFlags{}
 			, mMemory{nullptr}
 			, mResource{ std::move(aResource) }
+			, mMappedMemory{nullptr}
 		{ }
 
 		/**	Create VmaAllocator, VmaAllocationCreateInfo, and VmaAllocation internally.
@@ -28,12 +29,15 @@ namespace avk
 		mem_handle(std::tuple<vk::PhysicalDevice, vk::Device> aAllocator, vk::MemoryPropertyFlags aMemPropFlags, const C& aResourceCreateInfo);
 		
 		/** Move-construct a mem_handle */
-		mem_handle(mem_handle&& aOther) noexcept : mAllocator{}, mMemoryPropertyFlags{}, mMemory{nullptr}, mResource{nullptr}
+		mem_handle(mem_handle&& aOther) noexcept : mAllocator{}, mMemoryPropertyFlags{}, mMemory{nullptr}, mResource{nullptr}, mMappedMemory{nullptr}
 		{
 			std::swap(mAllocator,	        aOther.mAllocator);
 			std::swap(mMemoryPropertyFlags,	aOther.mMemoryPropertyFlags);
 			std::swap(mMemory,              aOther.mMemory);
 			std::swap(mResource,            aOther.mResource);
+			std::swap(mMappedMemory,        aOther.mMappedMemory);
+			std::swap(mAllocationSize,      aOther.mAllocationSize);
+			std::swap(mNonCoherentAtomSize, aOther.mNonCoherentAtomSize);
 		}
 
 		mem_handle(const mem_handle& aOther) = delete;
@@ -45,6 +49,9 @@ namespace avk
 			std::swap(mMemoryPropertyFlags,	aOther.mMemoryPropertyFlags);
 			std::swap(mMemory,              aOther.mMemory);
 			std::swap(mResource,            aOther.mResource);
+			std::swap(mMappedMemory,        aOther.mMappedMemory);
+			std::swap(mAllocationSize,      aOther.mAllocationSize);
+			std::swap(mNonCoherentAtomSize, aOther.mNonCoherentAtomSize);
 			return *this;
 		}
 
@@ -75,61 +82,84 @@ namespace avk
 		}
 
 		/**	Map the memory in order to write data into, or read data from it.
-		 *	If data shall be read from it and the memory is not host coherent, an invalidate-instruction will be issued.
+		 *	The memory is only mapped upon the first call and stays mapped until the resource is destroyed, i.e., subsequent
+		 *	calls just return the same pointer.
+		 *	If data shall be read from it and the memory is not host coherent, an invalidate-instruction will be issued for aRange.
 		 *
 		 *	Hint: Consider using avk::scoped_mapping instead of calling this method directly.
 		 *
 		 *	@param	aAccess		Specify your intent: Are you going to read from the memory, or write into it, or both?
+		 *	@param	aRange		The range which is going to be read from.
 		 *	@return	Pointer to the mapped memory.
 		 */
-		void* map_memory(mapping_access aAccess) const
+		void* map_memory(mapping_access aAccess, mapped_range aRange = {}) const
 		{
 			const auto memProps = memory_properties();
 			assert(has_flag(memProps, vk::MemoryPropertyFlagBits::eHostVisible)); // => Allocation ended up in mappable memory. You can map it and access it directly.
 			
 			auto& device = std::get<vk::Device>(mAllocator);
-			void* mappedData = device.mapMemory(mMemory, 0, VK_WHOLE_SIZE);
+			if (nullptr == mMappedMemory) {
+				mMappedMemory = device.mapMemory(mMemory, 0, VK_WHOLE_SIZE);
+			}
 
 			if (has_flag(aAccess, mapping_access::read) && !has_flag(memProps, vk::MemoryPropertyFlagBits::eHostCoherent)) {
-				// Setup the range 
-				auto range = vk::MappedMemoryRange{mMemory, 0, VK_WHOLE_SIZE};
-				// Invalidate the range
-				auto result = device.invalidateMappedMemoryRanges(1, &range);
-				assert(static_cast<VkResult>(result) >= 0);
+				invalidate({ aRange });
 			}
 			
-			return mappedData;
+			return mMappedMemory;
 		}
 
-		/**	Unmap memory that has been mapped before via mem_handle::map_memory.
-		 *	If data shall be written to it and the memory is not host coherent, a flush-instruction will be issued.
+		/**	Counterpart to mem_handle::map_memory. The memory stays mapped, s.t. it does not have to be mapped again next time.
+		 *	If data shall be written to it and the memory is not host coherent, a flush-instruction will be issued for aWrittenRanges.
 		 *
 		 *	Hint: Consider using avk::scoped_mapping instead of calling this method directly.
 		 *
-		 *	@param	aAccess		Specify your intent: Are you going to read from the memory, or write into it, or both?
+		 *	@param	aAccess			Specify your intent: Are you going to read from the memory, or write into it, or both?
+		 *	@param	aWrittenRanges	The ranges which have been written to.
 		 */
-		void unmap_memory(mapping_access aAccess) const
+		void unmap_memory(mapping_access aAccess, const std::vector<mapped_range>& aWrittenRanges = { mapped_range{} }) const
 		{
 			const auto memProps = memory_properties();
 			assert(has_flag(memProps, vk::MemoryPropertyFlagBits::eHostVisible)); // => Allocation ended up in mappable memory. You can map it and access it directly.
 			
-			auto& device = std::get<vk::Device>(mAllocator);
 			if (has_flag(aAccess, mapping_access::write) && !avk::has_flag(memProps, vk::MemoryPropertyFlagBits::eHostCoherent)) {
-				// Setup the range 
-				auto range = vk::MappedMemoryRange{mMemory, 0, VK_WHOLE_SIZE};
-				// Flush the range
-				auto result = device.flushMappedMemoryRanges(1, &range);
-				assert(static_cast<VkResult>(result) >= 0);
+				flush(aWrittenRanges);
 			}
-			
-			device.unmapMemory(mMemory);
 			// TODO: Handle has_flag(memProps, vk::MemoryPropertyFlagBits::eHostCached) case
 		}
 
+		/**	Make host writes to the given ranges available to the device with one vkFlushMappedMemoryRanges call.
+		 *	The ranges are rounded to multiples of nonCoherentAtomSize. Only required for memory which is not host coherent.
+		 */
+		void flush(const std::vector<mapped_range>& aRanges) const
+		{
+			const auto ranges = to_mapped_memory_ranges(mMemory, 0, mAllocationSize, mNonCoherentAtomSize, aRanges);
+			if (!ranges.empty()) {
+				auto result = std::get<vk::Device>(mAllocator).flushMappedMemoryRanges(static_cast<uint32_t>(ranges.size()), ranges.data());
+				assert(static_cast<VkResult>(result) >= 0);
+			}
+		}
+
+		/**	Make device writes to the given ranges visible to the host with one vkInvalidateMappedMemoryRanges call.
+		 *	The ranges are rounded to multiples of nonCoherentAtomSize. Only required for memory which is not host coherent.
+		 */
+		void invalidate(const std::vector<mapped_range>& aRanges) const
+		{
+			const auto ranges = to_mapped_memory_ranges(mMemory, 0, mAllocationSize, mNonCoherentAtomSize, aRanges);
+			if (!ranges.empty()) {
+				auto result = std::get<vk::Device>(mAllocator).invalidateMappedMemoryRanges(static_cast<uint32_t>(ranges.size()), ranges.data());
+				assert(static_cast<VkResult>(result) >= 0);
+			}
+		}
+
 		std::tuple<vk::PhysicalDevice, vk::Device> mAllocator;
 		vk::MemoryPropertyFlags mMemoryPropertyFlags;
 		vk::DeviceMemory mMemory;
 		T mResource;
+		// Set upon the first map_memory; freeing the memory unmaps it implicitly:
+		mutable void* mMappedMemory;
+		vk::DeviceSize mAllocationSize = 0;
+		vk::DeviceSize mNonCoherentAtomSize = 1;
 	};
 
 	// Fail if not used with either vk::Buffer or vk::Image
@@ -145,6 +175,7 @@ namespace avk
 	template <>
 	inline mem_handle<vk::Buffer>::mem_handle(std::tuple<vk::PhysicalDevice, vk::Device> aAllocator, vk::MemoryPropertyFlags aMemPropFlags, const vk::BufferCreateInfo& aResourceCreateInfo)
 		: mAllocator{ aAllocator }
+		, mMappedMemory{ nullptr }
 	{
 		auto& physicalDevice = std::get<vk::PhysicalDevice>(mAllocator);
 		auto& device = std::get<vk::Device>(mAllocator);
@@ -161,6 +192,10 @@ namespace avk
 		// The actual memory property flags of the selected memory can be different from the minimum requested flags (which is aMemPropFlags)
 		//  => store the ACTUAL memory property flags of this buffer!
 		mMemoryPropertyFlags = std::get<vk::MemoryPropertyFlags>(tpl);
+		mAllocationSize = memRequirements.size;
+		if (!avk::has_flag(mMemoryPropertyFlags, vk::MemoryPropertyFlagBits::eHostCoherent)) {
+			mNonCoherentAtomSize = physicalDevice.getProperties().limits.nonCoherentAtomSize;
+		}
 
 		auto allocInfo = vk::MemoryAllocateInfo{}
 			.setAllocationSize(memRequirements.size)
@@ -192,6 +227,7 @@ namespace avk
 	template <>
 	inline mem_handle<vk::Image>::mem_handle(std::tuple<vk::PhysicalDevice, vk::Device> aAllocator, vk::MemoryPropertyFlags aMemPropFlags, const vk::ImageCreateInfo& aResourceCreateInfo)
 		: mAllocator{ aAllocator }
+		, mMappedMemory{ nullptr }
 	{
 		auto& physicalDevice = std::get<vk::PhysicalDevice>(mAllocator);
 		auto& device = std::get<vk::Device>(mAllocator);
@@ -207,6 +243,10 @@ namespace avk
 		// The actual memory property flags of the selected memory can be different from the minimum requested flags (which is aMemPropFlags)
 		//  => store the ACTUAL memory property flags of this buffer!
 		mMemoryPropertyFlags = std::get<vk::MemoryPropertyFlags>(tpl);
+		mAllocationSize = memRequirements.size;
+		if (!avk::has_flag(mMemoryPropertyFlags, vk::MemoryPropertyFlagBits::eHostCoherent)) {
+			mNonCoherentAtomSize = physicalDevice.getProperties().limits.nonCoherentAtomSize;
+		}
 		
 		auto allocInfo = vk::MemoryAllocateInfo{}
 			.setAllocationSize(memRequirements.size)
@@ -237,6 +277,7 @@ namespace avk
 			mMemory = nullptr;
 			device.destroyBuffer(mResource);
 			mResource = nullptr;
+			mMappedMemory = nullptr;
 			mMemoryPropertyFlags = {};
 			mAllocator = {};
 		}
@@ -252,6 +293,7 @@ namespace avk
 			mMemory = nullptr;
 			device.destroyImage(mResource);
 			mResource = nullptr;
+			mMappedMemory = nullptr;
 			mMemoryPropertyFlags = {};
 			mAllocator = {};
 		}
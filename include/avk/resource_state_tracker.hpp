@@ -0,0 +1,113 @@
+#pragma once
+#include "avk/avk.hpp"
+
+namespace avk
+{
+	namespace sync
+	{
+		/**	The scopes which the auto_stage/auto_access parts of a sync_type_command have been resolved to.
+		 *	An empty std::optional means that no command to synchronize with could be determined. In such
+		 *	a case, a heavy fallback is employed to ensure correctness (i.e., eAllCommands for stages,
+		 *	eMemoryWrite for source accesses, and eMemoryWrite | eMemoryRead for destination accesses).
+		 */
+		struct resolved_sync_scopes
+		{
+			std::optional<vk::PipelineStageFlags2KHR> mSrcStage;
+			std::optional<vk::AccessFlags2KHR> mSrcAccess;
+			std::optional<vk::PipelineStageFlags2KHR> mDstStage;
+			std::optional<vk::AccessFlags2KHR> mDstAccess;
+
+			/**	If set, only this part of the image or buffer has actually been used by the previous commands,
+			 *	and the image memory barrier or buffer memory barrier can be restricted to it.
+			 */
+			std::optional<vk::ImageSubresourceRange> mNarrowedSubresourceRange;
+			std::optional<std::tuple<vk::DeviceSize, vk::DeviceSize>> mNarrowedOffsetAndSize;
+
+			/**	True if the barrier's range has already been covered by an earlier barrier for the same resource, no
+			 *	action_type_command at all has been recorded in between, and both barriers' destination scopes are
+			 *	resolved automatically, i.e., the barrier does not have to be recorded at all.
+			 */
+			bool mIsNoOp = false;
+		};
+
+		/**	Which commands the scopes of a barrier have been resolved w.r.t.; only recorded on request
+		 *	(see resource_state_tracker's constructor), e.g., for analyzing barriers via sync::analyze_barriers.
+		 */
+		struct scope_resolution_details
+		{
+			/** Indices of the action_type_commands which the source or destination scopes, respectively, have been resolved w.r.t. */
+			std::vector<int> mSrcCommands;
+			std::vector<int> mDstCommands;
+
+			/** Whether any of these commands lacks the relevant sync hint, s.t. the fallback has been included in the resolved scopes */
+			bool mSrcIncludesUnspecified = false;
+			bool mDstIncludesUnspecified = false;
+
+			/** The scopes which regard only the specified sync hints of these commands, i.e., without any fallbacks */
+			vk::PipelineStageFlags2KHR mSpecifiedSrcStage = {};
+			vk::AccessFlags2KHR mSpecifiedSrcAccess = {};
+			vk::PipelineStageFlags2KHR mSpecifiedDstStage = {};
+			vk::AccessFlags2KHR mSpecifiedDstAccess = {};
+		};
+
+		/**	Tracks the usage of every vk::Image and vk::Buffer handle which is referenced by the
+		 *	resource-specific sync hints of the action_type_commands of a list of recorded commands.
+		 *
+		 *	All auto_stage/auto_access parts of the sync_type_commands in that list are resolved in one
+		 *	forward pass (source scopes) and one backward pass (destination scopes) over the list, i.e.,
+		 *	looking up the scopes of a single barrier afterwards is O(1).
+		 *
+		 *	Image and buffer memory barriers are resolved w.r.t. ALL usages of their resource since the
+		 *	previous barrier (or until the next barrier, respectively) for the same resource. Thus, they
+		 *	also synchronize with commands which are not directly adjacent, regardless of the number of
+		 *	commands passed to stage::auto_stages or access::auto_accesses.
+		 *	Global barriers are resolved w.r.t. the number of nearby action_type_commands specified via
+		 *	stage::auto_stages or access::auto_accesses.
+		 *
+		 *	If resource-specific sync hints specify the affected ranges (see sync_hint::mImageSubresourceRangeAffected
+		 *	and sync_hint::mBufferOffsetSizeAffected), only usages whose ranges overlap with a barrier's range are
+		 *	regarded. Barriers with auto-stages are restricted to the ranges which have actually been used (provided
+		 *	that every preceding action_type_command has specified a sync hint for the barrier's resource), and they
+		 *	are not recorded at all if their range has been covered by an earlier barrier with no action_type_command
+		 *	in between.
+		 *
+		 *	Furthermore, the layout of each image after its most recent layout transition is tracked.
+		 */
+		class resource_state_tracker
+		{
+		public:
+			resource_state_tracker() = default;
+			/**	Resolves all the barriers of the given list of recorded commands.
+			 *	@param	aRecordResolutionDetails	If true, it is additionally recorded which commands each barrier has been resolved w.r.t.
+			 *										(see resolution_details_at). This is intended for analysis, not for recording.
+			 */
+			explicit resource_state_tracker(const std::vector<recorded_commands_t>& aRecordedCommandsAndSyncInstructions, bool aRecordResolutionDetails = false);
+			resource_state_tracker(const resource_state_tracker&) = default;
+			resource_state_tracker(resource_state_tracker&&) noexcept = default;
+			resource_state_tracker& operator=(const resource_state_tracker&) = default;
+			resource_state_tracker& operator=(resource_state_tracker&&) noexcept = default;
+			~resource_state_tracker() = default;
+
+			/**	Get the resolved scopes of the sync_type_command at the given index into the list of recorded commands.
+			 *	If the index is out of bounds (e.g., because the tracker is empty), all scopes are returned empty.
+			 */
+			const resolved_sync_scopes& scopes_at(int aRecordedStuffIndex) const;
+
+			/**	Get the details of how the scopes of the sync_type_command at the given index have been resolved.
+			 *	@return	nullptr if the index is out of bounds, or if the tracker has not been created with aRecordResolutionDetails = true.
+			 */
+			const scope_resolution_details* resolution_details_at(int aRecordedStuffIndex) const;
+
+			/**	Get the layout which the given image has been transitioned into by the last image memory
+			 *	barrier of the list of recorded commands that refers to it.
+			 *	@return	The image's layout, or an empty std::optional if no layout transition has been recorded for it.
+			 */
+			std::optional<vk::ImageLayout> last_known_layout(vk::Image aImage) const;
+
+		private:
+			std::vector<resolved_sync_scopes> mResolvedScopes;
+			std::vector<scope_resolution_details> mResolutionDetails;
+			std::unordered_map<uint64_t, vk::ImageLayout> mLastKnownLayouts;
+		};
+	}
+}
@@ -0,0 +1,74 @@
+#pragma once
+#include "avk/avk.hpp"
+
+namespace avk
+{
+	/**	Keeps resources alive until the GPU has passed a given point, and then destroys them in bulk.
+	 *
+	 *	In contrast to handle_lifetime_of of command_buffer_t, fence_t, and semaphore_t, resources which are retired into this
+	 *	queue do not depend on the lifetime of another object, i.e., command buffers, fences, and semaphores can be reused
+	 *	(or destroyed) independently of them. A point on the GPU timeline is either a value of a timeline semaphore or a fence:
+	 *
+	 *	auto token = submissionService.enqueue(recordedCmdBfr);
+	 *	retirementQueue.retire(std::move(stagingBuffer), submissionService.timeline_semaphore(), token.mTimelineValue);
+	 *	...
+	 *	// Once per frame:
+	 *	retirementQueue.release_completed();
+	 *
+	 *	Polling never blocks. The number of resources which are destroyed per call can be limited to spread destruction costs
+	 *	across multiple frames. All member functions are thread-safe.
+	 *	Timeline semaphores which are referred to must outlive the entries which refer to them. A fence must not be reset
+	 *	before the entries which refer to it have been released, otherwise they are only released upon release_all.
+	 */
+	class retirement_queue
+	{
+	public:
+		retirement_queue() = default;
+		retirement_queue(const retirement_queue&) = delete;
+		retirement_queue(retirement_queue&&) noexcept = delete;
+		retirement_queue& operator=(const retirement_queue&) = delete;
+		retirement_queue& operator=(retirement_queue&&) noexcept = delete;
+		~retirement_queue() = default;
+
+		/**	Destroy the given resource once the given timeline semaphore has reached (at least) the given value. */
+		void retire(any_owning_resource_t aResource, const semaphore_t& aTimelineSemaphore, uint64_t aValue);
+
+		/**	Destroy the given resource once the given fence has been signalled. */
+		void retire(any_owning_resource_t aResource, avk::resource_argument<avk::fence_t> aFence);
+
+		/**	Destroy all resources whose GPU work has completed, without blocking.
+		 *	@param	aMaxNumResources	If set, destroy at most this many resources; the rest is destroyed by subsequent calls.
+		 *	@return	The number of resources which have been destroyed.
+		 */
+		uint32_t release_completed(std::optional<uint32_t> aMaxNumResources = {});
+
+		/**	Destroy all resources, regardless of the GPU's progress. Only call this when the device is idle. */
+		void release_all();
+
+		/**	Number of resources which have been retired but not destroyed yet. */
+		uint32_t num_pending_resources() const;
+
+	private:
+		// All entries which wait for the same timeline semaphore, ordered by value
+		struct timeline_entries
+		{
+			const semaphore_t* mSemaphore;
+			std::map<uint64_t, std::vector<any_owning_resource_t>> mResourcesPerValue;
+		};
+
+		// All entries which wait for the same fence
+		struct fence_entries
+		{
+			avk::resource_argument<avk::fence_t> mFence;
+			std::vector<any_owning_resource_t> mResources;
+		};
+
+		// Moves up to aMaxNumResources resources from the front of aFrom to aTo and returns how many have been moved
+		static uint32_t move_front(std::vector<any_owning_resource_t>& aFrom, std::vector<any_owning_resource_t>& aTo, uint32_t aMaxNumResources);
+
+		mutable std::mutex mMutex;
+		std::vector<timeline_entries> mTimelineEntries;
+		std::vector<fence_entries> mFenceEntries;
+		uint32_t mNumPendingResources = 0;
+	};
+}
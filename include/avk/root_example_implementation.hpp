@@ -71,6 +71,9 @@ public:
 			allocatorInfo.device = device();
 			allocatorInfo.instance = vulkan_instance();
 			vmaCreateAllocator(&allocatorInfo, &mMemoryAllocator);
+#elif defined(AVK_USE_BLOCK_ALLOCATOR)
+			mBlockAllocator = std::make_unique<avk::block_allocator>(physical_device(), device());
+			mMemoryAllocator = mBlockAllocator.get();
 #else
 			mMemoryAllocator = std::make_tuple(physical_device(), device());
 #endif
@@ -126,6 +129,9 @@ private:
 	DISPATCH_LOADER_EXT_TYPE mDispatchLoaderExt;
 #if defined(AVK_USE_VMA)
 	VmaAllocator mMemoryAllocator;
+#elif defined(AVK_USE_BLOCK_ALLOCATOR)
+	std::unique_ptr<avk::block_allocator> mBlockAllocator;
+	avk::block_allocator* mMemoryAllocator = nullptr;
 #else
 	std::tuple<vk::PhysicalDevice, vk::Device> mMemoryAllocator;
 #endif
@@ -9,6 +9,9 @@ namespace avk
 	 *	is invoked under all circumstances and also that the call to ::unmap_memory
 	 *	is not forgotten since it must be ensured that for each ::map_memory call,
 	 *	also an ::unmap_memory call is issued.
+	 *	The memory handles keep their memory mapped once it has been mapped, i.e., apart from
+	 *	the first mapping, this only hands out a pointer, and ::unmap_memory only flushes
+	 *	written data if the memory is not host coherent.
 	 *
 	 *	Usage example:
 	 *
@@ -17,6 +20,10 @@ namespace avk
 	 *	// Copy 10 byte from the mapped memory (at address 'mapped.get()' to aDataPtr:
 	 *	memcpy(aDataPtr, mapped.get(), 10);
 	 *	// The destructor of 'mapped' will invoke ::unmap_memory.
+	 *
+	 *	For memory which is not host coherent, only the range which has been passed to the
+	 *	constructor is invalidated and flushed. If only parts of it are written, these can be
+	 *	reported through mark_written, s.t. only they are flushed (with one call for all of them).
 	 */
 	template <typename T>
 	class scoped_mapping
@@ -31,7 +38,22 @@ namespace avk
 			, mAccess{ aAcces }
 			, mMappedMemory{ nullptr }
 		{
-			mMappedMemory = mMemHandle->map_memory(mAccess);
+			mMappedMemory = mMemHandle->map_memory(mAccess, mRange);
+		}
+
+		/**	Invoke ::map_memory on aMemHandle, but only access the given range of it.
+		 *	@param	aAccess		In which way are you planning to access aMemHandle?
+		 *						This can be a combination of multiple flags.
+		 *	@param	aRange		The range which is going to be accessed. Note that get() still
+		 *						returns the address of the beginning of the memory.
+		 */
+		scoped_mapping(const T& aMemHandle, mapping_access aAcces, mapped_range aRange)
+			: mMemHandle{ &aMemHandle }
+			, mAccess{ aAcces }
+			, mMappedMemory{ nullptr }
+			, mRange{ aRange }
+		{
+			mMappedMemory = mMemHandle->map_memory(mAccess, mRange);
 		}
 
 		scoped_mapping(const scoped_mapping&) = delete; // Makes absolutely no sense
@@ -40,6 +62,8 @@ namespace avk
 			: mMemHandle{ aOther.mMemHandle }
 			, mAccess{ aOther.mAccess }
 			, mMappedMemory{ aOther.mMappedMemory }
+			, mRange{ aOther.mRange }
+			, mWrittenRanges{ std::move(aOther.mWrittenRanges) }
 		{
 			aOther.mMemHandle = nullptr;
 			aOther.mMappedMemory = nullptr;
@@ -52,9 +76,12 @@ namespace avk
 			mMemHandle = aOther.mMemHandle;
 			mAccess = aOther.mAccess;
 			mMappedMemory = aOther.mMappedMemory;
+			mRange = aOther.mRange;
+			mWrittenRanges = std::move(aOther.mWrittenRanges);
 			
 			aOther.mMemHandle = nullptr;
 			aOther.mMappedMemory = nullptr;
+			return *this;
 		}
 
 		/**	Get the memory address of the mapped memory.
@@ -65,12 +92,25 @@ namespace avk
 			return mMappedMemory;
 		}
 
+		/**	Report that the given range has been written to. If any ranges have been reported,
+		 *	only these are flushed upon destruction instead of the whole mapped range.
+		 */
+		void mark_written(vk::DeviceSize aOffset, vk::DeviceSize aSize)
+		{
+			mWrittenRanges.push_back(mapped_range{ aOffset, aSize });
+		}
+
 		/**	The destructor will invoke ::map_memory on the resource.
 		 */
 		~scoped_mapping()
 		{
 			if (nullptr != mMemHandle) {
-				mMemHandle->unmap_memory(mAccess);
+				if (mWrittenRanges.empty()) {
+					mMemHandle->unmap_memory(mAccess, { mRange });
+				}
+				else {
+					mMemHandle->unmap_memory(mAccess, mWrittenRanges);
+				}
 				mMemHandle = nullptr;
 			}
 		}
@@ -79,5 +119,7 @@ namespace avk
 		const T* mMemHandle;
 		mapping_access mAccess;
 		void* mMappedMemory;
+		mapped_range mRange;
+		std::vector<mapped_range> mWrittenRanges;
 	};
 }
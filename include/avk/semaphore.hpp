@@ -6,10 +6,15 @@ namespace avk
 	// Forward declaration:
 	class queue;
 
-	/** A synchronization object which allows GPU->GPU synchronization */
+	/** A synchronization object which allows GPU->GPU synchronization.
+	 *	It is either a binary semaphore (see root::create_semaphore) or a timeline semaphore (see root::create_timeline_semaphore).
+	 *	A timeline semaphore holds a monotonically increasing 64-bit counter value, which can be waited on and signalled by
+	 *	submissions (see submission_data::waiting_for and submission_data::signaling_upon_completion) as well as from the host.
+	 */
 	class semaphore_t
 	{
 		friend class root;
+		friend class semaphore_pool;
 		
 	public:
 		semaphore_t();
@@ -48,9 +53,37 @@ namespace avk
 		const auto& handle() const { return mSemaphore.get(); }
 		const auto* handle_addr() const { return &mSemaphore.get(); }
 
+		/** The config struct which determines the semaphore's type and the initial value of a timeline semaphore */
+		const auto& type_create_info() const	{ return mTypeCreateInfo; }
+		auto& type_create_info()				{ return mTypeCreateInfo; }
+
+		/** True if this is a timeline semaphore, false if it is a binary semaphore */
+		bool is_timeline_semaphore() const { return vk::SemaphoreType::eTimeline == mTypeCreateInfo.semaphoreType; }
+
+		/**	Query the current counter value of this timeline semaphore from the host.
+		 *	Must only be used with timeline semaphores.
+		 */
+		uint64_t current_value() const;
+
+		/**	Wait on the host until the counter value of this timeline semaphore has reached (at least) the given value.
+		 *	Must only be used with timeline semaphores.
+		 *	@param	aValue		The value to wait for.
+		 *	@param	aTimeout	Timeout in nanoseconds. If not set, wait indefinitely.
+		 *	@return	true if the value has been reached, false if the timeout has expired before.
+		 */
+		bool wait_until_signalled(uint64_t aValue, std::optional<uint64_t> aTimeout = {}) const;
+
+		/**	Set the counter value of this timeline semaphore from the host. The value must be greater than the
+		 *	current value and it must be smaller than the values of all pending signal operations.
+		 *	Must only be used with timeline semaphores.
+		 */
+		void signal(uint64_t aValue) const;
+
 	private:
 		// The semaphore config struct:
 		vk::SemaphoreCreateInfo mCreateInfo;
+		// The semaphore type config struct, which is chained to mCreateInfo during creation:
+		vk::SemaphoreTypeCreateInfo mTypeCreateInfo;
 		// The semaphore handle:
 		vk::UniqueHandle<vk::Semaphore, DISPATCH_LOADER_CORE_TYPE> mSemaphore;
 
@@ -58,6 +91,9 @@ namespace avk
 		std::optional<avk::unique_function<void()>> mCustomDeleter;
 
 		std::vector<any_owning_resource_t> mLifetimeHandledResources;
+
+		/** If set, the semaphore handle is handed over to this function upon destruction instead of being destroyed (see semaphore_pool) */
+		std::optional<avk::unique_function<void(vk::UniqueHandle<vk::Semaphore, DISPATCH_LOADER_CORE_TYPE>&&)>> mReturnHandleTo;
 	};
 
 	// Typedef for a variable representing an owner of a semaphore
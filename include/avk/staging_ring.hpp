@@ -0,0 +1,80 @@
+#pragma once
+#include "avk/avk.hpp"
+
+namespace avk
+{
+	/**	A range of a staging_ring, which is mapped persistently and can be written to on the host.
+	 *	The range returns to the ring once the last copy of mLease has been destroyed. Therefore, a copy of the
+	 *	allocation must be kept alive until the GPU has finished reading from the range, e.g., by moving it into
+	 *	the command buffer which reads from it (see staging_ring::release_upon_reuse_of).
+	 */
+	struct staging_ring_allocation
+	{
+		vk::Buffer mBuffer;
+		vk::DeviceSize mOffset = 0;
+		vk::DeviceSize mSize = 0;
+		void* mMappedMemory = nullptr;
+		std::shared_ptr<void> mLease;
+	};
+
+	/**	A staging buffer in host-visible memory, which stays mapped for its whole lifetime and is sub-allocated in a
+	 *	ring-like fashion. It replaces the creation of a dedicated staging buffer per upload: If root::upload_staging_ring
+	 *	provides a ring, buffer_t::fill copies the data of device-local buffers into a range of it.
+	 *
+	 *	Ranges are allocated at the head of the ring and are reclaimed at its tail. Ranges may be released in a different
+	 *	order than they have been allocated in; the tail only advances over ranges which have been released. allocate never
+	 *	blocks: If a request is larger than the ring, or if the ring is full, no range is returned and the caller is
+	 *	expected to fall back to a dedicated staging buffer.
+	 *
+	 *	The ring's memory stays alive until all of its allocations have been released, i.e., command buffers which still
+	 *	refer to ranges of the ring may outlive it. All member functions are thread-safe.
+	 */
+	class staging_ring
+	{
+	public:
+		/**	@param	aRoot	The root which the ring's buffer is created through.
+		 *	@param	aSize	Size of the ring in bytes.
+		 */
+		staging_ring(const root* aRoot, vk::DeviceSize aSize);
+		staging_ring(const staging_ring&) = delete;
+		staging_ring(staging_ring&&) noexcept = delete;
+		staging_ring& operator=(const staging_ring&) = delete;
+		staging_ring& operator=(staging_ring&&) noexcept = delete;
+		~staging_ring() = default;
+
+		/**	Allocate a range at the ring's head.
+		 *	@param	aAlignment	Alignment of the range's offset, which does not have to be a power of two. The default is sufficient
+		 *						for copies to buffers. For copies to images, the offset must be a multiple of the texel block size
+		 *						of the image's format (e.g., 12 for R32G32B32 formats), and of 4 for depth/stencil formats; the
+		 *						caller has to pass such a value, since the default does not cover all formats.
+		 *	@return	The range, or no value if it is larger than the ring or if there is not enough free space at the moment.
+		 */
+		std::optional<staging_ring_allocation> allocate(vk::DeviceSize aSize, vk::DeviceSize aAlignment = 16);
+
+		/**	Make host writes to the given range available to the device. Only does something if the ring's memory
+		 *	is not host coherent.
+		 */
+		void flush(const staging_ring_allocation& aAllocation) const;
+
+		/**	Release the given range once the given command buffer is reset, reused, or destroyed, i.e., after the GPU has
+		 *	finished executing it.
+		 */
+		static void release_upon_reuse_of(command_buffer_t& aCommandBuffer, staging_ring_allocation aAllocation);
+
+		/**	Size of the ring in bytes. */
+		vk::DeviceSize size() const;
+
+		/**	Number of bytes between the ring's tail and head, i.e., including ranges which have been released already,
+		 *	but can not be reclaimed yet because ranges before them are still in use.
+		 */
+		vk::DeviceSize size_in_use() const;
+
+	private:
+		// The ring's buffer and bookkeeping, which is kept alive by all leases of allocations
+		struct ring_state;
+		// Releases one range of the ring when destroyed
+		struct region_lease;
+
+		std::shared_ptr<ring_state> mState;
+	};
+}
@@ -0,0 +1,84 @@
+#pragma once
+#include "avk/avk.hpp"
+
+namespace avk
+{
+	/**	Collects multiple submissions to the same queue and submits them with one single call to vkQueueSubmit2,
+	 *	with one vk::SubmitInfo2 per submission, to pay the driver's submission overhead only once:
+	 *
+	 *	avk::submission_batcher batcher{ &root, queue };
+	 *	batcher.add(queue.submit(cmdBfrA).signaling_upon_completion(stage::transfer >> semA).store_for_now());
+	 *	batcher.add(queue.submit(cmdBfrB).waiting_for(semA >> stage::compute_shader).store_for_now());
+	 *	batcher.add(queue.submit(cmdBfrC).signaling_upon_completion(frameFence).store_for_now()); // <-- flushes
+	 *
+	 *	All semaphore waits and signals are kept per submission, i.e., the batch behaves exactly like the individual submissions
+	 *	in the order they have been added. A batch is flushed
+	 *	 - explicitly via flush(),
+	 *	 - when a submission which signals a fence is added (vkQueueSubmit2 takes only one fence for all submit infos),
+	 *	 - when add() or flush_if_due() is invoked after the batching window (if any) has elapsed since the first pending submission,
+	 *	 - or upon destruction of the batcher.
+	 *	Be aware that nothing is submitted before the batch is flushed, i.e., do not wait on the host for semaphores which are
+	 *	signalled by pending submissions.
+	 */
+	class submission_batcher
+	{
+	public:
+		/**	Create a batcher for the given queue.
+		 *	@param	aRoot				The root which the submissions are made through.
+		 *	@param	aQueue				The queue to submit to. All added submissions must either target this queue or no queue at all.
+		 *	@param	aBatchingWindow		If set, a pending batch is flushed by add() or flush_if_due() once this amount of time has
+		 *								passed since its first submission has been added. If not set, batches are only flushed explicitly,
+		 *								by fences, or by the destructor.
+		 */
+		submission_batcher(const root* aRoot, const queue& aQueue, std::optional<std::chrono::nanoseconds> aBatchingWindow = {});
+		submission_batcher(const submission_batcher&) = delete;
+		submission_batcher(submission_batcher&&) noexcept = default;
+		submission_batcher& operator=(const submission_batcher&) = delete;
+		submission_batcher& operator=(submission_batcher&&) noexcept = default;
+		~submission_batcher() noexcept(false);
+
+		/**	Add a submission to the pending batch. Semaphore stages are resolved immediately.
+		 *	The submission_data (and the resources it might own, like its command buffer) are kept alive until the batch has been flushed.
+		 *	Use submission_data::store_for_now to pass a submission which is configured in-place.
+		 */
+		submission_batcher& add(submission_data aSubmission);
+
+		/**	Submit all pending submissions with one call to vkQueueSubmit2. Does nothing if there are no pending submissions. */
+		void flush();
+
+		/**	Flush the pending submissions if the batching window has elapsed.
+		 *	@return	true if a flush has happened.
+		 */
+		bool flush_if_due();
+
+		/**	Number of submissions which have been added but not flushed yet. */
+		uint32_t num_pending_submissions() const { return static_cast<uint32_t>(mSubmissions.size()); }
+
+		/**	Number of calls to vkQueueSubmit2 this batcher has issued so far. */
+		uint32_t num_flushes() const { return mNumFlushes; }
+
+		const auto& target_queue() const { return *mQueue; }
+
+	private:
+		// Which entries of mWaitInfos and mSignalInfos belong to one submission
+		struct submission_range
+		{
+			uint32_t mFirstWait = 0;
+			uint32_t mNumWaits = 0;
+			uint32_t mFirstSignal = 0;
+			uint32_t mNumSignals = 0;
+		};
+
+		const root* mRoot = nullptr;
+		const queue* mQueue = nullptr;
+		std::optional<std::chrono::nanoseconds> mBatchingWindow;
+		std::chrono::steady_clock::time_point mBatchStart;
+		uint32_t mNumFlushes = 0;
+
+		std::vector<submission_data> mSubmissions;
+		std::vector<submission_range> mRanges;
+		std::vector<vk::SemaphoreSubmitInfoKHR> mWaitInfos;
+		std::vector<vk::SemaphoreSubmitInfoKHR> mSignalInfos;
+		std::vector<vk::CommandBufferSubmitInfoKHR> mCommandBufferInfos;
+	};
+}
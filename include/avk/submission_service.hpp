@@ -0,0 +1,116 @@
+#pragma once
+#include "avk/avk.hpp"
+
+namespace avk
+{
+	/**	Identifies one submission which has been enqueued into a submission_service.
+	 */
+	struct submission_token
+	{
+		/** The service's timeline semaphore reaches this value once the submission has completed on the GPU */
+		uint64_t mTimelineValue = 0;
+	};
+
+	/**	Serializes all submissions to one queue through a dedicated submit thread, s.t. multiple recording threads
+	 *	can submit without taking a lock around vkQueueSubmit2 (which requires external synchronization of the queue).
+	 *
+	 *	Enqueueing is lock-free: Submissions are pushed onto a multi-producer single-consumer list, which the submit thread
+	 *	drains entirely whenever it wakes up, and everything it has drained is submitted with as few calls to vkQueueSubmit2
+	 *	as possible. Every submission additionally signals the service's timeline semaphore with a unique, monotonically
+	 *	increasing value, which is returned to the caller as a submission_token:
+	 *
+	 *	auto token = service.enqueue(recordedCmdBfr);
+	 *	...
+	 *	service.wait_until_complete(token);
+	 *	// or, on another queue: submission.waiting_for(service.timeline_semaphore(), token.mTimelineValue, stage::compute_shader)
+	 *
+	 *	The enqueued submission_data (and the resources it might own, like its command buffer) are kept alive by the
+	 *	service until the GPU has completed them. They are released by the submit thread, which keeps polling for completed
+	 *	submissions while it has nothing to submit.
+	 *	If other code (e.g., presentation) has to use the same queue, it must do so via with_exclusive_queue_access.
+	 */
+	class submission_service
+	{
+	public:
+		/**	Create a submission service for the given queue and start its submit thread.
+		 *	Requires the timelineSemaphore device feature to be enabled.
+		 *	@param	aIdlePollIntervalNs		While there is nothing to submit, but submissions are still in flight, the submit thread
+		 *									waits at most this long for the oldest one to complete before it checks for new work again.
+		 */
+		submission_service(const root* aRoot, const queue& aQueue, uint64_t aIdlePollIntervalNs = 1000000);
+		submission_service(const submission_service&) = delete;
+		submission_service(submission_service&&) noexcept = delete;
+		submission_service& operator=(const submission_service&) = delete;
+		submission_service& operator=(submission_service&&) noexcept = delete;
+		/**	Submits everything which has been enqueued, waits until the GPU has completed it, and stops the submit thread. */
+		~submission_service();
+
+		/**	Enqueue a submission. This can be called from any thread and never blocks on the queue.
+		 *	Semaphore stages are resolved on the calling thread, i.e., the recorded commands which a submission refers to
+		 *	only have to stay alive during this call. The submission_data must either target this service's queue or no
+		 *	queue at all. Use submission_data::store_for_now to pass a submission which is configured in-place.
+		 *	@return	A token which can be used to find out when the submission has completed.
+		 */
+		submission_token enqueue(submission_data aSubmission);
+
+		/**	Enqueue a recorded command buffer, without any additional semaphores or fences. */
+		submission_token enqueue(recorded_command_buffer& aRecordedCommandBuffer);
+
+		/**	True if the submission which the token refers to has completed on the GPU. Does not block. */
+		bool is_complete(submission_token aToken) const;
+
+		/**	Wait on the host until the submission which the token refers to has completed on the GPU.
+		 *	@param	aTimeout	Timeout in nanoseconds. If not set, wait indefinitely.
+		 *	@return	true if the submission has completed, false if the timeout has expired before.
+		 */
+		bool wait_until_complete(submission_token aToken, std::optional<uint64_t> aTimeout = {}) const;
+
+		/**	Wait on the host until all submissions which have been enqueued so far have completed on the GPU. */
+		void wait_idle() const;
+
+		/**	The timeline semaphore which is signalled by every submission with the value of its submission_token. */
+		const semaphore_t& timeline_semaphore() const { return mTimelineSemaphore.get(); }
+
+		/**	Invoke the given function with the queue, while no submission is made by the submit thread. */
+		template <typename F>
+		decltype(auto) with_exclusive_queue_access(F&& aFunction)
+		{
+			std::scoped_lock lock{ mQueueMutex };
+			return std::forward<F>(aFunction)(*mQueue);
+		}
+
+		/**	Number of calls to vkQueueSubmit2 which the submit thread has issued so far. */
+		uint32_t num_submit_calls() const { return mNumSubmitCalls.load(std::memory_order_relaxed); }
+
+	private:
+		// One enqueued submission, with its semaphore infos already resolved
+		struct pending_submission
+		{
+			submission_data mSubmission;
+			std::vector<vk::SemaphoreSubmitInfoKHR> mWaitInfos;
+			std::vector<vk::SemaphoreSubmitInfoKHR> mSignalInfos;
+			vk::CommandBufferSubmitInfoKHR mCommandBufferInfo;
+			uint64_t mTimelineValue = 0;
+			pending_submission* mNext = nullptr;
+		};
+
+		void submit_thread_loop();
+		void submit_in_order(std::vector<std::unique_ptr<pending_submission>>& aReadySubmissions);
+
+		const root* mRoot = nullptr;
+		const queue* mQueue = nullptr;
+		uint64_t mIdlePollIntervalNs;
+		avk::semaphore mTimelineSemaphore;
+		std::mutex mQueueMutex;
+
+		// Lock-free list of enqueued submissions, which the submit thread takes as a whole:
+		std::atomic<pending_submission*> mEnqueued{ nullptr };
+		// Incremented after every enqueue, s.t. the submit thread can sleep until something has been enqueued:
+		std::atomic<uint64_t> mWakeUpCounter{ 0 };
+		std::atomic<uint64_t> mLastTimelineValue{ 0 };
+		std::atomic<bool> mStopRequested{ false };
+		std::atomic<uint32_t> mNumSubmitCalls{ 0 };
+
+		std::thread mSubmitThread;
+	};
+}
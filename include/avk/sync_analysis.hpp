@@ -0,0 +1,93 @@
+#pragma once
+#include "avk/avk.hpp"
+
+namespace avk
+{
+	namespace sync
+	{
+		enum struct analyzed_barrier_type
+		{
+			global_execution_barrier,
+			global_memory_barrier,
+			image_memory_barrier,
+			buffer_memory_barrier,
+			ill_formed
+		};
+
+		/**	The analysis of one barrier of a list of recorded commands (see analyze_barriers).
+		 */
+		struct barrier_analysis
+		{
+			/** Index of the barrier into the list of recorded commands. For barriers within nested commands, the path contains
+			 *	the index of the action_type_command in the top-level list first, followed by the indices into the nested lists. */
+			std::vector<int> mPath;
+			analyzed_barrier_type mType;
+			/** Set if the barrier is one half of a split barrier */
+			std::optional<split_barrier_half> mSplitBarrierHalf;
+			/** True if the barrier is not recorded at all because it is covered by an earlier barrier */
+			bool mIsNoOp = false;
+
+			/** The stages and accesses which the barrier is recorded with */
+			vk::PipelineStageFlags2KHR mSrcStage = {};
+			vk::AccessFlags2KHR mSrcAccess = {};
+			vk::PipelineStageFlags2KHR mDstStage = {};
+			vk::AccessFlags2KHR mDstAccess = {};
+
+			/** Whether the heavy fallback (eAllCommands, eMemoryWrite | eMemoryRead) has been used for an auto_stage/auto_access part,
+			 *	either because no command to synchronize with could be determined, or because such a command lacks its sync hint. */
+			bool mSrcStageFallback = false;
+			bool mSrcAccessFallback = false;
+			bool mDstStageFallback = false;
+			bool mDstAccessFallback = false;
+
+			/** Indices (into the same list as the barrier) of the action_type_commands which the source and destination scopes have been resolved w.r.t. */
+			std::vector<int> mSrcCommandsScanned;
+			std::vector<int> mDstCommandsScanned;
+
+			/** Estimate of the tightest barrier which would still synchronize with the scanned commands, based on their specified sync hints.
+			 *	Fixed (i.e., not auto_stage/auto_access) parts of global barriers are taken as they are. */
+			vk::PipelineStageFlags2KHR mTightSrcStage = {};
+			vk::AccessFlags2KHR mTightSrcAccess = {};
+			vk::PipelineStageFlags2KHR mTightDstStage = {};
+			vk::AccessFlags2KHR mTightDstAccess = {};
+
+			[[nodiscard]] bool uses_fallback() const { return mSrcStageFallback || mSrcAccessFallback || mDstStageFallback || mDstAccessFallback; }
+
+			/** True if the barrier is recorded with (at least partly) wider scopes than the tight estimate */
+			[[nodiscard]] bool is_over_synchronized() const
+			{
+				return !mIsNoOp && (
+					   static_cast<bool>(mSrcStage  & ~mTightSrcStage)
+					|| static_cast<bool>(mSrcAccess & ~mTightSrcAccess)
+					|| static_cast<bool>(mDstStage  & ~mTightDstStage)
+					|| static_cast<bool>(mDstAccess & ~mTightDstAccess)
+				);
+			}
+		};
+
+		/**	The result of analyze_barriers: One entry per barrier, in recording order.
+		 */
+		struct barrier_analysis_report
+		{
+			std::vector<barrier_analysis> mBarriers;
+
+			[[nodiscard]] uint32_t num_barriers() const { return static_cast<uint32_t>(mBarriers.size()); }
+			[[nodiscard]] uint32_t num_no_op_barriers() const;
+			[[nodiscard]] uint32_t num_barriers_using_fallback() const;
+			[[nodiscard]] uint32_t num_over_synchronized_barriers() const;
+
+			/**	Serializes the report into a JSON object, which contains the counts and the analysis of every barrier.
+			 *	Stages and accesses are written as strings like "{ ComputeShader | Transfer }".
+			 */
+			[[nodiscard]] std::string to_json() const;
+		};
+
+		/**	Analyzes how the barriers of the given list of recorded commands (including nested commands) are resolved, without recording
+		 *	anything, i.e., no device is required. This is intended to find barriers which hit the heavy fallback or which are wider than
+		 *	necessary, and to track that over time (e.g., by storing barrier_analysis_report::to_json in benchmarks).
+		 */
+		extern barrier_analysis_report analyze_barriers(const std::vector<recorded_commands_t>& aRecordedCommandsAndSyncInstructions);
+	}
+
+	extern std::string to_string(sync::analyzed_barrier_type aValue);
+}
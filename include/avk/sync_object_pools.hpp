@@ -0,0 +1,134 @@
+#pragma once
+#include "avk/avk.hpp"
+
+namespace avk
+{
+	/**	Hit and miss statistics of a fence_pool or a semaphore_pool. */
+	struct sync_object_pool_statistics
+	{
+		/** Number of acquisitions which have been served with a recycled object */
+		uint32_t mNumHits = 0;
+		/** Number of acquisitions which required creating a new object */
+		uint32_t mNumMisses = 0;
+		/** Number of objects which have been returned to the pool */
+		uint32_t mNumReturned = 0;
+		/** Number of objects which are currently available in the pool */
+		uint32_t mNumAvailable = 0;
+	};
+
+	/**	Hands out unsignalled fences, and takes them back automatically when the fence (i.e., the last owner of the
+	 *	owning_resource) is destroyed, instead of destroying the Vulkan object. The fence is reset when it is returned.
+	 *	Just like when destroying a fence, all submissions which refer to it must have completed before it is returned.
+	 *	Fences which are returned after the pool has been destroyed are destroyed. All member functions are thread-safe.
+	 */
+	class fence_pool
+	{
+	public:
+		/**	@param	aRoot				The root which the fences are created through.
+		 *	@param	aNumPreallocated	Number of fences to create right away.
+		 */
+		fence_pool(const root* aRoot, uint32_t aNumPreallocated = 0);
+		fence_pool(const fence_pool&) = delete;
+		fence_pool(fence_pool&&) noexcept = default;
+		fence_pool& operator=(const fence_pool&) = delete;
+		fence_pool& operator=(fence_pool&&) noexcept = default;
+		~fence_pool() = default;
+
+		/**	Get an unsignalled fence, which is either recycled or newly created. */
+		fence acquire();
+
+		sync_object_pool_statistics statistics() const;
+
+	private:
+		// Shared with the fences which have been handed out, s.t. they can return to the pool as long as it exists
+		struct shared_state
+		{
+			std::mutex mMutex;
+			std::vector<vk::UniqueHandle<vk::Fence, DISPATCH_LOADER_CORE_TYPE>> mAvailable;
+			std::atomic<uint32_t> mNumHits{ 0 };
+			std::atomic<uint32_t> mNumMisses{ 0 };
+			std::atomic<uint32_t> mNumReturned{ 0 };
+		};
+
+		const root* mRoot;
+		std::shared_ptr<shared_state> mState;
+	};
+
+	/**	Hands out binary semaphores, and takes them back automatically when the semaphore (i.e., the last owner of the
+	 *	owning_resource) is destroyed, instead of destroying the Vulkan object.
+	 *	Just like when destroying a semaphore, it must not have any pending operations when it is returned. Furthermore, it must
+	 *	be unsignalled, i.e., every signal operation must have been waited upon. Semaphores which are returned after the pool
+	 *	has been destroyed are destroyed. All member functions are thread-safe.
+	 */
+	class semaphore_pool
+	{
+	public:
+		/**	@param	aRoot				The root which the semaphores are created through.
+		 *	@param	aNumPreallocated	Number of semaphores to create right away.
+		 */
+		semaphore_pool(const root* aRoot, uint32_t aNumPreallocated = 0);
+		semaphore_pool(const semaphore_pool&) = delete;
+		semaphore_pool(semaphore_pool&&) noexcept = default;
+		semaphore_pool& operator=(const semaphore_pool&) = delete;
+		semaphore_pool& operator=(semaphore_pool&&) noexcept = default;
+		~semaphore_pool() = default;
+
+		/**	Get an unsignalled binary semaphore, which is either recycled or newly created. */
+		semaphore acquire();
+
+		sync_object_pool_statistics statistics() const;
+
+	private:
+		// Shared with the semaphores which have been handed out, s.t. they can return to the pool as long as it exists
+		struct shared_state
+		{
+			std::mutex mMutex;
+			std::vector<vk::UniqueHandle<vk::Semaphore, DISPATCH_LOADER_CORE_TYPE>> mAvailable;
+			std::atomic<uint32_t> mNumHits{ 0 };
+			std::atomic<uint32_t> mNumMisses{ 0 };
+			std::atomic<uint32_t> mNumReturned{ 0 };
+		};
+
+		const root* mRoot;
+		std::shared_ptr<shared_state> mState;
+	};
+
+	/**	Hands out unsignaled events, e.g., for split barriers (see recorded_commands::split_barriers), and takes them back
+	 *	automatically when the event (i.e., the last owner of the owning_resource) is destroyed, instead of destroying the
+	 *	Vulkan object. The event is reset when it is returned.
+	 *	Just like when destroying an event, all submissions which refer to it must have completed before it is returned.
+	 *	Events which are returned after the pool has been destroyed are destroyed. All member functions are thread-safe.
+	 */
+	class event_pool
+	{
+	public:
+		/**	@param	aRoot				The root which the events are created through.
+		 *	@param	aNumPreallocated	Number of events to create right away.
+		 */
+		event_pool(const root* aRoot, uint32_t aNumPreallocated = 0);
+		event_pool(const event_pool&) = delete;
+		event_pool(event_pool&&) noexcept = default;
+		event_pool& operator=(const event_pool&) = delete;
+		event_pool& operator=(event_pool&&) noexcept = default;
+		~event_pool() = default;
+
+		/**	Get an unsignaled event, which is either recycled or newly created. */
+		event acquire();
+
+		sync_object_pool_statistics statistics() const;
+
+	private:
+		// Shared with the events which have been handed out, s.t. they can return to the pool as long as it exists
+		struct shared_state
+		{
+			std::mutex mMutex;
+			std::vector<vk::UniqueHandle<vk::Event, DISPATCH_LOADER_CORE_TYPE>> mAvailable;
+			std::atomic<uint32_t> mNumHits{ 0 };
+			std::atomic<uint32_t> mNumMisses{ 0 };
+			std::atomic<uint32_t> mNumReturned{ 0 };
+		};
+
+		const root* mRoot;
+		std::shared_ptr<shared_state> mState;
+	};
+}
@@ -0,0 +1,142 @@
+#pragma once
+#include "avk/avk.hpp"
+
+namespace avk
+{
+	/**	Collects many uploads into device-local buffers and images, and records them with as few commands as possible.
+	 *
+	 *	In contrast to buffer_t::fill and copy_buffer_to_image, which create one staging buffer, one copy command with one
+	 *	region, and one sync hint per upload, the data of all uploads is packed into one persistently mapped staging buffer
+	 *	(as long as it fits into the staging block size), and record emits
+	 *	 - one vkCmdCopyBuffer per destination buffer, which contains the regions of all uploads into that buffer,
+	 *	 - one vkCmdCopyBufferToImage per destination image and layout, which contains the regions of all uploads into that image,
+	 *	 - one global memory barrier after all of them.
+	 *
+	 *	avk::upload_batcher uploads{ &root };
+	 *	for (auto& mesh : meshes) {
+	 *		uploads.fill(mesh.mVertexBuffer.get(), mesh.mVertices.data(), mesh.mVertices.size() * sizeof(vertex));
+	 *		uploads.fill(mesh.mIndexBuffer.get(), mesh.mIndices.data(), mesh.mIndices.size() * sizeof(uint32_t));
+	 *	}
+	 *	uploads.upload_to_image(texture.get(), pixels.data(), pixels.size(), avk::layout::transfer_dst);
+	 *	root.record(uploads.record(avk::stage::vertex_attribute_input | avk::stage::fragment_shader, avk::access::vertex_attribute_read | avk::access::shader_read))
+	 *		.into_command_buffer(cmdBfr)
+	 *		.then_submit_to(queue)
+	 *		.submit();
+	 *
+	 *	The data is copied into the staging buffer immediately, i.e., it does not have to stay alive until record is invoked.
+	 *	Images must be in the given layout when the recorded commands are executed. The staging buffers are kept alive by the
+	 *	command buffer which the commands are recorded into. Once it is reused or destroyed (and the recorded commands are gone),
+	 *	staging buffers of the staging block size return to the batcher and are used for subsequent uploads.
+	 *
+	 *	Uploads are executed in the order in which they have been added: If the destination range of an upload overlaps the one
+	 *	of an earlier upload since the last invocation of record (for images: the same aspect, layer, and mip level), the copies
+	 *	are split at that point, and a transfer->transfer barrier is recorded in between, s.t. the later upload wins.
+	 *	The member functions must not be used from multiple threads concurrently.
+	 */
+	class upload_batcher
+	{
+	public:
+		/**	@param	aRoot				The root which the staging buffers are created through.
+		 *	@param	aStagingBlockSize	Size of the staging buffers. If the uploads between two invocations of record do not fit
+		 *								into one of them, further staging buffers (of at least this size) are used. Only
+		 *								staging buffers of exactly this size are reused.
+		 */
+		upload_batcher(const root* aRoot, vk::DeviceSize aStagingBlockSize = 16 * 1024 * 1024);
+		upload_batcher(const upload_batcher&) = delete;
+		upload_batcher(upload_batcher&&) noexcept = default;
+		upload_batcher& operator=(const upload_batcher&) = delete;
+		upload_batcher& operator=(upload_batcher&&) noexcept = default;
+		~upload_batcher() = default;
+
+		/**	Add an upload of the given data into the given range of a buffer. */
+		upload_batcher& fill(const buffer_t& aDstBuffer, const void* aData, vk::DeviceSize aSize, vk::DeviceSize aDstOffset = 0);
+
+		/**	Add an upload of the given, tightly packed data into one layer of one mip level of an image.
+		 *	@param	aDstImageLayout		The layout which the image is in when the copy is executed.
+		 *	@param	aAlignment			Alignment of the data within the staging buffer. Must be a multiple of 4 and of the
+		 *								size of one texel block of the image's format.
+		 */
+		upload_batcher& upload_to_image(const image_t& aDstImage, const void* aData, vk::DeviceSize aSize, avk::layout::image_layout aDstImageLayout, uint32_t aDstLayer = 0, uint32_t aDstLevel = 0, vk::ImageAspectFlags aImageAspectFlags = vk::ImageAspectFlagBits::eColor, vk::DeviceSize aAlignment = 16);
+
+		/**	Get the commands which perform all uploads that have been added since the last invocation, followed by one
+		 *	global memory barrier from the copies to the given stages and accesses. Afterwards, the batcher is empty.
+		 */
+		std::vector<recorded_commands_t> record(avk::stage::pipeline_stage_flags aDstStages = avk::stage::auto_stage, avk::access::memory_access_flags aDstAccesses = avk::access::auto_access);
+
+		/**	True if no uploads have been added since the last invocation of record. */
+		bool empty() const { return mBufferCopies.empty() && mImageCopies.empty(); }
+
+		/**	Number of bytes which have been staged since the last invocation of record, including alignment padding. */
+		vk::DeviceSize staged_size() const;
+
+	private:
+		// One staging buffer, which stays mapped for its whole lifetime
+		struct staging_block
+		{
+			avk::buffer mBuffer;
+			std::byte* mMappedMemory = nullptr;
+			vk::DeviceSize mOffset = 0;
+		};
+
+		// All regions which are copied from one staging block into one buffer, none of which overlap
+		struct buffer_copies
+		{
+			vk::Buffer mDstBuffer;
+			size_t mStagingBlock;
+			uint32_t mPhase;
+			std::vector<vk::BufferCopy> mRegions;
+		};
+
+		// All regions which are copied from one staging block into one image in one layout, none of which overlap
+		struct image_copies
+		{
+			vk::Image mDstImage;
+			vk::ImageLayout mDstLayout;
+			size_t mStagingBlock;
+			uint32_t mPhase;
+			std::vector<vk::BufferImageCopy> mRegions;
+		};
+
+		// Staging blocks whose recorded batches are gone, shared with the batches which return them
+		struct recycled_blocks
+		{
+			std::mutex mMutex;
+			std::vector<staging_block> mAvailable;
+		};
+
+		// Everything which the recorded commands refer to, shared by all copies of the recording function and the command buffer
+		struct recorded_batch
+		{
+			recorded_batch() = default;
+			recorded_batch(const recorded_batch&) = delete;
+			recorded_batch(recorded_batch&&) noexcept = delete;
+			recorded_batch& operator=(const recorded_batch&) = delete;
+			recorded_batch& operator=(recorded_batch&&) noexcept = delete;
+			// Returns the staging blocks of the default size to the batcher, if it still exists
+			~recorded_batch();
+
+			std::vector<staging_block> mStagingBlocks;
+			std::vector<buffer_copies> mBufferCopies;
+			std::vector<image_copies> mImageCopies;
+			vk::DeviceSize mRecyclableBlockSize = 0;
+			std::weak_ptr<recycled_blocks> mReturnBlocksTo;
+		};
+
+		// Copy the data into a staging block and return that block's index and the data's offset within it
+		std::tuple<size_t, vk::DeviceSize> stage(const void* aData, vk::DeviceSize aSize, vk::DeviceSize aAlignment);
+
+		const root* mRoot;
+		vk::DeviceSize mStagingBlockSize;
+		std::shared_ptr<recycled_blocks> mRecycledBlocks;
+		std::vector<staging_block> mStagingBlocks;
+		std::vector<buffer_copies> mBufferCopies;
+		std::vector<image_copies> mImageCopies;
+		// The most recent entries of mBufferCopies and mImageCopies per destination:
+		std::unordered_map<VkBuffer, size_t> mBufferCopiesIndex;
+		std::unordered_map<VkImage, size_t> mImageCopiesIndex;
+		// Uploads of different phases are separated by a barrier. What has been written in the current phase, per destination:
+		uint32_t mPhase = 0;
+		std::unordered_map<VkBuffer, std::map<vk::DeviceSize, vk::DeviceSize>> mBufferRangesInPhase;
+		std::unordered_map<VkImage, std::vector<vk::ImageSubresourceLayers>> mImageSubresourcesInPhase;
+	};
+}
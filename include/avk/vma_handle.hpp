@@ -10,7 +10,7 @@ namespace avk
 	struct vma_handle
 	{
 		/** Construct emptyness */
-		vma_handle() : mAllocator{nullptr}, mCreateInfo{}, mAllocation{nullptr}, mAllocationInfo{}, mResource{nullptr}
+		vma_handle() : mAllocator{nullptr}, mCreateInfo{}, mAllocation{nullptr}, mAllocationInfo{}, mResource{nullptr}, mMappedMemory{nullptr}
 		{ }
 
 		/** Initialize with VMA structs and the already created resource. */
@@ -21,6 +21,7 @@ namespace avk
 			, mResource{ std::move(aResource) }
 		{
 			vmaGetAllocationInfo(mAllocator, mAllocation, &mAllocationInfo);
+			mMappedMemory = mAllocationInfo.pMappedData;
 		}
 
 		/**	Create VmaAllocator, VmaAllocationCreateInfo, and VmaAllocation internally.
@@ -30,13 +31,14 @@ namespace avk
 		vma_handle(VmaAllocator aAllocator, vk::MemoryPropertyFlags aMemPropFlags, const C& aResourceCreateInfo);
 		
 		/** Move-construct a vma_handle */
-		vma_handle(vma_handle&& aOther) noexcept : mAllocator{nullptr}, mCreateInfo{}, mAllocation{nullptr}, mAllocationInfo{}, mResource{nullptr}
+		vma_handle(vma_handle&& aOther) noexcept : mAllocator{nullptr}, mCreateInfo{}, mAllocation{nullptr}, mAllocationInfo{}, mResource{nullptr}, mMappedMemory{nullptr}
 		{
 			std::swap(mAllocator,      aOther.mAllocator);
 			std::swap(mCreateInfo,     aOther.mCreateInfo);
 			std::swap(mAllocation,     aOther.mAllocation);
 			std::swap(mAllocationInfo, aOther.mAllocationInfo);
 			std::swap(mResource,       aOther.mResource);
+			std::swap(mMappedMemory,   aOther.mMappedMemory);
 		}
 
 		vma_handle(const vma_handle& aOther) = delete;
@@ -49,6 +51,7 @@ namespace avk
 			std::swap(mAllocation,     aOther.mAllocation);
 			std::swap(mAllocationInfo, aOther.mAllocationInfo);
 			std::swap(mResource,       aOther.mResource);
+			std::swap(mMappedMemory,   aOther.mMappedMemory);
 			return *this;
 		}
 
@@ -93,48 +96,79 @@ namespace avk
 		}
 
 		/**	Map the memory in order to write data into, or read data from it.
-		 *	If data shall be read from it and the memory is not host coherent, an invalidate-instruction will be issued.
+		 *	Allocations which have been requested with host visible memory are mapped persistently upon creation. Others are
+		 *	mapped upon the first call and stay mapped until the resource is destroyed, i.e., subsequent calls just return the same pointer.
+		 *	If data shall be read from it and the memory is not host coherent, an invalidate-instruction will be issued for aRange.
 		 *
 		 *	Hint: Consider using avk::scoped_mapping instead of calling this method directly.
 		 *
 		 *	@param	aAccess		Specify your intent: Are you going to read from the memory, or write into it, or both?
+		 *	@param	aRange		The range which is going to be read from.
 		 *	@return	Pointer to the mapped memory.
 		 */
-		void* map_memory(mapping_access aAccess) const
+		void* map_memory(mapping_access aAccess, mapped_range aRange = {}) const
 		{
 			const auto memProps = memory_properties();
 			assert(has_flag(memProps, vk::MemoryPropertyFlagBits::eHostVisible)); // => Allocation ended up in mappable memory. You can map it and access it directly.
 
-			void* mappedData;
-		    auto result = vmaMapMemory(mAllocator, mAllocation, &mappedData);
-			assert(result >= 0);
+			if (nullptr == mMappedMemory) {
+				auto result = vmaMapMemory(mAllocator, mAllocation, &mMappedMemory);
+				assert(result >= 0);
+			}
 			
 			if (has_flag(aAccess, mapping_access::read) && !has_flag(memProps, vk::MemoryPropertyFlagBits::eHostCoherent)) {
-				result = vmaInvalidateAllocation(mAllocator, mAllocation, 0, VK_WHOLE_SIZE);
-				assert(result >= 0);
+				invalidate({ aRange });
 			}
 			
-			return mappedData;
+			return mMappedMemory;
 		}
 
-		/**	Unmap memory that has been mapped before via mem_handle::map_memory.
-		 *	If data shall be written to it and the memory is not host coherent, a flush-instruction will be issued.
+		/**	Counterpart to vma_handle::map_memory. The memory stays mapped, s.t. it does not have to be mapped again next time.
+		 *	If data shall be written to it and the memory is not host coherent, a flush-instruction will be issued for aWrittenRanges.
 		 *
 		 *	Hint: Consider using avk::scoped_mapping instead of calling this method directly.
 		 *
-		 *	@param	aAccess		Specify your intent: Are you going to read from the memory, or write into it, or both?
+		 *	@param	aAccess			Specify your intent: Are you going to read from the memory, or write into it, or both?
+		 *	@param	aWrittenRanges	The ranges which have been written to.
 		 */
-		void unmap_memory(mapping_access aAccess) const
+		void unmap_memory(mapping_access aAccess, const std::vector<mapped_range>& aWrittenRanges = { mapped_range{} }) const
 		{
 			const auto memProps = memory_properties();
 			assert(has_flag(memProps, vk::MemoryPropertyFlagBits::eHostVisible)); // => Allocation ended up in mappable memory. You can map it and access it directly.
 
 			if (has_flag(aAccess, mapping_access::write) && !has_flag(memProps, vk::MemoryPropertyFlagBits::eHostCoherent)) {
-				VkResult result = vmaFlushAllocation(mAllocator, mAllocation, 0, VK_WHOLE_SIZE);
-				assert(result >= 0);
+				flush(aWrittenRanges);
 			}
-			
-		    vmaUnmapMemory(mAllocator, mAllocation);
+		}
+
+		/**	Make host writes to the given ranges available to the device with one vmaFlushAllocations call,
+		 *	which rounds them to multiples of nonCoherentAtomSize. Only required for memory which is not host coherent.
+		 */
+		void flush(const std::vector<mapped_range>& aRanges) const
+		{
+			const std::vector<VmaAllocation> allocations(aRanges.size(), mAllocation);
+			std::vector<VkDeviceSize> offsets, sizes;
+			for (const auto& range : aRanges) {
+				offsets.push_back(range.mOffset);
+				sizes.push_back(range.mSize);
+			}
+			VkResult result = vmaFlushAllocations(mAllocator, static_cast<uint32_t>(aRanges.size()), allocations.data(), offsets.data(), sizes.data());
+			assert(result >= 0);
+		}
+
+		/**	Make device writes to the given ranges visible to the host with one vmaInvalidateAllocations call,
+		 *	which rounds them to multiples of nonCoherentAtomSize. Only required for memory which is not host coherent.
+		 */
+		void invalidate(const std::vector<mapped_range>& aRanges) const
+		{
+			const std::vector<VmaAllocation> allocations(aRanges.size(), mAllocation);
+			std::vector<VkDeviceSize> offsets, sizes;
+			for (const auto& range : aRanges) {
+				offsets.push_back(range.mOffset);
+				sizes.push_back(range.mSize);
+			}
+			VkResult result = vmaInvalidateAllocations(mAllocator, static_cast<uint32_t>(aRanges.size()), allocations.data(), offsets.data(), sizes.data());
+			assert(result >= 0);
 		}
 
 		VmaAllocator mAllocator;
@@ -142,6 +176,8 @@ namespace avk
 		VmaAllocation mAllocation;
 		VmaAllocationInfo mAllocationInfo;
 		T mResource;
+		// Either the persistent mapping of the allocation (mAllocationInfo.pMappedData), or set upon the first map_memory:
+		mutable void* mMappedMemory;
 	};
 
 	// Fail if not used with either vk::Buffer or vk::Image
@@ -157,15 +193,19 @@ namespace avk
 	template <>
 	inline vma_handle<vk::Buffer>::vma_handle(VmaAllocator aAllocator, vk::MemoryPropertyFlags aMemPropFlags, const vk::BufferCreateInfo& aResourceCreateInfo)
 		: mAllocator{ aAllocator }
-		, mCreateInfo{}, mAllocation{nullptr}, mAllocationInfo{}
+		, mCreateInfo{}, mAllocation{nullptr}, mAllocationInfo{}, mMappedMemory{nullptr}
 	{
 		mCreateInfo.requiredFlags = static_cast<VkMemoryPropertyFlags>(aMemPropFlags);
 		mCreateInfo.usage = VMA_MEMORY_USAGE_UNKNOWN;
+		if (has_flag(aMemPropFlags, vk::MemoryPropertyFlagBits::eHostVisible)) {
+			mCreateInfo.flags |= VMA_ALLOCATION_CREATE_MAPPED_BIT;
+		}
 
 		VkBuffer buffer;
 		auto result = vmaCreateBuffer(aAllocator, &static_cast<const VkBufferCreateInfo&>(aResourceCreateInfo), &mCreateInfo, &buffer, &mAllocation, &mAllocationInfo);
 		assert(result >= 0);
 		mResource = buffer;
+		mMappedMemory = mAllocationInfo.pMappedData;
 	}
 	
 	// Constructor's template specialization for vk::Image
@@ -173,15 +213,19 @@ namespace avk
 	template <>
 	inline vma_handle<vk::Image>::vma_handle(VmaAllocator aAllocator, vk::MemoryPropertyFlags aMemPropFlags, const vk::ImageCreateInfo& aResourceCreateInfo)
 		: mAllocator{ aAllocator }
-		, mCreateInfo{}, mAllocation{nullptr}, mAllocationInfo{}
+		, mCreateInfo{}, mAllocation{nullptr}, mAllocationInfo{}, mMappedMemory{nullptr}
 	{
 		mCreateInfo.requiredFlags = static_cast<VkMemoryPropertyFlags>(aMemPropFlags);
 		mCreateInfo.usage = VMA_MEMORY_USAGE_UNKNOWN;
+		if (has_flag(aMemPropFlags, vk::MemoryPropertyFlagBits::eHostVisible)) {
+			mCreateInfo.flags |= VMA_ALLOCATION_CREATE_MAPPED_BIT;
+		}
 
 		VkImage image;
 		auto result = vmaCreateImage(aAllocator, &static_cast<const VkImageCreateInfo&>(aResourceCreateInfo), &mCreateInfo, &image, &mAllocation, &mAllocationInfo);
 		assert(result >= 0);
 		mResource = image;
+		mMappedMemory = mAllocationInfo.pMappedData;
 	}
 	
 	// Fail if not used with either vk::Buffer or vk::Image
@@ -196,12 +240,16 @@ namespace avk
 	inline vma_handle<vk::Buffer>::~vma_handle()
 	{
 		if (static_cast<bool>(mResource)) {
+			if (nullptr != mMappedMemory && mMappedMemory != mAllocationInfo.pMappedData) {
+				vmaUnmapMemory(mAllocator, mAllocation); // It has been mapped by map_memory
+			}
 			vmaDestroyBuffer(mAllocator, static_cast<VkBuffer>(mResource), mAllocation);
 			mAllocator = nullptr;
 			mCreateInfo = {};
 			mAllocation = nullptr;
 			mAllocationInfo = {};
 			mResource = nullptr;
+			mMappedMemory = nullptr;
 		}
 	}
 
@@ -210,12 +258,16 @@ namespace avk
 	inline vma_handle<vk::Image>::~vma_handle()
 	{
 		if (static_cast<bool>(mResource)) {
+			if (nullptr != mMappedMemory && mMappedMemory != mAllocationInfo.pMappedData) {
+				vmaUnmapMemory(mAllocator, mAllocation); // It has been mapped by map_memory
+			}
 			vmaDestroyImage(mAllocator, static_cast<VkImage>(mResource), mAllocation);
 			mAllocator = nullptr;
 			mCreateInfo = {};
 			mAllocation = nullptr;
 			mAllocationInfo = {};
 			mResource = nullptr;
+			mMappedMemory = nullptr;
 		}
 	}
 
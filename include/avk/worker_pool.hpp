@@ -0,0 +1,46 @@
+#pragma once
+#include "avk/avk.hpp"
+
+namespace avk
+{
+	/**	A fixed set of long-lived threads which execute batches of jobs, e.g., for recording secondary command buffers
+	 *	in parallel (see parallel_recording_config). Creating the threads once avoids starting and joining new ones
+	 *	for every batch.
+	 */
+	class worker_pool
+	{
+	public:
+		/**	Create a worker pool and start its threads.
+		 *	@param	aNumThreads		Number of threads. The thread which calls run participates in executing jobs, too.
+		 */
+		explicit worker_pool(uint32_t aNumThreads);
+		worker_pool(const worker_pool&) = delete;
+		worker_pool(worker_pool&&) noexcept = delete;
+		worker_pool& operator=(const worker_pool&) = delete;
+		worker_pool& operator=(worker_pool&&) noexcept = delete;
+		/**	Waits until all jobs have been executed and joins the threads. */
+		~worker_pool();
+
+		/**	Invokes aJob for every index in [0, aNumJobs) and returns after all of them have finished.
+		 *	Every index is processed exactly once, by the calling thread or by one of the pool's threads.
+		 *	If any job throws, the exception of the job with the lowest index is rethrown after all of them have finished.
+		 *	Can be called from multiple threads concurrently, and also from within a job.
+		 */
+		void run(uint32_t aNumJobs, const std::function<void(uint32_t)>& aJob);
+
+		uint32_t num_threads() const { return static_cast<uint32_t>(mThreads.size()); }
+
+		/**	A pool with one thread per hardware thread (minus one for the calling thread), which is created on first use
+		 *	and lives until the end of the program. */
+		static worker_pool& shared();
+
+	private:
+		void worker_loop();
+
+		std::mutex mMutex;
+		std::condition_variable mCondition;
+		std::deque<avk::unique_function<void()>> mJobs;
+		bool mStopRequested = false;
+		std::vector<std::thread> mThreads;
+	};
+}
@@ -183,6 +183,44 @@ namespace avk
 		throw avk::runtime_error("failed to find suitable memory type!");
 	}
 
+	std::vector<vk::MappedMemoryRange> to_mapped_memory_ranges(vk::DeviceMemory aMemory, vk::DeviceSize aAllocationOffset, vk::DeviceSize aAllocationSize, vk::DeviceSize aNonCoherentAtomSize, const std::vector<mapped_range>& aRanges)
+	{
+		const auto atom = std::max(aNonCoherentAtomSize, vk::DeviceSize{ 1 });
+		const auto allocationEnd = aAllocationOffset + aAllocationSize;
+
+		// [begin, end) in terms of aMemory, rounded outwards to whole atoms, but not beyond the allocation:
+		std::vector<std::tuple<vk::DeviceSize, vk::DeviceSize>> spans;
+		spans.reserve(aRanges.size());
+		for (const auto& range : aRanges) {
+			if (range.mOffset >= aAllocationSize || 0 == range.mSize) {
+				continue;
+			}
+			const auto size = VK_WHOLE_SIZE == range.mSize ? aAllocationSize - range.mOffset : std::min(range.mSize, aAllocationSize - range.mOffset);
+			const auto begin = (aAllocationOffset + range.mOffset) / atom * atom;
+			const auto end = std::min((aAllocationOffset + range.mOffset + size + atom - 1) / atom * atom, allocationEnd);
+			spans.emplace_back(begin, end);
+		}
+		std::sort(std::begin(spans), std::end(spans));
+
+		std::vector<vk::MappedMemoryRange> result;
+		for (const auto& [begin, end] : spans) {
+			if (!result.empty() && begin <= result.back().offset + result.back().size) {
+				result.back().size = std::max(result.back().size, end - result.back().offset);
+			}
+			else {
+				result.push_back(vk::MappedMemoryRange{ aMemory, begin, end - begin });
+			}
+		}
+		// A size which is not a multiple of the atom size is only valid if the range extends to the end of the memory,
+		// which is the case if it has been clamped to the end of the allocation:
+		for (auto& range : result) {
+			if (0 != range.size % atom) {
+				range.size = VK_WHOLE_SIZE;
+			}
+		}
+		return result;
+	}
+
 	bool is_srgb_format(const vk::Format& aImageFormat)
 	{
 		// Note: Currently, the compressed formats are ignored => could/should be added in the future, maybe
@@ -2571,6 +2609,8 @@ namespace avk
 					stage::none + access::none, // No need to wait on anything nor to make anything available
 					// Set defaults for the host-visible-only case, overwrite them for device buffers further down:
 					stage::none + access::none, // <-- This is okay for host-visible buffers, because the queue submit transfers the memory
+					{},
+					std::make_tuple(dstOffset, dataSize) // Only the filled range is affected
 				})
 			}
 		};
@@ -2584,7 +2624,7 @@ namespace avk
 
 		// #1: Is our memory accessible from the CPU-SIDE?
 		if (avk::has_flag(memProps, vk::MemoryPropertyFlagBits::eHostVisible)) {
-			auto mapped = scoped_mapping{mBuffer, mapping_access::write};
+			auto mapped = scoped_mapping{mBuffer, mapping_access::write, mapped_range{ dstOffset, dataSize }}; // Only flush what is written
 			// Memcpy doesn't have to wait on anything, no sync required.
 			memcpy(static_cast<uint8_t *>(mapped.get()) + dstOffset, aDataPtr, dataSize);
 			// Since this is a host-write, no need for any barrier, because of implicit host write guarantee.
@@ -2602,6 +2642,34 @@ namespace avk
 			// If dataSize is zero, skip staging buffer creation and the copy command, but still
 			// process the synchronization calls, as user code may rely on those.
 
+			// Whatever comes after must synchronize with the device-local copy:
+			std::get<avk::sync::sync_hint>(actionTypeCommand.mResourceSpecificSyncHints.front()).mSrcForSubsequentCmds = stage::copy + access::transfer_write;
+			actionTypeCommand.infer_sync_hint_from_resource_sync_hints();
+
+			// Prefer a range of the root's staging ring over a dedicated staging buffer. The ring can not be used if the
+			// root does not provide one, if the data is larger than the ring, or if the ring is full at the moment:
+			auto* stagingRing = mRoot->upload_staging_ring();
+			auto ringAllocation = nullptr != stagingRing ? stagingRing->allocate(dataSize) : std::optional<staging_ring_allocation>{};
+			if (ringAllocation.has_value()) {
+				memcpy(ringAllocation->mMappedMemory, aDataPtr, dataSize);
+				stagingRing->flush(*ringAllocation);
+
+				actionTypeCommand.mBeginFun = [
+					lRoot = mRoot,
+					lRingAllocation = std::move(ringAllocation.value()),
+					lDstBufferHandle = handle(),
+					dstOffset, dataSize
+				](avk::command_buffer_t& cb) {
+					const auto copyRegion = vk::BufferCopy{ lRingAllocation.mOffset, dstOffset, dataSize };
+					cb.handle().copyBuffer(lRingAllocation.mBuffer, lDstBufferHandle, 1u, &copyRegion, lRoot->dispatch_loader_core());
+
+					// The range of the ring might still be in use when this method returns => return it to the ring once the command buffer has completed:
+					staging_ring::release_upon_reuse_of(cb, lRingAllocation);
+				};
+
+				return actionTypeCommand;
+			}
+
 			auto stagingBuffer = root::create_buffer(
 				*mRoot,
 				AVK_STAGING_BUFFER_MEMORY_USAGE,
@@ -2611,10 +2679,6 @@ namespace avk
 			stagingBuffer.enable_shared_ownership(); // TODO: Why does it not work WITHOUT shared_ownership? (Fails when assigning it to mBeginFun)
 			stagingBuffer->fill(aDataPtr, 0); // Recurse into the other if-branch
 
-			// Whatever comes after must synchronize with the device-local copy:
-			std::get<avk::sync::sync_hint>(actionTypeCommand.mResourceSpecificSyncHints.front()).mSrcForSubsequentCmds = stage::copy + access::transfer_write;
-			actionTypeCommand.infer_sync_hint_from_resource_sync_hints();
-						
 			actionTypeCommand.mBeginFun = [
 				lRoot = mRoot,
 				lOwnedStagingBuffer = std::move(stagingBuffer),
@@ -2626,7 +2690,7 @@ namespace avk
 				//cb.handle().copyBuffer2KHR(&copyBufferInfo);
 				// TODO: No idea why copyBuffer2KHR fails with an access violation
 
-				const auto copyRegion = vk::BufferCopy{ 0u, 0u, dataSize };
+				const auto copyRegion = vk::BufferCopy{ 0u, dstOffset, dataSize };
 				cb.handle().copyBuffer(lOwnedStagingBuffer->handle(), lDstBufferHandle, 1u, &copyRegion, lRoot->dispatch_loader_core());
 
 				// Take care of the lifetime handling of the stagingBuffer, it might still be in use when this method returns:
@@ -2699,7 +2763,7 @@ namespace avk
 
 		// #1: Is our memory accessible on the CPU-SIDE?
 		if (avk::has_flag(memProps, vk::MemoryPropertyFlagBits::eHostVisible)) {
-			auto mapped = scoped_mapping{mBuffer, mapping_access::read};
+			auto mapped = scoped_mapping{mBuffer, mapping_access::read, mapped_range{ 0, bufferSize }}; // Only invalidate what is read
 			memcpy(aDataPtr, mapped.get(), bufferSize);
 			return {};
 		}
@@ -2760,6 +2824,28 @@ namespace avk
 	}
 #pragma endregion
 
+#pragma region baked parameters definitions
+	baked_parameters root::create_baked_parameters(vk::DeviceSize aSizeInBytes)
+	{
+		baked_parameters_t result;
+		const auto size = static_cast<size_t>(aSizeInBytes);
+		result.mBuffer = create_buffer(
+			memory_usage::host_coherent, {},
+			uniform_buffer_meta::create_from_size(size),
+			storage_buffer_meta::create_from_size(size),
+			indirect_buffer_meta::create_from_size(size)
+		);
+		// The mapping refers to the buffer's memory handle => its address must remain stable when the block is moved:
+		result.mBuffer.enable_shared_ownership();
+		result.mMapping.emplace(result.mBuffer->memory_handle(), mapping_access::write | mapping_access::read);
+		result.mMappedMemory = result.mMapping->get();
+
+		const auto& limits = physical_device().getProperties().limits;
+		result.mMinAlignment = std::max({ limits.minUniformBufferOffsetAlignment, limits.minStorageBufferOffsetAlignment, vk::DeviceSize{ 1 } });
+		return result;
+	}
+#pragma endregion
+
 #pragma region buffer view definitions
 	vk::Buffer buffer_view_t::buffer_handle() const
 	{
@@ -2852,6 +2938,11 @@ namespace avk
 		return result;
 	}
 
+	void command_pool_t::reset(vk::CommandPoolResetFlags aFlags)
+	{
+		mCommandPool->getOwner().resetCommandPool(handle(), aFlags, mRoot->dispatch_loader_core());
+	}
+
 	// prepare command buffer for re-recording
 	void command_buffer_t::prepare_for_reuse()
 	{
@@ -2865,6 +2956,7 @@ namespace avk
 			mCustomDeleter.reset();
 		}
 		mLifetimeHandledResources.clear();
+		mKeptAliveObjects.clear();
 	}
 
 	void command_buffer_t::reset()
@@ -2893,6 +2985,12 @@ namespace avk
 		return *this;
 	}
 
+	command_buffer_t& command_buffer_t::keep_alive_until_reuse(std::shared_ptr<void> aObject)
+	{
+		mKeptAliveObjects.push_back(std::move(aObject));
+		return *this;
+	}
+
 	void command_buffer_t::invoke_post_execution_handler() const
 	{
 		if (mPostExecutionHandler.has_value() && *mPostExecutionHandler) {
@@ -2906,6 +3004,14 @@ namespace avk
 		mState = command_buffer_state::recording;
 	}
 
+	void command_buffer_t::begin_recording(const vk::CommandBufferInheritanceInfo& aInheritanceInfo)
+	{
+		auto beginInfo = mBeginInfo;
+		beginInfo.setPInheritanceInfo(&aInheritanceInfo);
+		mCommandBuffer->begin(beginInfo);
+		mState = command_buffer_state::recording;
+	}
+
 	void command_buffer_t::end_recording()
 	{
 		mCommandBuffer->end();
@@ -3931,6 +4037,45 @@ namespace avk
 
 #pragma endregion
 
+#pragma region event definitions
+	event_t::~event_t()
+	{
+		if (mReturnHandleTo.has_value() && *mReturnHandleTo && mEvent) {
+			// Hand the handle back to the pool it came from instead of destroying it:
+			(*mReturnHandleTo)(std::move(mEvent));
+		}
+	}
+
+	bool event_t::is_set() const
+	{
+		return vk::Result::eEventSet == mEvent.getOwner().getEventStatus(handle());
+	}
+
+	void event_t::reset()
+	{
+		mEvent.getOwner().resetEvent(handle());
+	}
+
+	event root::create_event(vk::Device aDevice, const DISPATCH_LOADER_CORE_TYPE& aDispatchLoader, std::function<void(event_t&)> aAlterConfigBeforeCreation)
+	{
+		event_t result;
+		result.mCreateInfo = vk::EventCreateInfo{};
+
+		// Maybe alter the config?
+		if (aAlterConfigBeforeCreation) {
+			aAlterConfigBeforeCreation(result);
+		}
+
+		result.mEvent = aDevice.createEventUnique(result.mCreateInfo, nullptr, aDispatchLoader);
+		return result;
+	}
+
+	event root::create_event(std::function<void(event_t&)> aAlterConfigBeforeCreation)
+	{
+		return create_event(device(), dispatch_loader_core(), std::move(aAlterConfigBeforeCreation));
+	}
+#pragma endregion
+
 #pragma region fence definitions
 	fence_t::~fence_t()
 	{
@@ -3939,6 +4084,10 @@ namespace avk
 			(*mCustomDeleter)();
 			mCustomDeleter.reset();
 		}
+		if (mReturnHandleTo.has_value() && *mReturnHandleTo && mFence) {
+			// Hand the handle back to the pool it came from instead of destroying it:
+			(*mReturnHandleTo)(std::move(mFence));
+		}
 		// Destroy the dependant instance before destroying myself
 		// ^ This is ensured by the order of the members
 		//   See: https://isocpp.org/wiki/faq/dtors#calling-member-dtors
@@ -3957,6 +4106,11 @@ namespace avk
 		assert(static_cast<VkResult>(result) >= 0);
 	}
 
+	bool fence_t::is_signalled() const
+	{
+		return vk::Result::eSuccess == mFence.getOwner().getFenceStatus(handle());
+	}
+
 	void fence_t::reset()
 	{
 		// ReSharper disable once CppExpressionWithoutSideEffects
@@ -7093,6 +7247,7 @@ namespace avk
 #pragma region semaphore definitions
 	semaphore_t::semaphore_t()
 		: mCreateInfo{}
+		, mTypeCreateInfo{}
 		, mSemaphore{}
 		, mCustomDeleter{}
 	{
@@ -7105,6 +7260,10 @@ namespace avk
 			(*mCustomDeleter)();
 			mCustomDeleter.reset();
 		}
+		if (mReturnHandleTo.has_value() && *mReturnHandleTo && mSemaphore) {
+			// Hand the handle back to the pool it came from instead of destroying it:
+			(*mReturnHandleTo)(std::move(mSemaphore));
+		}
 		// Destroy the dependant instance before destroying myself
 		// ^ This is ensured by the order of the members
 		//   See: https://isocpp.org/wiki/faq/dtors#calling-member-dtors
@@ -7129,6 +7288,61 @@ namespace avk
 		return create_semaphore(device(), dispatch_loader_core(), std::move(aAlterConfigBeforeCreation));
 	}
 
+	semaphore root::create_timeline_semaphore(vk::Device aDevice, const DISPATCH_LOADER_CORE_TYPE& aDispatchLoader, uint64_t aInitialValue, std::function<void(semaphore_t&)> aAlterConfigBeforeCreation)
+	{
+		semaphore_t result;
+		result.mCreateInfo = vk::SemaphoreCreateInfo{};
+		result.mTypeCreateInfo = vk::SemaphoreTypeCreateInfo{}
+			.setSemaphoreType(vk::SemaphoreType::eTimeline)
+			.setInitialValue(aInitialValue);
+
+		// Maybe alter the config?
+		if (aAlterConfigBeforeCreation) {
+			aAlterConfigBeforeCreation(result);
+		}
+
+		// Chain the type info only for the creation, s.t. no dangling pointer remains after result has been moved:
+		auto* const nextOfCreateInfo = result.mCreateInfo.pNext;
+		result.mTypeCreateInfo.pNext = nextOfCreateInfo;
+		result.mCreateInfo.pNext = &result.mTypeCreateInfo;
+		result.mSemaphore = aDevice.createSemaphoreUnique(result.mCreateInfo, nullptr, aDispatchLoader);
+		result.mCreateInfo.pNext = nextOfCreateInfo;
+		result.mTypeCreateInfo.pNext = nullptr;
+		return result;
+	}
+
+	semaphore root::create_timeline_semaphore(uint64_t aInitialValue, std::function<void(semaphore_t&)> aAlterConfigBeforeCreation)
+	{
+		return create_timeline_semaphore(device(), dispatch_loader_core(), aInitialValue, std::move(aAlterConfigBeforeCreation));
+	}
+
+	uint64_t semaphore_t::current_value() const
+	{
+		assert(is_timeline_semaphore());
+		return mSemaphore.getOwner().getSemaphoreCounterValue(handle(), mSemaphore.getDispatch());
+	}
+
+	bool semaphore_t::wait_until_signalled(uint64_t aValue, std::optional<uint64_t> aTimeout) const
+	{
+		assert(is_timeline_semaphore());
+		const auto waitInfo = vk::SemaphoreWaitInfo{}
+			.setSemaphoreCount(1u)
+			.setPSemaphores(handle_addr())
+			.setPValues(&aValue);
+		auto result = mSemaphore.getOwner().waitSemaphores(waitInfo, aTimeout.value_or(UINT64_MAX), mSemaphore.getDispatch());
+		assert(static_cast<VkResult>(result) >= 0);
+		return vk::Result::eSuccess == result;
+	}
+
+	void semaphore_t::signal(uint64_t aValue) const
+	{
+		assert(is_timeline_semaphore());
+		const auto signalInfo = vk::SemaphoreSignalInfo{}
+			.setSemaphore(handle())
+			.setValue(aValue);
+		mSemaphore.getOwner().signalSemaphore(signalInfo, mSemaphore.getDispatch());
+	}
+
 	semaphore_t& semaphore_t::handle_lifetime_of(any_owning_resource_t aResource)
 	{
 		mLifetimeHandledResources.push_back(std::move(aResource));
@@ -7334,7 +7548,8 @@ namespace avk
 			{}, // Define a resource-specific sync hint here and let the general sync hint be inferred afterwards (because it is supposed to be exactly the same)
 			{
 				std::make_tuple(aSrcBuffer->handle(), avk::sync::sync_hint{ stage::copy + access::transfer_read,  stage::copy + access::none           }),
-				std::make_tuple(aDstImage->handle(),  avk::sync::sync_hint{ stage::copy + access::transfer_write, stage::copy + access::transfer_write })
+				std::make_tuple(aDstImage->handle(),  avk::sync::sync_hint{ stage::copy + access::transfer_write, stage::copy + access::transfer_write,
+					vk::ImageSubresourceRange{ aImageAspectFlags, aDstLevel, 1u, aDstLayer, 1u } })
 			},
 			[
 				lRoot = aSrcBuffer->root_ptr(),
@@ -7404,31 +7619,39 @@ namespace avk
 		}
 #endif
 
-		auto actionTypeCommand = avk::command::action_type_command{
-			{}, // Define a resource-specific sync hint here and let the general sync hint be inferred afterwards (because it is supposed to be exactly the same)
-			{
-				std::make_tuple(aSrcBuffer->handle(), avk::sync::sync_hint{ stage::copy + access::transfer_read , stage::copy + access::none           }),
-				std::make_tuple(aDstBuffer->handle(), avk::sync::sync_hint{ stage::copy + access::transfer_write, stage::copy + access::transfer_write })
-			},
-			[
+		auto fun = [
 				lRoot = aSrcBuffer->root_ptr(),
 				lSrcHandle = aSrcBuffer->handle(),
 				lDstHandle = aDstBuffer->handle(),
 				lSrcOffset = aSrcOffset.value_or(0),
 				lDstOffset = aDstOffset.value_or(0),
 				dataSize
-			](avk::command_buffer_t& cb) {
+			](auto& aTarget) {
 				const vk::BufferCopy region {
 					lSrcOffset, lDstOffset, dataSize
 				};
-				cb.handle().copyBuffer(
-					lSrcHandle, 
-					lDstHandle,
-					1u, &region, 
-					lRoot->dispatch_loader_core()
-				);
-			}
+				if constexpr (avk::command::is_lowering_target_v<decltype(aTarget)>) {
+					aTarget = avk::command::lowered::copy_buffer{ lSrcHandle, lDstHandle, region };
+				}
+				else {
+					aTarget.handle().copyBuffer(
+						lSrcHandle, 
+						lDstHandle,
+						1u, &region, 
+						lRoot->dispatch_loader_core()
+					);
+				}
+			};
+
+		auto actionTypeCommand = avk::command::action_type_command{
+			{}, // Define a resource-specific sync hint here and let the general sync hint be inferred afterwards (because it is supposed to be exactly the same)
+			{
+				std::make_tuple(aSrcBuffer->handle(), avk::sync::sync_hint{ stage::copy + access::transfer_read , stage::copy + access::none           , {}, std::make_tuple(aSrcOffset.value_or(0), dataSize) }),
+				std::make_tuple(aDstBuffer->handle(), avk::sync::sync_hint{ stage::copy + access::transfer_write, stage::copy + access::transfer_write, {}, std::make_tuple(aDstOffset.value_or(0), dataSize) })
+			},
+			fun
 		};
+		actionTypeCommand.mLower = &avk::command::lower_recording_function<decltype(fun)>;
 
 		if (aSrcBuffer.is_ownership() || aDstBuffer.is_ownership()) {
 			actionTypeCommand.mEndFun = [
@@ -7455,7 +7678,8 @@ namespace avk
 		auto actionTypeCommand = avk::command::action_type_command{
 			{}, // Define a resource-specific sync hint here and let the general sync hint be inferred afterwards (because it is supposed to be exactly the same)
 			{
-				std::make_tuple(aSrcImage->handle() , avk::sync::sync_hint{ stage::copy + access::transfer_read , stage::copy + access::none           }),
+				std::make_tuple(aSrcImage->handle() , avk::sync::sync_hint{ stage::copy + access::transfer_read , stage::copy + access::none           ,
+					vk::ImageSubresourceRange{ aImageAspectFlags, aSrcLevel, 1u, aSrcLayer, 1u } }),
 				std::make_tuple(aDstBuffer->handle(), avk::sync::sync_hint{ stage::copy + access::transfer_write, stage::copy + access::transfer_write })
 			},
 			[
@@ -7646,7 +7870,8 @@ namespace avk
 #else
 		const DISPATCH_LOADER_CORE_TYPE& aDispatchLoaderCore,
 #endif
-		const std::vector<recorded_commands_t>& aRecordedCommandsAndSyncInstructions);
+		const std::vector<recorded_commands_t>& aRecordedCommandsAndSyncInstructions,
+		uint32_t& aNumPipelineBarrierCallsSaved);
 
 	template <typename T>
 	inline static T accumulate_sync_details(
@@ -7754,1008 +7979,5208 @@ namespace avk
 		return result;
 	}
 
-	// Internal helper function to assemble all the data for a barrier, based on:
-	//  - A given sync_type_command (aBarrierData)
-	//  - All the sync_hints of action_type_commands aRecordedCommandsAndSyncInstructions
-	template <typename T>
-	inline static T assemble_barrier_data(
-		const sync::sync_type_command& aBarrierData, 
-		const std::vector<recorded_commands_t>& aRecordedCommandsAndSyncInstructions,
-		int aRecordedStuffIndex
-	) {
-		// Sanity check: Does T and aBarrierData fit together?
-		assert(
-			   (std::is_same_v<T, vk::MemoryBarrier2KHR>       && (aBarrierData.is_global_execution_barrier() || aBarrierData.is_global_memory_barrier()))
-			|| (std::is_same_v<T, vk::ImageMemoryBarrier2KHR>  && (aBarrierData.is_image_memory_barrier()                                               ))
-			|| (std::is_same_v<T, vk::BufferMemoryBarrier2KHR> && (aBarrierData.is_buffer_memory_barrier()                                              ))
-		);
-
-		if (!aRecordedCommandsAndSyncInstructions.empty()) {
-			assert(std::holds_alternative<sync::sync_type_command>(aRecordedCommandsAndSyncInstructions[aRecordedStuffIndex]));
-			if (!std::holds_alternative<sync::sync_type_command>(aRecordedCommandsAndSyncInstructions[aRecordedStuffIndex])) {
-				throw avk::logic_error("The element at aRecordedStuffIndex[" + std::to_string(aRecordedStuffIndex) + "] is not of type sync_type_command.");
-			}
-		}
-
-		// We're definitely going to establish a barrier:
-		auto barrier = T{};
-
-		// The barrier can be restricted to a specific resource only, in which case, we should only accumulate
-		// sync data from relevant sync hints (i.e., relevant means: restricted to the same resource):
-		std::optional<std::variant<vk::Image, vk::Buffer>> restrictedToSpecificResource;
-		if constexpr (std::is_same_v<T, vk::ImageMemoryBarrier2KHR>) {
-			restrictedToSpecificResource = aBarrierData.image_memory_barrier_data().mImage;
-		}
-		if constexpr (std::is_same_v<T, vk::BufferMemoryBarrier2KHR>) {
-			restrictedToSpecificResource = aBarrierData.buffer_memory_barrier_data().mBuffer;
-		}
-		
-		// Handle source stage:
-		std::visit(lambda_overload{
-			[&barrier                                                            ](const std::monostate&){
-				barrier.setSrcStageMask(vk::PipelineStageFlagBits2KHR::eNone);
-			},
-			[&barrier                                                            ](const vk::PipelineStageFlags2KHR& bFixedStage){
-				barrier.setSrcStageMask(bFixedStage);
-			},
-			[&barrier, &aRecordedCommandsAndSyncInstructions, aRecordedStuffIndex, &restrictedToSpecificResource](const avk::stage::auto_stage_t& bAutoStage){
-				if (aRecordedCommandsAndSyncInstructions.empty()) {
-					barrier.setSrcStageMask(vk::PipelineStageFlagBits2KHR::eAllCommands);
-				}
-				else {
-					// Gotta determine which stage:
-					barrier.setSrcStageMask(accumulate_sync_details<vk::PipelineStageFlags2KHR>(
-						aRecordedCommandsAndSyncInstructions, 
-						/* Start index: within std::vector<recorded_commands_t>: */ aRecordedStuffIndex,
-						/* How many steps to accumulate: */ static_cast<int>(bAutoStage),
-						/* before-wards: */ -1,
-						/* If we can't determine something specific, employ a heavy barrier to ensure correctness: */ vk::PipelineStageFlagBits2KHR::eAllCommands,
-						restrictedToSpecificResource
-					));
-				}
-			},
-		}, aBarrierData.src_stage());
-
-		// Handle destination stage:
-		std::visit(lambda_overload{
-			[&barrier                                                            ](const std::monostate&){
-				barrier.setDstStageMask(vk::PipelineStageFlagBits2KHR::eNone);
-			},
-			[&barrier                                                            ](const vk::PipelineStageFlags2KHR& bFixedStage){
-				barrier.setDstStageMask(bFixedStage);
-			},
-			[&barrier, &aRecordedCommandsAndSyncInstructions, aRecordedStuffIndex, &restrictedToSpecificResource](const avk::stage::auto_stage_t& bAutoStage){
-				if (aRecordedCommandsAndSyncInstructions.empty()) {
-					barrier.setDstStageMask(vk::PipelineStageFlagBits2KHR::eAllCommands);
-				}
-				else {
-					// Gotta determine which stage:
-					barrier.setDstStageMask(accumulate_sync_details<vk::PipelineStageFlags2KHR>(
-						aRecordedCommandsAndSyncInstructions, 
-						/* Start index: within std::vector<recorded_commands_t>: */ aRecordedStuffIndex,
-						/* How many steps to accumulate: */ static_cast<int>(bAutoStage),
-						/* after-wards: */  1,
-						/* If we can't determine something specific, employ a heavy barrier to ensure correctness: */ vk::PipelineStageFlagBits2KHR::eAllCommands,
-						restrictedToSpecificResource
-					));
-				}
-			},
-		}, aBarrierData.dst_stage());
+	// Internal helper function which turns a vk::Image or vk::Buffer handle into a key for hash maps:
+	template <typename H>
+	inline static uint64_t resource_handle_key(H aHandle)
+	{
+		return reinterpret_cast<uint64_t>(static_cast<typename H::CType>(aHandle));
+	}
 
-		// Handle source access:
-		std::visit(lambda_overload{
-			[&barrier                                                            ](const std::monostate&){
-				barrier.setSrcAccessMask(vk::AccessFlagBits2KHR::eNone);
-			},
-			[&barrier                                                            ](const vk::AccessFlags2KHR& bFixedAccess){
-				barrier.setSrcAccessMask(bFixedAccess);
-			},
-			[&barrier, &aRecordedCommandsAndSyncInstructions, aRecordedStuffIndex, &restrictedToSpecificResource](const avk::access::auto_access_t& bAutoAccess){
-				if (aRecordedCommandsAndSyncInstructions.empty()) {
-					barrier.setSrcAccessMask(vk::AccessFlagBits2KHR::eMemoryWrite);
-				}
-				else {
-					// Gotta determine which access:
-					barrier.setSrcAccessMask(accumulate_sync_details<vk::AccessFlags2KHR>(
-						aRecordedCommandsAndSyncInstructions, 
-						/* Start index: within std::vector<recorded_commands_t>: */ aRecordedStuffIndex,
-						/* How many steps to accumulate: */ static_cast<int>(bAutoAccess),
-						/* before-wards: */ -1,
-						/* If we can't determine something specific, employ a heavy access mask to ensure correctness: */ vk::AccessFlagBits2KHR::eMemoryWrite,
-						restrictedToSpecificResource
-					));
-				}
-			},
-		}, aBarrierData.src_access());
+	// Fallback values which are used if auto_stage/auto_access can not be resolved to something specific:
+	static const vk::PipelineStageFlags2KHR sFallbackStages    = vk::PipelineStageFlagBits2KHR::eAllCommands;
+	static const vk::AccessFlags2KHR        sFallbackSrcAccess = vk::AccessFlagBits2KHR::eMemoryWrite;
+	static const vk::AccessFlags2KHR        sFallbackDstAccess = vk::AccessFlagBits2KHR::eMemoryWrite | vk::AccessFlagBits2KHR::eMemoryRead;
 
-		// Handle destination access:
-		std::visit(lambda_overload{
-			[&barrier                                                            ](const std::monostate&){
-				barrier.setDstAccessMask(vk::AccessFlagBits2KHR::eNone);
-			},
-			[&barrier                                                            ](const vk::AccessFlags2KHR& bFixedAccess){
-				barrier.setDstAccessMask(bFixedAccess);
-			},
-			[&barrier, &aRecordedCommandsAndSyncInstructions, aRecordedStuffIndex, &restrictedToSpecificResource](const avk::access::auto_access_t& bAutoAccess){
-				if (aRecordedCommandsAndSyncInstructions.empty()) {
-					barrier.setSrcAccessMask(vk::AccessFlagBits2KHR::eMemoryWrite | vk::AccessFlagBits2KHR::eMemoryRead);
-				}
-				else {
-					// Gotta determine which access:
-					barrier.setDstAccessMask(accumulate_sync_details<vk::AccessFlags2KHR>(
-						aRecordedCommandsAndSyncInstructions, 
-						/* Start index: within std::vector<recorded_commands_t>: */ aRecordedStuffIndex,
-						/* How many steps to accumulate: */ static_cast<uint32_t>(bAutoAccess),
-						/* after-wards: */  1,
-						/* If we can't determine something specific, employ a heavy access mask to ensure correctness: */ vk::AccessFlagBits2KHR::eMemoryWrite | vk::AccessFlagBits2KHR::eMemoryRead,
-						restrictedToSpecificResource
-					));
-				}
-			},
-		}, aBarrierData.dst_access());
+	// A range of a resource: Either the whole resource (std::monostate), an image subresource range, or a buffer offset and size.
+	using resource_range = std::variant<std::monostate, vk::ImageSubresourceRange, std::tuple<vk::DeviceSize, vk::DeviceSize>>;
 
-		// For T = vk::MemoryBarrier2KHR, we are done.
-		// But for image memory barriers or buffer memory barriers, there could be more sync data to be filled-in:
-		
-		if constexpr (std::is_same_v<T, vk::ImageMemoryBarrier2KHR>) {
-			auto imageSyncData = aBarrierData.image_memory_barrier_data();
+	// Internal helper function which returns the (exclusive) end of a buffer range, taking VK_WHOLE_SIZE into account:
+	inline static vk::DeviceSize buffer_range_end(const std::tuple<vk::DeviceSize, vk::DeviceSize>& aRange)
+	{
+		const auto [offset, size] = aRange;
+		return VK_WHOLE_SIZE == size ? std::numeric_limits<vk::DeviceSize>::max() : offset + size;
+	}
 
-			barrier.setImage(imageSyncData.mImage);
-			barrier.setSubresourceRange(imageSyncData.mSubresourceRange);
+	// Internal helper function which returns the (exclusive) end of mip levels or array layers, taking VK_REMAINING_MIP_LEVELS and VK_REMAINING_ARRAY_LAYERS into account:
+	inline static uint64_t subresource_range_end(uint32_t aBase, uint32_t aCount)
+	{
+		static_assert(VK_REMAINING_MIP_LEVELS == VK_REMAINING_ARRAY_LAYERS);
+		return VK_REMAINING_MIP_LEVELS == aCount ? std::numeric_limits<uint64_t>::max() : static_cast<uint64_t>(aBase) + aCount;
+	}
 
-			// Specification goes like this:
-			// > When the old and new layout are equal, the layout values are ignored - data is preserved
-			// > no matter what values are specified, or what layout the image is currently in.
-			if (imageSyncData.mLayoutTransition.has_value()) {
-				barrier.setOldLayout(imageSyncData.mLayoutTransition.value().mOld.mLayout);
-				barrier.setNewLayout(imageSyncData.mLayoutTransition.value().mNew.mLayout);
-			}
-			// else leave both set to 0 which corresponds to eUndefined -> eUndefined, a.k.a. no layout transition
+	inline static bool ranges_overlap(const resource_range& aFirst, const resource_range& aSecond)
+	{
+		if (std::holds_alternative<std::monostate>(aFirst) || std::holds_alternative<std::monostate>(aSecond)) {
+			return true;
 		}
-
-		if constexpr (std::is_same_v<T, vk::BufferMemoryBarrier2KHR>) {
-			auto bufferSyncData = aBarrierData.buffer_memory_barrier_data();
-			barrier.setBuffer(bufferSyncData.mBuffer);
-			barrier.setOffset(bufferSyncData.mOffset);
-			barrier.setSize(bufferSyncData.mSize);
+		if (std::holds_alternative<vk::ImageSubresourceRange>(aFirst) && std::holds_alternative<vk::ImageSubresourceRange>(aSecond)) {
+			const auto& a = std::get<vk::ImageSubresourceRange>(aFirst);
+			const auto& b = std::get<vk::ImageSubresourceRange>(aSecond);
+			return static_cast<bool>(a.aspectMask & b.aspectMask)
+				&& a.baseMipLevel   < subresource_range_end(b.baseMipLevel,   b.levelCount) && b.baseMipLevel   < subresource_range_end(a.baseMipLevel,   a.levelCount)
+				&& a.baseArrayLayer < subresource_range_end(b.baseArrayLayer, b.layerCount) && b.baseArrayLayer < subresource_range_end(a.baseArrayLayer, a.layerCount);
 		}
-
-		// For both, buffer memory barriers and image memory barriers, queue family o	wnership transfers are relevant:
-		if constexpr (std::is_same_v<T, vk::ImageMemoryBarrier2KHR> || std::is_same_v<T, vk::BufferMemoryBarrier2KHR>) {
-			auto qfot = aBarrierData.queue_family_ownership_transfer();
-			barrier.setSrcQueueFamilyIndex(qfot.has_value() ? qfot.value().mSrcQueueFamilyIndex : VK_QUEUE_FAMILY_IGNORED);
-			barrier.setDstQueueFamilyIndex(qfot.has_value() ? qfot.value().mDstQueueFamilyIndex : VK_QUEUE_FAMILY_IGNORED);
+		if (std::holds_alternative<std::tuple<vk::DeviceSize, vk::DeviceSize>>(aFirst) && std::holds_alternative<std::tuple<vk::DeviceSize, vk::DeviceSize>>(aSecond)) {
+			const auto& a = std::get<std::tuple<vk::DeviceSize, vk::DeviceSize>>(aFirst);
+			const auto& b = std::get<std::tuple<vk::DeviceSize, vk::DeviceSize>>(aSecond);
+			return std::get<0>(a) < buffer_range_end(b) && std::get<0>(b) < buffer_range_end(a);
 		}
-
-		return barrier;
+		return true; // Mismatching kinds of ranges => be conservative
 	}
 
-	inline static void record_into_command_buffer(command_buffer_t& aCommandBuffer, 
-#ifdef AVK_USE_SYNCHRONIZATION2_INSTEAD_OF_CORE
-		const DISPATCH_LOADER_EXT_TYPE& aDispatchLoaderExt,
-#else
-		const DISPATCH_LOADER_CORE_TYPE& aDispatchLoaderCore,
-#endif
-		const command::state_type_command& aStateCmd)
+	inline static bool range_contains(const resource_range& aOuter, const resource_range& aInner)
 	{
-		if (aStateCmd.mFun) {
-			aStateCmd.mFun(aCommandBuffer);
+		if (std::holds_alternative<std::monostate>(aOuter)) {
+			return true;
+		}
+		if (std::holds_alternative<vk::ImageSubresourceRange>(aOuter) && std::holds_alternative<vk::ImageSubresourceRange>(aInner)) {
+			const auto& o = std::get<vk::ImageSubresourceRange>(aOuter);
+			const auto& i = std::get<vk::ImageSubresourceRange>(aInner);
+			return (i.aspectMask & o.aspectMask) == i.aspectMask
+				&& o.baseMipLevel   <= i.baseMipLevel   && subresource_range_end(i.baseMipLevel,   i.levelCount) <= subresource_range_end(o.baseMipLevel,   o.levelCount)
+				&& o.baseArrayLayer <= i.baseArrayLayer && subresource_range_end(i.baseArrayLayer, i.layerCount) <= subresource_range_end(o.baseArrayLayer, o.layerCount);
 		}
+		if (std::holds_alternative<std::tuple<vk::DeviceSize, vk::DeviceSize>>(aOuter) && std::holds_alternative<std::tuple<vk::DeviceSize, vk::DeviceSize>>(aInner)) {
+			const auto& o = std::get<std::tuple<vk::DeviceSize, vk::DeviceSize>>(aOuter);
+			const auto& i = std::get<std::tuple<vk::DeviceSize, vk::DeviceSize>>(aInner);
+			return std::get<0>(o) <= std::get<0>(i) && buffer_range_end(i) <= buffer_range_end(o);
+		}
+		return false;
 	}
 
-	inline static void record_into_command_buffer(command_buffer_t& aCommandBuffer,
-#ifdef AVK_USE_SYNCHRONIZATION2_INSTEAD_OF_CORE
-		const DISPATCH_LOADER_EXT_TYPE& aDispatchLoaderExt,
-#else
-		const DISPATCH_LOADER_CORE_TYPE& aDispatchLoaderCore,
-#endif
-		const command::action_type_command& aActionCmd)
+	// Internal helper function which returns the smallest range which contains both given ranges:
+	inline static resource_range bounding_range(const resource_range& aFirst, const resource_range& aSecond)
 	{
-		if (aActionCmd.mBeginFun) {
-			aActionCmd.mBeginFun(aCommandBuffer);
-		}
-		if (!aActionCmd.mNestedCommandsAndSyncInstructions.empty()) {
-			record_into_command_buffer(aCommandBuffer, 
-#ifdef AVK_USE_SYNCHRONIZATION2_INSTEAD_OF_CORE
-				aDispatchLoaderExt,
-#else
-				aDispatchLoaderCore,
-#endif
-				aActionCmd.mNestedCommandsAndSyncInstructions);
+		if (std::holds_alternative<vk::ImageSubresourceRange>(aFirst) && std::holds_alternative<vk::ImageSubresourceRange>(aSecond)) {
+			const auto& a = std::get<vk::ImageSubresourceRange>(aFirst);
+			const auto& b = std::get<vk::ImageSubresourceRange>(aSecond);
+			const auto mipEnd   = std::max(subresource_range_end(a.baseMipLevel,   a.levelCount), subresource_range_end(b.baseMipLevel,   b.levelCount));
+			const auto layerEnd = std::max(subresource_range_end(a.baseArrayLayer, a.layerCount), subresource_range_end(b.baseArrayLayer, b.layerCount));
+			const auto baseMip   = std::min(a.baseMipLevel,   b.baseMipLevel);
+			const auto baseLayer = std::min(a.baseArrayLayer, b.baseArrayLayer);
+			return vk::ImageSubresourceRange{ a.aspectMask | b.aspectMask,
+				baseMip,   std::numeric_limits<uint64_t>::max() == mipEnd   ? VK_REMAINING_MIP_LEVELS   : static_cast<uint32_t>(mipEnd   - baseMip),
+				baseLayer, std::numeric_limits<uint64_t>::max() == layerEnd ? VK_REMAINING_ARRAY_LAYERS : static_cast<uint32_t>(layerEnd - baseLayer)
+			};
 		}
-		if (aActionCmd.mEndFun) {
-			aActionCmd.mEndFun(aCommandBuffer);
+		if (std::holds_alternative<std::tuple<vk::DeviceSize, vk::DeviceSize>>(aFirst) && std::holds_alternative<std::tuple<vk::DeviceSize, vk::DeviceSize>>(aSecond)) {
+			const auto& a = std::get<std::tuple<vk::DeviceSize, vk::DeviceSize>>(aFirst);
+			const auto& b = std::get<std::tuple<vk::DeviceSize, vk::DeviceSize>>(aSecond);
+			const auto offset = std::min(std::get<0>(a), std::get<0>(b));
+			const auto end    = std::max(buffer_range_end(a), buffer_range_end(b));
+			return std::make_tuple(offset, static_cast<vk::DeviceSize>(std::numeric_limits<vk::DeviceSize>::max() == end ? VK_WHOLE_SIZE : end - offset));
 		}
+		return std::monostate{};
 	}
 
-	inline static void record_into_command_buffer(
-		command_buffer_t& aCommandBuffer, 
-#ifdef AVK_USE_SYNCHRONIZATION2_INSTEAD_OF_CORE
-		const DISPATCH_LOADER_EXT_TYPE& aDispatchLoaderExt,
-#else
-		const DISPATCH_LOADER_CORE_TYPE& aDispatchLoaderCore,
-#endif
-		const sync::sync_type_command& aSyncCmd, 
-		const std::vector<recorded_commands_t>& aRecordedCommandsAndSyncInstructions, 
-		int aRecordedStuffIndex)
+	// Internal helper function which returns the range that is covered by both given ranges. They must overlap.
+	inline static resource_range intersect_ranges(const resource_range& aFirst, const resource_range& aSecond)
 	{
-		if (aSyncCmd.is_global_execution_barrier() || aSyncCmd.is_global_memory_barrier()) {
-			auto barrier = assemble_barrier_data<vk::MemoryBarrier2KHR>(aSyncCmd, aRecordedCommandsAndSyncInstructions, aRecordedStuffIndex);
-			auto dependencyInfo = vk::DependencyInfoKHR{}
-				.setMemoryBarrierCount(1u)
-				.setPMemoryBarriers(&barrier);
-#ifdef AVK_USE_SYNCHRONIZATION2_INSTEAD_OF_CORE
-			aCommandBuffer.handle().pipelineBarrier2KHR(dependencyInfo, aDispatchLoaderExt);
-#else
-			aCommandBuffer.handle().pipelineBarrier2(dependencyInfo, aDispatchLoaderCore);
-#endif
+		assert(ranges_overlap(aFirst, aSecond));
+		if (std::holds_alternative<std::monostate>(aFirst)) {
+			return aSecond;
 		}
-		else if (aSyncCmd.is_image_memory_barrier()) {
-			auto barrier = assemble_barrier_data<vk::ImageMemoryBarrier2KHR>(aSyncCmd, aRecordedCommandsAndSyncInstructions, aRecordedStuffIndex);
-			auto dependencyInfo = vk::DependencyInfoKHR{}
-				.setImageMemoryBarrierCount(1u)
-				.setPImageMemoryBarriers(&barrier);
-#ifdef AVK_USE_SYNCHRONIZATION2_INSTEAD_OF_CORE
-			aCommandBuffer.handle().pipelineBarrier2KHR(dependencyInfo, aDispatchLoaderExt);
-#else
-			aCommandBuffer.handle().pipelineBarrier2(dependencyInfo, aDispatchLoaderCore);
-#endif
+		if (std::holds_alternative<std::monostate>(aSecond)) {
+			return aFirst;
 		}
-		else if (aSyncCmd.is_buffer_memory_barrier()) {
-			auto barrier = assemble_barrier_data<vk::BufferMemoryBarrier2KHR>(aSyncCmd, aRecordedCommandsAndSyncInstructions, aRecordedStuffIndex);
-			auto dependencyInfo = vk::DependencyInfoKHR{}
-				.setBufferMemoryBarrierCount(1u)
-				.setPBufferMemoryBarriers(&barrier);
-#ifdef AVK_USE_SYNCHRONIZATION2_INSTEAD_OF_CORE
-			aCommandBuffer.handle().pipelineBarrier2KHR(dependencyInfo, aDispatchLoaderExt);
-#else
-			aCommandBuffer.handle().pipelineBarrier2(dependencyInfo, aDispatchLoaderCore);
-#endif
+		if (std::holds_alternative<vk::ImageSubresourceRange>(aFirst) && std::holds_alternative<vk::ImageSubresourceRange>(aSecond)) {
+			const auto& a = std::get<vk::ImageSubresourceRange>(aFirst);
+			const auto& b = std::get<vk::ImageSubresourceRange>(aSecond);
+			const auto mipEnd   = std::min(subresource_range_end(a.baseMipLevel,   a.levelCount), subresource_range_end(b.baseMipLevel,   b.levelCount));
+			const auto layerEnd = std::min(subresource_range_end(a.baseArrayLayer, a.layerCount), subresource_range_end(b.baseArrayLayer, b.layerCount));
+			const auto baseMip   = std::max(a.baseMipLevel,   b.baseMipLevel);
+			const auto baseLayer = std::max(a.baseArrayLayer, b.baseArrayLayer);
+			return vk::ImageSubresourceRange{ a.aspectMask & b.aspectMask,
+				baseMip,   std::numeric_limits<uint64_t>::max() == mipEnd   ? VK_REMAINING_MIP_LEVELS   : static_cast<uint32_t>(mipEnd   - baseMip),
+				baseLayer, std::numeric_limits<uint64_t>::max() == layerEnd ? VK_REMAINING_ARRAY_LAYERS : static_cast<uint32_t>(layerEnd - baseLayer)
+			};
 		}
+		if (std::holds_alternative<std::tuple<vk::DeviceSize, vk::DeviceSize>>(aFirst) && std::holds_alternative<std::tuple<vk::DeviceSize, vk::DeviceSize>>(aSecond)) {
+			const auto& a = std::get<std::tuple<vk::DeviceSize, vk::DeviceSize>>(aFirst);
+			const auto& b = std::get<std::tuple<vk::DeviceSize, vk::DeviceSize>>(aSecond);
+			const auto offset = std::max(std::get<0>(a), std::get<0>(b));
+			const auto end    = std::min(buffer_range_end(a), buffer_range_end(b));
+			return std::make_tuple(offset, static_cast<vk::DeviceSize>(std::numeric_limits<vk::DeviceSize>::max() == end ? VK_WHOLE_SIZE : end - offset));
+		}
+		return aFirst;
 	}
 
-	void command_buffer_t::record(const avk::command::state_type_command& aToBeRecorded)
-	{
-		record_into_command_buffer(*this,
-#ifdef AVK_USE_SYNCHRONIZATION2_INSTEAD_OF_CORE
-			root_ptr()->dispatch_loader_ext(), 
-#else
-			root_ptr()->dispatch_loader_core(),
-#endif
-			aToBeRecorded);
-	}
-
-	void command_buffer_t::record(const avk::command::action_type_command& aToBeRecorded)
+	// Internal helper function which returns the range of a resource-specific sync hint:
+	inline static resource_range range_of(const std::variant<vk::Image, vk::Buffer>& aResource, const sync::sync_hint& aResourceSyncHint)
 	{
-		record_into_command_buffer(*this,
-#ifdef AVK_USE_SYNCHRONIZATION2_INSTEAD_OF_CORE
-			root_ptr()->dispatch_loader_ext(),
-#else
-			root_ptr()->dispatch_loader_core(),
-#endif
-			aToBeRecorded);
+		if (std::holds_alternative<vk::Image>(aResource) && aResourceSyncHint.mImageSubresourceRangeAffected.has_value()) {
+			return aResourceSyncHint.mImageSubresourceRangeAffected.value();
+		}
+		if (std::holds_alternative<vk::Buffer>(aResource) && aResourceSyncHint.mBufferOffsetSizeAffected.has_value()) {
+			return aResourceSyncHint.mBufferOffsetSizeAffected.value();
+		}
+		return std::monostate{};
 	}
 
-	void command_buffer_t::record(const avk::sync::sync_type_command& aToBeRecorded)
+	// Internal helper function which returns the range that an image memory barrier or a buffer memory barrier refers to:
+	inline static resource_range range_of(const sync::sync_type_command& aSyncCmd)
 	{
-		record_into_command_buffer(*this,
-#ifdef AVK_USE_SYNCHRONIZATION2_INSTEAD_OF_CORE
-			root_ptr()->dispatch_loader_ext(),
-#else
-			root_ptr()->dispatch_loader_core(),
-#endif
-			aToBeRecorded, std::vector<recorded_commands_t>{}, 0);
+		if (aSyncCmd.is_image_memory_barrier()) {
+			return aSyncCmd.image_memory_barrier_data().mSubresourceRange;
+		}
+		if (aSyncCmd.is_buffer_memory_barrier()) {
+			const auto bufferSyncData = aSyncCmd.buffer_memory_barrier_data();
+			return std::make_tuple(bufferSyncData.mOffset, bufferSyncData.mSize);
+		}
+		return std::monostate{};
 	}
 
-	void command_buffer_t::record(std::vector<avk::recorded_commands_t> aRecordedCommandsAndSyncInstructions)
+	// Internal helper for resource_state_tracker: Accumulates the (source or destination) stages and accesses of multiple sync hints.
+	struct resource_usage_accumulator
 	{
-		avk::recorded_commands{ root_ptr(), std::move(aRecordedCommandsAndSyncInstructions) }
-			.into_command_buffer(*this, false); // Last parameter: do not call begin/end here!
-	}
+		// aCommandIndex is only stored if it is not negative, i.e., if resolution details are to be recorded:
+		void add(const std::optional<stage_and_access_precisely>& aHintValue, int aCommandIndex = -1)
+		{
+			if (aHintValue.has_value()) {
+				mStages   |= aHintValue.value().mStage;
+				mAccesses |= aHintValue.value().mAccess;
+			}
+			else {
+				// Unspecified means that we have to assume the worst:
+				mIncludesUnspecified = true;
+			}
+			++mNumContributions;
+			if (aCommandIndex >= 0) {
+				mCommandIndices.push_back(aCommandIndex);
+			}
+		}
 
-	struct recordee_visitors
-	{
-		void operator()(const command::state_type_command& vStateCmd) const {
-			record_into_command_buffer(mCommandBuffer, 
-#ifdef AVK_USE_SYNCHRONIZATION2_INSTEAD_OF_CORE
-				mDispatchLoaderExt, 
-#else
-				mDispatchLoaderCore,
-#endif
-				vStateCmd);
+		void add(const resource_usage_accumulator& aOther)
+		{
+			mStages   |= aOther.mStages;
+			mAccesses |= aOther.mAccesses;
+			mIncludesUnspecified = mIncludesUnspecified || aOther.mIncludesUnspecified;
+			mNumContributions += aOther.mNumContributions;
+			mCommandIndices.insert(std::end(mCommandIndices), std::begin(aOther.mCommandIndices), std::end(aOther.mCommandIndices));
 		}
-		void operator()(const command::action_type_command& vActionCmd) const {
-			record_into_command_buffer(mCommandBuffer,
-#ifdef AVK_USE_SYNCHRONIZATION2_INSTEAD_OF_CORE
-				mDispatchLoaderExt,
-#else
-				mDispatchLoaderCore,
-#endif
-				vActionCmd);
-			
+
+		vk::PipelineStageFlags2KHR stages() const
+		{
+			return mIncludesUnspecified ? mStages | sFallbackStages : mStages;
 		}
-		void operator()(const sync::sync_type_command& vSyncCmd) const {
-			record_into_command_buffer(mCommandBuffer,
-#ifdef AVK_USE_SYNCHRONIZATION2_INSTEAD_OF_CORE
-				mDispatchLoaderExt,
-#else
-				mDispatchLoaderCore,
-#endif
-				vSyncCmd, mRecordedStuff, mCurrentIndexIntoRecordedStuff);
+
+		vk::AccessFlags2KHR accesses(vk::AccessFlags2KHR aFallbackAccess) const
+		{
+			return mIncludesUnspecified ? mAccesses | aFallbackAccess : mAccesses;
 		}
 
-		command_buffer_t& mCommandBuffer;
-#ifdef AVK_USE_SYNCHRONIZATION2_INSTEAD_OF_CORE
-		const DISPATCH_LOADER_EXT_TYPE& mDispatchLoaderExt;
-#else
-		const DISPATCH_LOADER_CORE_TYPE& mDispatchLoaderCore;
-#endif
-		const std::vector<recorded_commands_t>& mRecordedStuff;
-		int mCurrentIndexIntoRecordedStuff;
+		vk::PipelineStageFlags2KHR mStages = {};
+		vk::AccessFlags2KHR mAccesses = {};
+		bool mIncludesUnspecified = false;
+		uint32_t mNumContributions = 0u;
+		std::vector<int> mCommandIndices;
 	};
-	
-	inline static void record_into_command_buffer(
-		command_buffer_t& aCommandBuffer, 
-#ifdef AVK_USE_SYNCHRONIZATION2_INSTEAD_OF_CORE
-		const DISPATCH_LOADER_EXT_TYPE& aDispatchLoaderExt,
-#else
-		const DISPATCH_LOADER_CORE_TYPE& aDispatchLoaderCore,
-#endif
-		const std::vector<recorded_commands_t>& aRecordedCommandsAndSyncInstructions)
-	{
-		recordee_visitors visitState{ aCommandBuffer, 
-#ifdef AVK_USE_SYNCHRONIZATION2_INSTEAD_OF_CORE
-			aDispatchLoaderExt,
-#else
-			aDispatchLoaderCore,
-#endif
-			aRecordedCommandsAndSyncInstructions, /* Current index: */ 0 };
-		
-		const int n = static_cast<int>(aRecordedCommandsAndSyncInstructions.size());
-		for (int i = 0; i < n; ++i) {
-			// Get current element:
-			auto& recordee = aRecordedCommandsAndSyncInstructions[i];
-			// Update current index:
-			visitState.mCurrentIndexIntoRecordedStuff = i;
-			// Handle current element:
-			std::visit(visitState, recordee);
-		}
-	}
-	
-	submission_data recorded_command_buffer::then_waiting_for(avk::semaphore_wait_info aWaitInfo)
-	{
-		return submission_data{ mRoot, mCommandBufferToRecordInto, std::move(aWaitInfo) };
-	}
 
-	submission_data recorded_command_buffer::then_submit_to(const queue& aQueue)
+	// Internal helper for resource_state_tracker: The accumulated usages of one specific range of a resource
+	struct ranged_resource_usage
 	{
-		return submission_data{ mRoot, mCommandBufferToRecordInto, aQueue, this };
-	}
+		resource_range mRange;
+		resource_usage_accumulator mUsage;
+	};
 
-	recorded_command_buffer::recorded_command_buffer(const root* aRoot, const std::vector<recorded_commands_t>& aRecordedCommandsAndSyncInstructions, avk::resource_argument<avk::command_buffer_t> aCommandBuffer, const avk::recorded_commands* aDangerousRecordedCommandsPointer, bool aBeginEnd)
-		: mRoot{ aRoot }
-		, mCommandBufferToRecordInto{ std::move(aCommandBuffer) }
-		, mDangerousRecordedComandsPointer{ aDangerousRecordedCommandsPointer }
+	// Internal helper for resource_state_tracker: Everything that is known about one resource while passing over a list of recorded commands
+	struct tracked_resource_state
 	{
-		if (aBeginEnd) {
-			mCommandBufferToRecordInto.get().begin_recording();
+		// Adds the usage of a command to the not yet synchronized usages:
+		void add(const resource_range& aRange, const std::optional<stage_and_access_precisely>& aHintValue, int aCommandIndex)
+		{
+			if (!mPendingUsages.empty() && mPendingUsages.back().mRange == aRange) {
+				mPendingUsages.back().mUsage.add(aHintValue, aCommandIndex);
+				return;
+			}
+			mPendingUsages.push_back(ranged_resource_usage{ aRange, {} });
+			mPendingUsages.back().mUsage.add(aHintValue, aCommandIndex);
 		}
 
-		record_into_command_buffer(mCommandBufferToRecordInto.get(), 
-#ifdef AVK_USE_SYNCHRONIZATION2_INSTEAD_OF_CORE
-			mRoot->dispatch_loader_ext(),
-#else
-			mRoot->dispatch_loader_core(),
-#endif
-			aRecordedCommandsAndSyncInstructions);
+		// Takes all pending usages that overlap the range of a barrier. Those which are fully contained in the
+		// barrier's range are removed because they are synchronized by the barrier w.r.t. all subsequent usages.
+		// If there were any, the second tuple element contains the bounding range of all the overlapping usages.
+		std::tuple<std::optional<resource_usage_accumulator>, resource_range> take_overlapping(const resource_range& aBarrierRange)
+		{
+			std::optional<resource_usage_accumulator> overlapping;
+			std::optional<resource_range> bounds;
+			for (auto it = std::begin(mPendingUsages); it != std::end(mPendingUsages);) {
+				if (!ranges_overlap(it->mRange, aBarrierRange)) {
+					++it;
+					continue;
+				}
+				if (!overlapping.has_value()) {
+					overlapping.emplace();
+				}
+				overlapping->add(it->mUsage);
+				bounds = bounds.has_value() ? bounding_range(bounds.value(), it->mRange) : it->mRange;
+				if (range_contains(aBarrierRange, it->mRange)) {
+					it = mPendingUsages.erase(it);
+				}
+				else {
+					++it;
+				}
+			}
+			return std::make_tuple(std::move(overlapping), bounds.value_or(resource_range{}));
+		}
 
-		if (aBeginEnd) {
-			mCommandBufferToRecordInto.get().end_recording();
+		// Counts the action_type_commands which carry a resource-specific sync hint for this resource (each command only once):
+		void count_hinting_command(int aCommandIndex)
+		{
+			if (mLastHintingCommand != aCommandIndex) {
+				mLastHintingCommand = aCommandIndex;
+				++mNumHintingCommands;
+			}
 		}
-	}
 
-	recorded_commands::recorded_commands(const root* aRoot, std::vector<recorded_commands_t> aRecordedCommandsAndSyncInstructions)
-		: mRoot{ aRoot }
-		, mRecordedCommandsAndSyncInstructions{ std::move(aRecordedCommandsAndSyncInstructions) }
-	{
-		for (auto& recordee : mRecordedCommandsAndSyncInstructions) {
-			if (std::holds_alternative<avk::command::action_type_command>(recordee)) {
-				for (auto& lifetime : std::get<avk::command::action_type_command>(recordee).mLifetimeHandledResources) {
-					handle_lifetime_of(std::move(lifetime));
+		// Whether the given range has been fully covered by a previous barrier, and no action_type_command at all
+		// (regardless of its sync hints) has been recorded since. aLastActionCommand is the index of the most recent one.
+		bool is_synchronized(const resource_range& aRange, int aLastActionCommand) const
+		{
+			for (const auto& usage : mPendingUsages) {
+				if (ranges_overlap(usage.mRange, aRange)) {
+					return false;
 				}
-				std::get<avk::command::action_type_command>(recordee).mLifetimeHandledResources.clear();
 			}
+			return std::any_of(std::begin(mBarrierRanges), std::end(mBarrierRanges), [&aRange, aLastActionCommand](const covering_barrier& b) {
+				return b.mBarrierIndex > aLastActionCommand && range_contains(b.mRange, aRange);
+			});
 		}
-	}
-	
-	recorded_commands& recorded_commands::move_into(std::vector<recorded_commands_t>& aTarget)
-	{
-		aTarget = std::move(mRecordedCommandsAndSyncInstructions);
-		return *this;
-	}
-
-	recorded_commands& recorded_commands::prepend_by(std::vector<recorded_commands_t>& aCommands)
-	{
-		mRecordedCommandsAndSyncInstructions.insert(std::begin(mRecordedCommandsAndSyncInstructions), std::begin(aCommands), std::end(aCommands));
-		return *this;
-	}
 
-	recorded_commands& recorded_commands::append_by(std::vector<recorded_commands_t>& aTarget)
-	{
-		mRecordedCommandsAndSyncInstructions.insert(std::end(mRecordedCommandsAndSyncInstructions), std::begin(aTarget), std::end(aTarget));
-		return *this;
-	}
+		// A barrier whose destination scopes are resolved automatically, and the (possibly narrowed) range it has been recorded for
+		struct covering_barrier
+		{
+			resource_range mRange;
+			int mBarrierIndex;
+		};
 
-	recorded_commands& recorded_commands::handle_lifetime_of(any_owning_resource_t aResource)
-	{
-		mLifetimeHandledResources.push_back(std::move(aResource));
-		return *this;
-	}
+		std::vector<ranged_resource_usage> mPendingUsages;
+		std::vector<covering_barrier> mBarrierRanges;
+		int mNumHintingCommands = 0;
+		int mLastHintingCommand = -1;
+	};
 
-	std::vector<recorded_commands_t> recorded_commands::and_store()
+	// Internal helper for resource_state_tracker: The general sync hint of an action_type_command, and the command's index
+	// (which is only set to a non-negative value if resolution details are to be recorded)
+	struct nearby_sync_hint
 	{
-		return std::move(mRecordedCommandsAndSyncInstructions);
-	}
+		const sync::sync_hint* mSyncHint;
+		int mCommandIndex;
+	};
 
-	recorded_command_buffer recorded_commands::into_command_buffer(avk::resource_argument<avk::command_buffer_t> aCommandBuffer, bool aBeginEnd)
+	// Internal helper for resource_state_tracker: Accumulates the general sync hints of the aNumSteps nearest action_type_commands,
+	// where aNearbyHints contains the nearest sync hint at its front. If there are no nearby sync hints at all, an empty optional is returned.
+	inline static std::optional<resource_usage_accumulator> accumulate_nearby_sync_hints(const std::deque<nearby_sync_hint>& aNearbyHints, uint32_t aNumSteps, bool aUseSrcForSubsequentCmds)
 	{
-		recorded_command_buffer result(mRoot, mRecordedCommandsAndSyncInstructions, std::move(aCommandBuffer), this, aBeginEnd);
-
-		for (int i = static_cast<int>(mLifetimeHandledResources.size() - 1); i > 0; --i) {
-			if (std::visit(lambda_overload{
-				[](const bottom_level_acceleration_structure& a) { return a.is_shared_ownership_enabled(); },
-				[](const buffer&                              a) { return a.is_shared_ownership_enabled(); },
-				[](const buffer_view&                         a) { return a.is_shared_ownership_enabled(); },
-				[](const command_buffer&                      a) { return a.is_shared_ownership_enabled(); },
-				[](const command_pool&                        a) { return a.is_shared_ownership_enabled(); },
-				[](const compute_pipeline&                    a) { return a.is_shared_ownership_enabled(); },
-				[](const fence&                               a) { return a.is_shared_ownership_enabled(); },
-				[](const framebuffer&                         a) { return a.is_shared_ownership_enabled(); },
-				[](const graphics_pipeline&                   a) { return a.is_shared_ownership_enabled(); },
-				[](const image&                               a) { return a.is_shared_ownership_enabled(); },
-				[](const image_sampler&                       a) { return a.is_shared_ownership_enabled(); },
-				[](const image_view&                          a) { return a.is_shared_ownership_enabled(); },
-				[](const query_pool&                          a) { return a.is_shared_ownership_enabled(); },
-				[](const ray_tracing_pipeline&                a) { return a.is_shared_ownership_enabled(); },
-				[](const renderpass&                          a) { return a.is_shared_ownership_enabled(); },
-				[](const sampler&                             a) { return a.is_shared_ownership_enabled(); },
-				[](const semaphore&                           a) { return a.is_shared_ownership_enabled(); },
-				[](const top_level_acceleration_structure&    a) { return a.is_shared_ownership_enabled(); }
-			}, mLifetimeHandledResources[i])) {
-				// Copy and possibly reuse in future:
-				result.handling_lifetime_of(mLifetimeHandledResources[i]);
-			}
-			else {
-				// Move and remove:
-				result.handling_lifetime_of(std::move(mLifetimeHandledResources[i]));
-				mLifetimeHandledResources.erase(std::begin(mLifetimeHandledResources) + i);
-			}
+		if (aNearbyHints.empty()) {
+			return {};
+		}
+		// Doesn't make sense if aNumSteps is less than 1, but the user could pass it (e.g., through stage::auto_stages(0)) => just max it:
+		const auto n = std::min(static_cast<size_t>(std::max(aNumSteps, 1u)), aNearbyHints.size());
+		resource_usage_accumulator result;
+		for (size_t i = 0; i < n; ++i) {
+			result.add(aUseSrcForSubsequentCmds ? aNearbyHints[i].mSyncHint->mSrcForSubsequentCmds : aNearbyHints[i].mSyncHint->mDstForPreviousCmds, aNearbyHints[i].mCommandIndex);
 		}
-
 		return result;
 	}
 
-	namespace command
+	namespace sync
 	{
-		action_type_command begin_render_pass_for_framebuffer(const renderpass_t& aRenderpass, const framebuffer_t& aFramebuffer, vk::Offset2D aRenderAreaOffset, std::optional<vk::Extent2D> aRenderAreaExtent, bool aSubpassesInline)
+		resource_state_tracker::resource_state_tracker(const std::vector<recorded_commands_t>& aRecordedCommandsAndSyncInstructions, bool aRecordResolutionDetails)
+			: mResolvedScopes(aRecordedCommandsAndSyncInstructions.size())
 		{
-			return action_type_command{
-				// Define a sync hint that corresponds to the implicit subpass dependencies (see specification chapter 8.1)
-				avk::sync::sync_hint {
-					{{ // What previous commands must synchronize with:
-						vk::PipelineStageFlagBits2KHR::eAllCommands, // eAllGraphics does not include new stages or ext-stages. Therefore, eAllCommands!
-						vk::AccessFlagBits2KHR::eInputAttachmentRead | vk::AccessFlagBits2KHR::eColorAttachmentRead | vk::AccessFlagBits2KHR::eColorAttachmentWrite | vk::AccessFlagBits2KHR::eDepthStencilAttachmentRead | vk::AccessFlagBits2KHR::eDepthStencilAttachmentWrite
-					}},
-					{{ // What subsequent commands must synchronize with:
-						vk::PipelineStageFlagBits2KHR::eAllCommands, // Same comment as above regarding eAllCommands vs. eAllGraphics
-						vk::AccessFlagBits2KHR::eColorAttachmentWrite | vk::AccessFlagBits2KHR::eDepthStencilAttachmentWrite
-					}}
-				},
-				{},
-				[
-					lRoot = aRenderpass.root_ptr(),
-					lExtent = aFramebuffer.image_view_at(0)->get_image().create_info().extent,
-					lClearValues = aRenderpass.clear_values(),
-					lRenderPassHandle = aRenderpass.handle(),
-					lFramebufferHandle = aFramebuffer.handle(),
-					aRenderAreaOffset, aRenderAreaExtent, aSubpassesInline
-				](avk::command_buffer_t& cb) {
-					// TODO: make vk::SubpassContentscontents state explicit
-					cb.save_subpass_contents_state(aSubpassesInline ? vk::SubpassContents::eInline : vk::SubpassContents::eSecondaryCommandBuffers);
+			// auto_stage_t and auto_access_t can not express more steps than this:
+			constexpr size_t maxNearbyHints = std::numeric_limits<stage::auto_stage_t>::max();
+			const int n = static_cast<int>(aRecordedCommandsAndSyncInstructions.size());
+			if (aRecordResolutionDetails) {
+				mResolutionDetails.resize(n);
+			}
+			// Command indices are only passed on to the accumulators if resolution details are to be recorded:
+			const auto commandIndex = [aRecordResolutionDetails](int aIndex) { return aRecordResolutionDetails ? aIndex : -1; };
+
+			// Records which commands the source or destination scopes (or a part of them) of the barrier at aIndex have been resolved w.r.t.:
+			const auto recordDetails = [this](int aIndex, const resource_usage_accumulator& aUsages, bool aSrc, bool aStages, bool aAccesses) {
+				if (mResolutionDetails.empty()) {
+					return;
+				}
+				auto& details = mResolutionDetails[aIndex];
+				auto& commands = aSrc ? details.mSrcCommands : details.mDstCommands;
+				commands.insert(std::end(commands), std::begin(aUsages.mCommandIndices), std::end(aUsages.mCommandIndices));
+				std::sort(std::begin(commands), std::end(commands));
+				commands.erase(std::unique(std::begin(commands), std::end(commands)), std::end(commands));
+				auto& includesUnspecified = aSrc ? details.mSrcIncludesUnspecified : details.mDstIncludesUnspecified;
+				includesUnspecified = includesUnspecified || aUsages.mIncludesUnspecified;
+				if (aStages) {
+					(aSrc ? details.mSpecifiedSrcStage : details.mSpecifiedDstStage) |= aUsages.mStages;
+				}
+				if (aAccesses) {
+					(aSrc ? details.mSpecifiedSrcAccess : details.mSpecifiedDstAccess) |= aUsages.mAccesses;
+				}
+			};
 
-					auto renderPassBeginInfo = vk::RenderPassBeginInfo()
-						.setRenderPass(lRenderPassHandle)
-						.setFramebuffer(lFramebufferHandle)
-						.setRenderArea(vk::Rect2D{}
-							.setOffset(vk::Offset2D{ aRenderAreaOffset.x, aRenderAreaOffset.y })
-							.setExtent(aRenderAreaExtent.has_value()
-										? vk::Extent2D{ aRenderAreaExtent.value() }
-										: vk::Extent2D{ lExtent.width, lExtent.height }
-								)
-							)
-						.setClearValueCount(static_cast<uint32_t>(lClearValues.size()))
-						.setPClearValues(lClearValues.data());
+			std::deque<nearby_sync_hint> nearbyHints;
+			std::unordered_map<uint64_t, tracked_resource_state> imageStates;
+			std::unordered_map<uint64_t, tracked_resource_state> bufferStates;
+
+			auto stateOf = [&imageStates, &bufferStates](const std::variant<vk::Image, vk::Buffer>& aResource) -> tracked_resource_state& {
+				return std::holds_alternative<vk::Image>(aResource)
+					? imageStates[resource_handle_key(std::get<vk::Image>(aResource))]
+					: bufferStates[resource_handle_key(std::get<vk::Buffer>(aResource))];
+			};
+
+			auto stateOfBarrierResource = [&imageStates, &bufferStates](const sync_type_command& aSyncCmd) -> tracked_resource_state& {
+				return aSyncCmd.is_image_memory_barrier()
+					? imageStates[resource_handle_key(aSyncCmd.image_memory_barrier_data().mImage)]
+					: bufferStates[resource_handle_key(aSyncCmd.buffer_memory_barrier_data().mBuffer)];
+			};
+
+			// Commands without a resource-specific sync hint for a resource might still access it. Therefore, it is tracked
+			// how many action_type_commands there are in total, and which one has been the most recent one:
+			int numActionCommands = 0;
+			int lastActionCommand = -1;
+
+			// Forward pass => resolves all the source scopes, determines which barriers are no-ops, and keeps track of image layouts:
+			for (int i = 0; i < n; ++i) {
+				const auto& recordee = aRecordedCommandsAndSyncInstructions[i];
+				if (std::holds_alternative<command::action_type_command>(recordee)) {
+					const auto& actionCmd = std::get<command::action_type_command>(recordee);
+					for (const auto& [res, resSyncHint] : actionCmd.mResourceSpecificSyncHints) {
+						auto& state = stateOf(res);
+						state.add(range_of(res, resSyncHint), resSyncHint.mSrcForSubsequentCmds, commandIndex(i));
+						state.count_hinting_command(i);
+					}
+					++numActionCommands;
+					lastActionCommand = i;
+					nearbyHints.push_front(nearby_sync_hint{ &actionCmd.mSyncHint, commandIndex(i) });
+					if (nearbyHints.size() > maxNearbyHints) {
+						nearbyHints.pop_back();
+					}
+				}
+				else if (std::holds_alternative<sync_type_command>(recordee)) {
+					const auto& syncCmd = std::get<sync_type_command>(recordee);
+					auto& scopes = mResolvedScopes[i];
+					if (syncCmd.is_image_memory_barrier() || syncCmd.is_buffer_memory_barrier()) {
+						auto& state = stateOfBarrierResource(syncCmd);
+						const auto barrierRange = range_of(syncCmd);
+						const bool hasLayoutTransition = syncCmd.is_image_memory_barrier() && syncCmd.image_memory_barrier_data().mLayoutTransition.has_value();
+						const bool hasOwnershipTransfer = syncCmd.queue_family_ownership_transfer().has_value();
+						const bool hasAutoSrcStage = std::holds_alternative<stage::auto_stage_t>(syncCmd.src_stage());
+						const bool hasAutoDstScopes = std::holds_alternative<stage::auto_stage_t>(syncCmd.dst_stage()) && std::holds_alternative<access::auto_access_t>(syncCmd.dst_access());
+
+						// A barrier is only skipped if its destination scopes are resolved automatically, too. Then, the covering barrier's
+						// destination scopes are going to be resolved w.r.t. all the usages which this barrier would have been resolved w.r.t.
+						// (The halves of split barriers are never skipped because the wait half would wait for an event which never gets set.)
+						if (hasAutoSrcStage && hasAutoDstScopes && !hasLayoutTransition && !hasOwnershipTransfer && !syncCmd.is_split_barrier_half() && state.is_synchronized(barrierRange, lastActionCommand)) {
+							// An earlier barrier covers this barrier's range, and no command at all has been recorded since => nothing to do.
+							scopes.mSrcStage  = vk::PipelineStageFlagBits2KHR::eNone;
+							scopes.mSrcAccess = vk::AccessFlagBits2KHR::eNone;
+							scopes.mIsNoOp = true;
+							continue;
+						}
+
+						auto [usages, bounds] = state.take_overlapping(barrierRange);
+						auto effectiveRange = barrierRange;
+						if (usages.has_value()) {
+							scopes.mSrcStage  = usages->stages();
+							scopes.mSrcAccess = usages->accesses(sFallbackSrcAccess);
+							recordDetails(i, usages.value(), true, true, true);
+
+							// Only the ranges which have actually been used must be made available. Restrict the barrier to these, but only if
+							// every action_type_command so far has specified a sync hint for this resource, because any other might have written to it:
+							const bool allCommandsHinted = state.mNumHintingCommands == numActionCommands;
+							if (hasAutoSrcStage && allCommandsHinted && !hasLayoutTransition && !hasOwnershipTransfer && !std::holds_alternative<std::monostate>(bounds) && !range_contains(bounds, barrierRange)) {
+								effectiveRange = intersect_ranges(barrierRange, bounds);
+								if (std::holds_alternative<vk::ImageSubresourceRange>(effectiveRange)) {
+									scopes.mNarrowedSubresourceRange = std::get<vk::ImageSubresourceRange>(effectiveRange);
+								}
+								else if (std::holds_alternative<std::tuple<vk::DeviceSize, vk::DeviceSize>>(effectiveRange)) {
+									scopes.mNarrowedOffsetAndSize = std::get<std::tuple<vk::DeviceSize, vk::DeviceSize>>(effectiveRange);
+								}
+							}
+						}
+						if (hasAutoDstScopes) {
+							// The destination scopes will be resolved to cover all subsequent usages => later barriers for the same range may become no-ops
+							state.mBarrierRanges.push_back(tracked_resource_state::covering_barrier{ effectiveRange, i });
+						}
+						else {
+							// Fixed destination scopes might not cover all subsequent usages => must not rely on earlier barriers anymore
+							std::erase_if(state.mBarrierRanges, [&barrierRange](const tracked_resource_state::covering_barrier& b) { return ranges_overlap(b.mRange, barrierRange); });
+						}
+
+						// The layout transition of a split barrier is tracked at its signal half only:
+						const bool isWaitHalf = syncCmd.is_split_barrier_half() && split_barrier_half::wait == syncCmd.split_barrier_event_data().mHalf;
+						if (hasLayoutTransition && !isWaitHalf) {
+							const auto imageSyncData = syncCmd.image_memory_barrier_data();
+							const auto key = resource_handle_key(imageSyncData.mImage);
+							const auto oldLayout = imageSyncData.mLayoutTransition.value().mOld.mLayout;
+							auto it = mLastKnownLayouts.find(key);
+							if (std::end(mLastKnownLayouts) != it && vk::ImageLayout::eUndefined != oldLayout && it->second != oldLayout) {
+								AVK_LOG_WARNING("Image layout transition from " + vk::to_string(oldLayout) + " recorded for an image which has been transitioned into " + vk::to_string(it->second) + " before.");
+							}
+							mLastKnownLayouts[key] = imageSyncData.mLayoutTransition.value().mNew.mLayout;
+						}
+					}
+					else if (!syncCmd.is_ill_formed()) {
+						const auto srcStage = syncCmd.src_stage();
+						if (std::holds_alternative<stage::auto_stage_t>(srcStage)) {
+							auto usages = accumulate_nearby_sync_hints(nearbyHints, std::get<stage::auto_stage_t>(srcStage), true);
+							if (usages.has_value()) {
+								scopes.mSrcStage = usages->stages();
+								recordDetails(i, usages.value(), true, true, false);
+							}
+						}
+						const auto srcAccess = syncCmd.src_access();
+						if (std::holds_alternative<access::auto_access_t>(srcAccess)) {
+							auto usages = accumulate_nearby_sync_hints(nearbyHints, std::get<access::auto_access_t>(srcAccess), true);
+							if (usages.has_value()) {
+								scopes.mSrcAccess = usages->accesses(sFallbackSrcAccess);
+								recordDetails(i, usages.value(), true, false, true);
+							}
+						}
+					}
+				}
+			}
+
+			nearbyHints.clear();
+			imageStates.clear();
+			bufferStates.clear();
+
+			// Backward pass => resolves all the destination scopes (barriers which are no-ops are not regarded):
+			for (int i = n - 1; i >= 0; --i) {
+				const auto& recordee = aRecordedCommandsAndSyncInstructions[i];
+				if (std::holds_alternative<command::action_type_command>(recordee)) {
+					const auto& actionCmd = std::get<command::action_type_command>(recordee);
+					for (const auto& [res, resSyncHint] : actionCmd.mResourceSpecificSyncHints) {
+						stateOf(res).add(range_of(res, resSyncHint), resSyncHint.mDstForPreviousCmds, commandIndex(i));
+					}
+					nearbyHints.push_front(nearby_sync_hint{ &actionCmd.mSyncHint, commandIndex(i) });
+					if (nearbyHints.size() > maxNearbyHints) {
+						nearbyHints.pop_back();
+					}
+				}
+				else if (std::holds_alternative<sync_type_command>(recordee)) {
+					const auto& syncCmd = std::get<sync_type_command>(recordee);
+					auto& scopes = mResolvedScopes[i];
+					if (scopes.mIsNoOp) {
+						continue;
+					}
+					if (syncCmd.is_image_memory_barrier() || syncCmd.is_buffer_memory_barrier()) {
+						auto [usages, bounds] = stateOfBarrierResource(syncCmd).take_overlapping(range_of(syncCmd));
+						if (usages.has_value()) {
+							scopes.mDstStage  = usages->stages();
+							scopes.mDstAccess = usages->accesses(sFallbackDstAccess);
+							recordDetails(i, usages.value(), false, true, true);
+						}
+					}
+					else if (!syncCmd.is_ill_formed()) {
+						const auto dstStage = syncCmd.dst_stage();
+						if (std::holds_alternative<stage::auto_stage_t>(dstStage)) {
+							auto usages = accumulate_nearby_sync_hints(nearbyHints, std::get<stage::auto_stage_t>(dstStage), false);
+							if (usages.has_value()) {
+								scopes.mDstStage = usages->stages();
+								recordDetails(i, usages.value(), false, true, false);
+							}
+						}
+						const auto dstAccess = syncCmd.dst_access();
+						if (std::holds_alternative<access::auto_access_t>(dstAccess)) {
+							auto usages = accumulate_nearby_sync_hints(nearbyHints, std::get<access::auto_access_t>(dstAccess), false);
+							if (usages.has_value()) {
+								scopes.mDstAccess = usages->accesses(sFallbackDstAccess);
+								recordDetails(i, usages.value(), false, false, true);
+							}
+						}
+					}
+				}
+			}
+
+			// Both halves of a split barrier must establish exactly the same dependency. Therefore, combine the source scopes
+			// which have been resolved for the signal half with the destination scopes which have been resolved for the wait half:
+			std::unordered_map<uint64_t, int> pendingSignalHalves;
+			for (int i = 0; i < n; ++i) {
+				if (!std::holds_alternative<sync_type_command>(aRecordedCommandsAndSyncInstructions[i])) {
+					continue;
+				}
+				const auto& syncCmd = std::get<sync_type_command>(aRecordedCommandsAndSyncInstructions[i]);
+				if (!syncCmd.is_split_barrier_half()) {
+					continue;
+				}
+				const auto eventData = syncCmd.split_barrier_event_data();
+				const auto key = resource_handle_key(eventData.mEvent);
+				if (split_barrier_half::signal == eventData.mHalf) {
+					pendingSignalHalves[key] = i;
+					continue;
+				}
+				auto it = pendingSignalHalves.find(key);
+				if (std::end(pendingSignalHalves) == it) {
+					AVK_LOG_WARNING("The wait half of a split barrier has been recorded without a preceding signal half for the same event. Make sure that the event is set in a previous submission to the same queue.");
+					continue;
+				}
+				auto combined = mResolvedScopes[it->second];
+				combined.mDstStage  = mResolvedScopes[i].mDstStage;
+				combined.mDstAccess = mResolvedScopes[i].mDstAccess;
+				mResolvedScopes[it->second] = combined;
+				mResolvedScopes[i] = std::move(combined);
+				if (!mResolutionDetails.empty()) {
+					auto combinedDetails = mResolutionDetails[it->second];
+					combinedDetails.mDstCommands            = mResolutionDetails[i].mDstCommands;
+					combinedDetails.mDstIncludesUnspecified = mResolutionDetails[i].mDstIncludesUnspecified;
+					combinedDetails.mSpecifiedDstStage      = mResolutionDetails[i].mSpecifiedDstStage;
+					combinedDetails.mSpecifiedDstAccess     = mResolutionDetails[i].mSpecifiedDstAccess;
+					mResolutionDetails[it->second] = combinedDetails;
+					mResolutionDetails[i] = std::move(combinedDetails);
+				}
+				pendingSignalHalves.erase(it);
+			}
+		}
+
+		const resolved_sync_scopes& resource_state_tracker::scopes_at(int aRecordedStuffIndex) const
+		{
+			static const resolved_sync_scopes sUnresolved{};
+			if (aRecordedStuffIndex < 0 || aRecordedStuffIndex >= static_cast<int>(mResolvedScopes.size())) {
+				return sUnresolved;
+			}
+			return mResolvedScopes[aRecordedStuffIndex];
+		}
+
+		const scope_resolution_details* resource_state_tracker::resolution_details_at(int aRecordedStuffIndex) const
+		{
+			if (aRecordedStuffIndex < 0 || aRecordedStuffIndex >= static_cast<int>(mResolutionDetails.size())) {
+				return nullptr;
+			}
+			return &mResolutionDetails[aRecordedStuffIndex];
+		}
+
+		std::optional<vk::ImageLayout> resource_state_tracker::last_known_layout(vk::Image aImage) const
+		{
+			auto it = mLastKnownLayouts.find(resource_handle_key(aImage));
+			if (std::end(mLastKnownLayouts) == it) {
+				return {};
+			}
+			return it->second;
+		}
+	}
+
+	// Internal helper: The stages and accesses of a barrier after all auto_stage/auto_access parts have been resolved
+	struct resolved_barrier_masks
+	{
+		vk::PipelineStageFlags2KHR mSrcStage;
+		vk::AccessFlags2KHR mSrcAccess;
+		vk::PipelineStageFlags2KHR mDstStage;
+		vk::AccessFlags2KHR mDstAccess;
+	};
+
+	// Internal helper function which resolves the stages and accesses of a barrier. 
+	// Wherever auto_stage/auto_access could not be resolved to something specific, heavy fallbacks are used to ensure correctness.
+	inline static resolved_barrier_masks resolve_barrier_masks(const sync::sync_type_command& aBarrierData, const sync::resource_state_tracker& aResourceStateTracker, int aRecordedStuffIndex)
+	{
+		const auto& resolved = aResourceStateTracker.scopes_at(aRecordedStuffIndex);
+		resolved_barrier_masks result;
+
+		// Handle source stage:
+		std::visit(lambda_overload{
+			[&result           ](const std::monostate&){
+				result.mSrcStage = vk::PipelineStageFlagBits2KHR::eNone;
+			},
+			[&result           ](const vk::PipelineStageFlags2KHR& bFixedStage){
+				result.mSrcStage = bFixedStage;
+			},
+			[&result, &resolved](const avk::stage::auto_stage_t&){
+				result.mSrcStage = resolved.mSrcStage.value_or(sFallbackStages);
+			},
+		}, aBarrierData.src_stage());
+
+		// Handle destination stage:
+		std::visit(lambda_overload{
+			[&result           ](const std::monostate&){
+				result.mDstStage = vk::PipelineStageFlagBits2KHR::eNone;
+			},
+			[&result           ](const vk::PipelineStageFlags2KHR& bFixedStage){
+				result.mDstStage = bFixedStage;
+			},
+			[&result, &resolved](const avk::stage::auto_stage_t&){
+				result.mDstStage = resolved.mDstStage.value_or(sFallbackStages);
+			},
+		}, aBarrierData.dst_stage());
+
+		// Handle source access:
+		std::visit(lambda_overload{
+			[&result           ](const std::monostate&){
+				result.mSrcAccess = vk::AccessFlagBits2KHR::eNone;
+			},
+			[&result           ](const vk::AccessFlags2KHR& bFixedAccess){
+				result.mSrcAccess = bFixedAccess;
+			},
+			[&result, &resolved](const avk::access::auto_access_t&){
+				result.mSrcAccess = resolved.mSrcAccess.value_or(sFallbackSrcAccess);
+			},
+		}, aBarrierData.src_access());
+
+		// Handle destination access:
+		std::visit(lambda_overload{
+			[&result           ](const std::monostate&){
+				result.mDstAccess = vk::AccessFlagBits2KHR::eNone;
+			},
+			[&result           ](const vk::AccessFlags2KHR& bFixedAccess){
+				result.mDstAccess = bFixedAccess;
+			},
+			[&result, &resolved](const avk::access::auto_access_t&){
+				result.mDstAccess = resolved.mDstAccess.value_or(sFallbackDstAccess);
+			},
+		}, aBarrierData.dst_access());
+
+		return result;
+	}
+
+	// Internal helper function which returns a copy of the given barrier where all auto_stage/auto_access parts have been replaced
+	// by the masks they have been resolved to, and whose range has been narrowed to the range which has actually been used.
+	// The copy establishes the same dependency as the original, but it can be recorded without a resource_state_tracker.
+	inline static sync::sync_type_command with_resolved_scopes(const sync::sync_type_command& aSyncCmd, const sync::resource_state_tracker& aResourceStateTracker, int aRecordedStuffIndex)
+	{
+		const auto masks = resolve_barrier_masks(aSyncCmd, aResourceStateTracker, aRecordedStuffIndex);
+		const auto& resolved = aResourceStateTracker.scopes_at(aRecordedStuffIndex);
+
+		auto result = aSyncCmd;
+		result.with_stages(avk::stage::execution_dependency{ masks.mSrcStage, masks.mDstStage });
+		if (!aSyncCmd.is_global_execution_barrier()) {
+			result.with_memory_access(avk::access::memory_dependency{ masks.mSrcAccess, masks.mDstAccess });
+		}
+		if (resolved.mNarrowedSubresourceRange.has_value()) {
+			result.for_subresource_range(resolved.mNarrowedSubresourceRange.value());
+		}
+		if (resolved.mNarrowedOffsetAndSize.has_value()) {
+			result.for_offset_and_size(std::get<0>(resolved.mNarrowedOffsetAndSize.value()), std::get<1>(resolved.mNarrowedOffsetAndSize.value()));
+		}
+		return result;
+	}
+
+	// Internal helper function to assemble all the data for a barrier, based on:
+	//  - A given sync_type_command (aBarrierData)
+	//  - The scopes which the resource_state_tracker has resolved for it (if it contains auto_stage/auto_access parts)
+	template <typename T>
+	inline static T assemble_barrier_data(
+		const sync::sync_type_command& aBarrierData, 
+		const sync::resource_state_tracker& aResourceStateTracker,
+		int aRecordedStuffIndex
+	) {
+		// Sanity check: Does T and aBarrierData fit together?
+		assert(
+			   (std::is_same_v<T, vk::MemoryBarrier2KHR>       && (aBarrierData.is_global_execution_barrier() || aBarrierData.is_global_memory_barrier()))
+			|| (std::is_same_v<T, vk::ImageMemoryBarrier2KHR>  && (aBarrierData.is_image_memory_barrier()                                               ))
+			|| (std::is_same_v<T, vk::BufferMemoryBarrier2KHR> && (aBarrierData.is_buffer_memory_barrier()                                              ))
+		);
+
+		// We're definitely going to establish a barrier:
+		auto barrier = T{};
+
+		// If the auto_stage/auto_access parts could not be resolved to something specific, employ heavy barriers to ensure correctness:
+		const auto& resolved = aResourceStateTracker.scopes_at(aRecordedStuffIndex);
+		const auto masks = resolve_barrier_masks(aBarrierData, aResourceStateTracker, aRecordedStuffIndex);
+		barrier.setSrcStageMask(masks.mSrcStage);
+		barrier.setDstStageMask(masks.mDstStage);
+		barrier.setSrcAccessMask(masks.mSrcAccess);
+		barrier.setDstAccessMask(masks.mDstAccess);
+
+		// For T = vk::MemoryBarrier2KHR, we are done.
+		// But for image memory barriers or buffer memory barriers, there could be more sync data to be filled-in:
+		
+		if constexpr (std::is_same_v<T, vk::ImageMemoryBarrier2KHR>) {
+			auto imageSyncData = aBarrierData.image_memory_barrier_data();
+
+			barrier.setImage(imageSyncData.mImage);
+			barrier.setSubresourceRange(resolved.mNarrowedSubresourceRange.value_or(imageSyncData.mSubresourceRange));
+
+			// Specification goes like this:
+			// > When the old and new layout are equal, the layout values are ignored - data is preserved
+			// > no matter what values are specified, or what layout the image is currently in.
+			if (imageSyncData.mLayoutTransition.has_value()) {
+				barrier.setOldLayout(imageSyncData.mLayoutTransition.value().mOld.mLayout);
+				barrier.setNewLayout(imageSyncData.mLayoutTransition.value().mNew.mLayout);
+			}
+			// else leave both set to 0 which corresponds to eUndefined -> eUndefined, a.k.a. no layout transition
+		}
+
+		if constexpr (std::is_same_v<T, vk::BufferMemoryBarrier2KHR>) {
+			auto bufferSyncData = aBarrierData.buffer_memory_barrier_data();
+			barrier.setBuffer(bufferSyncData.mBuffer);
+			if (resolved.mNarrowedOffsetAndSize.has_value()) {
+				barrier.setOffset(std::get<0>(resolved.mNarrowedOffsetAndSize.value()));
+				barrier.setSize(std::get<1>(resolved.mNarrowedOffsetAndSize.value()));
+			}
+			else {
+				barrier.setOffset(bufferSyncData.mOffset);
+				barrier.setSize(bufferSyncData.mSize);
+			}
+		}
 
+		// For both, buffer memory barriers and image memory barriers, queue family o	wnership transfers are relevant:
+		if constexpr (std::is_same_v<T, vk::ImageMemoryBarrier2KHR> || std::is_same_v<T, vk::BufferMemoryBarrier2KHR>) {
+			auto qfot = aBarrierData.queue_family_ownership_transfer();
+			barrier.setSrcQueueFamilyIndex(qfot.has_value() ? qfot.value().mSrcQueueFamilyIndex : VK_QUEUE_FAMILY_IGNORED);
+			barrier.setDstQueueFamilyIndex(qfot.has_value() ? qfot.value().mDstQueueFamilyIndex : VK_QUEUE_FAMILY_IGNORED);
+		}
+
+		return barrier;
+	}
+
+	inline static void record_into_command_buffer(command_buffer_t& aCommandBuffer, 
 #ifdef AVK_USE_SYNCHRONIZATION2_INSTEAD_OF_CORE
-					cb.handle().beginRenderPass2KHR(
-						renderPassBeginInfo,
-						vk::SubpassBeginInfo{ aSubpassesInline ? vk::SubpassContents::eInline : vk::SubpassContents::eSecondaryCommandBuffers },
-						lRoot->dispatch_loader_ext()
-					);
+		const DISPATCH_LOADER_EXT_TYPE& aDispatchLoaderExt,
 #else
-					cb.handle().beginRenderPass2(
-						renderPassBeginInfo,
-						vk::SubpassBeginInfo{ aSubpassesInline ? vk::SubpassContents::eInline : vk::SubpassContents::eSecondaryCommandBuffers },
-						lRoot->dispatch_loader_core()
-					);
+		const DISPATCH_LOADER_CORE_TYPE& aDispatchLoaderCore,
 #endif
-				}
-			};
+		const command::state_type_command& aStateCmd)
+	{
+		if (aStateCmd.mFun) {
+			aStateCmd.mFun(aCommandBuffer);
+		}
+	}
+
+	inline static void record_into_command_buffer(command_buffer_t& aCommandBuffer,
+#ifdef AVK_USE_SYNCHRONIZATION2_INSTEAD_OF_CORE
+		const DISPATCH_LOADER_EXT_TYPE& aDispatchLoaderExt,
+#else
+		const DISPATCH_LOADER_CORE_TYPE& aDispatchLoaderCore,
+#endif
+		const command::action_type_command& aActionCmd,
+		uint32_t& aNumPipelineBarrierCallsSaved)
+	{
+		if (aActionCmd.mBeginFun) {
+			aActionCmd.mBeginFun(aCommandBuffer);
+		}
+		if (!aActionCmd.mNestedCommandsAndSyncInstructions.empty()) {
+			record_into_command_buffer(aCommandBuffer, 
+#ifdef AVK_USE_SYNCHRONIZATION2_INSTEAD_OF_CORE
+				aDispatchLoaderExt,
+#else
+				aDispatchLoaderCore,
+#endif
+				aActionCmd.mNestedCommandsAndSyncInstructions, aNumPipelineBarrierCallsSaved);
+		}
+		if (aActionCmd.mEndFun) {
+			aActionCmd.mEndFun(aCommandBuffer);
+		}
+	}
+
+	// Internal helper function which records the dependency of one or multiple barriers: Either as a pipeline barrier, or, if
+	// aSyncCmd is one half of a split barrier, by setting the event (signal half), or by waiting for and then resetting the event (wait half).
+	inline static void record_dependency_into_command_buffer(
+		command_buffer_t& aCommandBuffer,
+#ifdef AVK_USE_SYNCHRONIZATION2_INSTEAD_OF_CORE
+		const DISPATCH_LOADER_EXT_TYPE& aDispatchLoaderExt,
+#else
+		const DISPATCH_LOADER_CORE_TYPE& aDispatchLoaderCore,
+#endif
+		const sync::sync_type_command& aSyncCmd,
+		const vk::DependencyInfoKHR& aDependencyInfo)
+	{
+		if (!aSyncCmd.is_split_barrier_half()) {
+#ifdef AVK_USE_SYNCHRONIZATION2_INSTEAD_OF_CORE
+			aCommandBuffer.handle().pipelineBarrier2KHR(aDependencyInfo, aDispatchLoaderExt);
+#else
+			aCommandBuffer.handle().pipelineBarrier2(aDependencyInfo, aDispatchLoaderCore);
+#endif
+			return;
+		}
+
+		const auto eventData = aSyncCmd.split_barrier_event_data();
+		if (sync::split_barrier_half::signal == eventData.mHalf) {
+#ifdef AVK_USE_SYNCHRONIZATION2_INSTEAD_OF_CORE
+			aCommandBuffer.handle().setEvent2KHR(eventData.mEvent, aDependencyInfo, aDispatchLoaderExt);
+#else
+			aCommandBuffer.handle().setEvent2(eventData.mEvent, aDependencyInfo, aDispatchLoaderCore);
+#endif
+			return;
+		}
+
+		// Reset the event once the waiting stages have passed, s.t. it can be set again by subsequent submissions:
+		vk::PipelineStageFlags2KHR waitingStages{};
+		for (uint32_t i = 0; i < aDependencyInfo.memoryBarrierCount; ++i) {
+			waitingStages |= aDependencyInfo.pMemoryBarriers[i].dstStageMask;
+		}
+		for (uint32_t i = 0; i < aDependencyInfo.imageMemoryBarrierCount; ++i) {
+			waitingStages |= aDependencyInfo.pImageMemoryBarriers[i].dstStageMask;
+		}
+		for (uint32_t i = 0; i < aDependencyInfo.bufferMemoryBarrierCount; ++i) {
+			waitingStages |= aDependencyInfo.pBufferMemoryBarriers[i].dstStageMask;
+		}
+		if (!waitingStages) {
+			waitingStages = vk::PipelineStageFlagBits2KHR::eAllCommands;
+		}
+#ifdef AVK_USE_SYNCHRONIZATION2_INSTEAD_OF_CORE
+		aCommandBuffer.handle().waitEvents2KHR(1u, &eventData.mEvent, &aDependencyInfo, aDispatchLoaderExt);
+		aCommandBuffer.handle().resetEvent2KHR(eventData.mEvent, waitingStages, aDispatchLoaderExt);
+#else
+		aCommandBuffer.handle().waitEvents2(1u, &eventData.mEvent, &aDependencyInfo, aDispatchLoaderCore);
+		aCommandBuffer.handle().resetEvent2(eventData.mEvent, waitingStages, aDispatchLoaderCore);
+#endif
+	}
+
+	inline static void record_into_command_buffer(
+		command_buffer_t& aCommandBuffer, 
+#ifdef AVK_USE_SYNCHRONIZATION2_INSTEAD_OF_CORE
+		const DISPATCH_LOADER_EXT_TYPE& aDispatchLoaderExt,
+#else
+		const DISPATCH_LOADER_CORE_TYPE& aDispatchLoaderCore,
+#endif
+		const sync::sync_type_command& aSyncCmd, 
+		const sync::resource_state_tracker& aResourceStateTracker, 
+		int aRecordedStuffIndex)
+	{
+		if (aSyncCmd.is_global_execution_barrier() || aSyncCmd.is_global_memory_barrier()) {
+			auto barrier = assemble_barrier_data<vk::MemoryBarrier2KHR>(aSyncCmd, aResourceStateTracker, aRecordedStuffIndex);
+			auto dependencyInfo = vk::DependencyInfoKHR{}
+				.setMemoryBarrierCount(1u)
+				.setPMemoryBarriers(&barrier);
+			record_dependency_into_command_buffer(aCommandBuffer,
+#ifdef AVK_USE_SYNCHRONIZATION2_INSTEAD_OF_CORE
+				aDispatchLoaderExt,
+#else
+				aDispatchLoaderCore,
+#endif
+				aSyncCmd, dependencyInfo);
+		}
+		else if (aSyncCmd.is_image_memory_barrier()) {
+			auto barrier = assemble_barrier_data<vk::ImageMemoryBarrier2KHR>(aSyncCmd, aResourceStateTracker, aRecordedStuffIndex);
+			auto dependencyInfo = vk::DependencyInfoKHR{}
+				.setImageMemoryBarrierCount(1u)
+				.setPImageMemoryBarriers(&barrier);
+			record_dependency_into_command_buffer(aCommandBuffer,
+#ifdef AVK_USE_SYNCHRONIZATION2_INSTEAD_OF_CORE
+				aDispatchLoaderExt,
+#else
+				aDispatchLoaderCore,
+#endif
+				aSyncCmd, dependencyInfo);
+		}
+		else if (aSyncCmd.is_buffer_memory_barrier()) {
+			auto barrier = assemble_barrier_data<vk::BufferMemoryBarrier2KHR>(aSyncCmd, aResourceStateTracker, aRecordedStuffIndex);
+			auto dependencyInfo = vk::DependencyInfoKHR{}
+				.setBufferMemoryBarrierCount(1u)
+				.setPBufferMemoryBarriers(&barrier);
+			record_dependency_into_command_buffer(aCommandBuffer,
+#ifdef AVK_USE_SYNCHRONIZATION2_INSTEAD_OF_CORE
+				aDispatchLoaderExt,
+#else
+				aDispatchLoaderCore,
+#endif
+				aSyncCmd, dependencyInfo);
+		}
+	}
+
+	// Internal helper function for stage_masks_may_overlap: Adds the individual stages to the bits which stand for groups of stages.
+	inline static vk::PipelineStageFlags2KHR expand_stage_groups(vk::PipelineStageFlags2KHR aStages)
+	{
+		if (aStages & vk::PipelineStageFlagBits2KHR::eAllTransfer) {
+			aStages |= vk::PipelineStageFlagBits2KHR::eCopy | vk::PipelineStageFlagBits2KHR::eBlit | vk::PipelineStageFlagBits2KHR::eClear | vk::PipelineStageFlagBits2KHR::eResolve;
+		}
+		if (aStages & vk::PipelineStageFlagBits2KHR::ePreRasterizationShaders) {
+			aStages |= vk::PipelineStageFlagBits2KHR::eVertexShader | vk::PipelineStageFlagBits2KHR::eTessellationControlShader | vk::PipelineStageFlagBits2KHR::eTessellationEvaluationShader | vk::PipelineStageFlagBits2KHR::eGeometryShader
+				| std::get<vk::PipelineStageFlags2KHR>(stage::task_shader.mFlags) | std::get<vk::PipelineStageFlags2KHR>(stage::mesh_shader.mFlags);
+		}
+		if (aStages & vk::PipelineStageFlagBits2KHR::eVertexInput) {
+			aStages |= vk::PipelineStageFlagBits2KHR::eIndexInput | vk::PipelineStageFlagBits2KHR::eVertexAttributeInput;
+		}
+		return aStages;
+	}
+
+	// Internal helper function which determines whether two stage masks could refer to (partly) the same pipeline stages.
+	// Meta stages like eAllCommands or eAllGraphics are conservatively treated as overlapping with everything, and bits which
+	// stand for groups of stages (like eAllTransfer or ePreRasterizationShaders) overlap with each of their stages.
+	inline static bool stage_masks_may_overlap(vk::PipelineStageFlags2KHR aFirst, vk::PipelineStageFlags2KHR aSecond)
+	{
+		if (!aFirst || !aSecond) {
+			return false;
+		}
+		const auto metaStages = vk::PipelineStageFlagBits2KHR::eAllCommands | vk::PipelineStageFlagBits2KHR::eAllGraphics | vk::PipelineStageFlagBits2KHR::eTopOfPipe | vk::PipelineStageFlagBits2KHR::eBottomOfPipe;
+		if ((aFirst & metaStages) || (aSecond & metaStages)) {
+			return true;
+		}
+		return static_cast<bool>(expand_stage_groups(aFirst) & expand_stage_groups(aSecond));
+	}
+
+	// Internal helper function which determines whether the given recorded command is a barrier which can be batched with
+	// adjacent barriers into one vkCmdPipelineBarrier2 call. This is the case for all barriers except the halves of split barriers.
+	inline static bool is_batchable_barrier(const recorded_commands_t& aRecordee)
+	{
+		return std::holds_alternative<sync::sync_type_command>(aRecordee) && !std::get<sync::sync_type_command>(aRecordee).is_split_barrier_half();
+	}
+
+	// Gathers the memory, image memory, and buffer memory barriers of the consecutive sync_type_commands in the range
+	// [aBeginIndex, aEndIndex) of aRecordedCommandsAndSyncInstructions into as few batches as possible, and passes each batch
+	// to aFlushBatch(memoryBarriers, imageMemoryBarriers, bufferMemoryBarriers) which is supposed to record one vkCmdPipelineBarrier2 call.
+	// All barriers passed to the same call are executed "at once". Therefore, a new batch is started whenever merging would alter
+	// the semantics, namely if a barrier's source stages could chain with the destination stages of a barrier of the current
+	// batch, or if a resource is affected by more than one barrier of the current batch (e.g., subsequent layout transitions).
+	// Returns the number of vkCmdPipelineBarrier2 calls saved compared to recording one call per barrier.
+	template <typename F>
+	inline static uint32_t batch_barriers(
+		const std::vector<recorded_commands_t>& aRecordedCommandsAndSyncInstructions,
+		const sync::resource_state_tracker& aResourceStateTracker,
+		int aBeginIndex,
+		int aEndIndex,
+		F&& aFlushBatch)
+	{
+		std::vector<vk::MemoryBarrier2KHR> memoryBarriers;
+		std::vector<vk::ImageMemoryBarrier2KHR> imageMemoryBarriers;
+		std::vector<vk::BufferMemoryBarrier2KHR> bufferMemoryBarriers;
+		vk::PipelineStageFlags2KHR batchDstStages{};
+		uint32_t numBarriers = 0u;
+		uint32_t numCalls = 0u;
+
+		auto flushBatch = [&]() {
+			if (memoryBarriers.empty() && imageMemoryBarriers.empty() && bufferMemoryBarriers.empty()) {
+				return;
+			}
+			aFlushBatch(std::as_const(memoryBarriers), std::as_const(imageMemoryBarriers), std::as_const(bufferMemoryBarriers));
+			++numCalls;
+			memoryBarriers.clear();
+			imageMemoryBarriers.clear();
+			bufferMemoryBarriers.clear();
+			batchDstStages = vk::PipelineStageFlags2KHR{};
+		};
+
+		for (int i = aBeginIndex; i < aEndIndex; ++i) {
+			assert(std::holds_alternative<sync::sync_type_command>(aRecordedCommandsAndSyncInstructions[i]));
+			const auto& syncCmd = std::get<sync::sync_type_command>(aRecordedCommandsAndSyncInstructions[i]);
+			if (aResourceStateTracker.scopes_at(i).mIsNoOp) {
+				continue;
+			}
+
+			if (syncCmd.is_global_execution_barrier() || syncCmd.is_global_memory_barrier()) {
+				auto barrier = assemble_barrier_data<vk::MemoryBarrier2KHR>(syncCmd, aResourceStateTracker, i);
+				if (stage_masks_may_overlap(batchDstStages, barrier.srcStageMask)) {
+					flushBatch();
+				}
+				batchDstStages |= barrier.dstStageMask;
+				memoryBarriers.push_back(barrier);
+			}
+			else if (syncCmd.is_image_memory_barrier()) {
+				auto barrier = assemble_barrier_data<vk::ImageMemoryBarrier2KHR>(syncCmd, aResourceStateTracker, i);
+				const bool sameImageInBatch = std::any_of(std::begin(imageMemoryBarriers), std::end(imageMemoryBarriers), [&barrier](const vk::ImageMemoryBarrier2KHR& b) {
+					return b.image == barrier.image;
+				});
+				if (sameImageInBatch || stage_masks_may_overlap(batchDstStages, barrier.srcStageMask)) {
+					flushBatch();
+				}
+				batchDstStages |= barrier.dstStageMask;
+				imageMemoryBarriers.push_back(barrier);
+			}
+			else if (syncCmd.is_buffer_memory_barrier()) {
+				auto barrier = assemble_barrier_data<vk::BufferMemoryBarrier2KHR>(syncCmd, aResourceStateTracker, i);
+				const bool sameBufferInBatch = std::any_of(std::begin(bufferMemoryBarriers), std::end(bufferMemoryBarriers), [&barrier](const vk::BufferMemoryBarrier2KHR& b) {
+					return b.buffer == barrier.buffer;
+				});
+				if (sameBufferInBatch || stage_masks_may_overlap(batchDstStages, barrier.srcStageMask)) {
+					flushBatch();
+				}
+				batchDstStages |= barrier.dstStageMask;
+				bufferMemoryBarriers.push_back(barrier);
+			}
+			else {
+				continue; // Ill-formed sync_type_commands are not recorded at all.
+			}
+			++numBarriers;
+		}
+		flushBatch();
+
+		return numBarriers - numCalls;
+	}
+
+	// Records the consecutive sync_type_commands in the range [aBeginIndex, aEndIndex) of aRecordedCommandsAndSyncInstructions
+	// into as few vkCmdPipelineBarrier2 calls as possible, i.e., all their memory, image memory, and buffer memory barriers are
+	// gathered into the arrays of one vk::DependencyInfoKHR (see batch_barriers).
+	// Returns the number of vkCmdPipelineBarrier2 calls saved compared to recording one call per barrier.
+	inline static uint32_t record_batched_barriers_into_command_buffer(
+		command_buffer_t& aCommandBuffer,
+#ifdef AVK_USE_SYNCHRONIZATION2_INSTEAD_OF_CORE
+		const DISPATCH_LOADER_EXT_TYPE& aDispatchLoaderExt,
+#else
+		const DISPATCH_LOADER_CORE_TYPE& aDispatchLoaderCore,
+#endif
+		const std::vector<recorded_commands_t>& aRecordedCommandsAndSyncInstructions,
+		const sync::resource_state_tracker& aResourceStateTracker,
+		int aBeginIndex,
+		int aEndIndex)
+	{
+		return batch_barriers(aRecordedCommandsAndSyncInstructions, aResourceStateTracker, aBeginIndex, aEndIndex, [&](
+			const std::vector<vk::MemoryBarrier2KHR>& bMemoryBarriers,
+			const std::vector<vk::ImageMemoryBarrier2KHR>& bImageMemoryBarriers,
+			const std::vector<vk::BufferMemoryBarrier2KHR>& bBufferMemoryBarriers
+		) {
+			auto dependencyInfo = vk::DependencyInfoKHR{}
+				.setMemoryBarrierCount(static_cast<uint32_t>(bMemoryBarriers.size()))
+				.setPMemoryBarriers(bMemoryBarriers.data())
+				.setImageMemoryBarrierCount(static_cast<uint32_t>(bImageMemoryBarriers.size()))
+				.setPImageMemoryBarriers(bImageMemoryBarriers.data())
+				.setBufferMemoryBarrierCount(static_cast<uint32_t>(bBufferMemoryBarriers.size()))
+				.setPBufferMemoryBarriers(bBufferMemoryBarriers.data());
+#ifdef AVK_USE_SYNCHRONIZATION2_INSTEAD_OF_CORE
+			aCommandBuffer.handle().pipelineBarrier2KHR(dependencyInfo, aDispatchLoaderExt);
+#else
+			aCommandBuffer.handle().pipelineBarrier2(dependencyInfo, aDispatchLoaderCore);
+#endif
+		});
+	}
+
+	void command_buffer_t::record(const avk::command::state_type_command& aToBeRecorded)
+	{
+		record_into_command_buffer(*this,
+#ifdef AVK_USE_SYNCHRONIZATION2_INSTEAD_OF_CORE
+			root_ptr()->dispatch_loader_ext(), 
+#else
+			root_ptr()->dispatch_loader_core(),
+#endif
+			aToBeRecorded);
+	}
+
+	void command_buffer_t::record(const avk::command::action_type_command& aToBeRecorded)
+	{
+		uint32_t numPipelineBarrierCallsSaved = 0u;
+		record_into_command_buffer(*this,
+#ifdef AVK_USE_SYNCHRONIZATION2_INSTEAD_OF_CORE
+			root_ptr()->dispatch_loader_ext(),
+#else
+			root_ptr()->dispatch_loader_core(),
+#endif
+			aToBeRecorded, numPipelineBarrierCallsSaved);
+	}
+
+	void command_buffer_t::record(const avk::sync::sync_type_command& aToBeRecorded)
+	{
+		record_into_command_buffer(*this,
+#ifdef AVK_USE_SYNCHRONIZATION2_INSTEAD_OF_CORE
+			root_ptr()->dispatch_loader_ext(),
+#else
+			root_ptr()->dispatch_loader_core(),
+#endif
+			aToBeRecorded, sync::resource_state_tracker{}, 0);
+	}
+
+	void command_buffer_t::record(std::vector<avk::recorded_commands_t> aRecordedCommandsAndSyncInstructions)
+	{
+		avk::recorded_commands{ root_ptr(), std::move(aRecordedCommandsAndSyncInstructions) }
+			.into_command_buffer(*this, false); // Last parameter: do not call begin/end here!
+	}
+
+	struct recordee_visitors
+	{
+		void operator()(const command::state_type_command& vStateCmd) const {
+			record_into_command_buffer(mCommandBuffer, 
+#ifdef AVK_USE_SYNCHRONIZATION2_INSTEAD_OF_CORE
+				mDispatchLoaderExt, 
+#else
+				mDispatchLoaderCore,
+#endif
+				vStateCmd);
+		}
+		void operator()(const command::action_type_command& vActionCmd) const {
+			record_into_command_buffer(mCommandBuffer,
+#ifdef AVK_USE_SYNCHRONIZATION2_INSTEAD_OF_CORE
+				mDispatchLoaderExt,
+#else
+				mDispatchLoaderCore,
+#endif
+				vActionCmd, mNumPipelineBarrierCallsSaved);
+			
+		}
+		void operator()(const sync::sync_type_command& vSyncCmd) const {
+			record_into_command_buffer(mCommandBuffer,
+#ifdef AVK_USE_SYNCHRONIZATION2_INSTEAD_OF_CORE
+				mDispatchLoaderExt,
+#else
+				mDispatchLoaderCore,
+#endif
+				vSyncCmd, *mResourceStateTracker, mCurrentIndexIntoRecordedStuff);
+		}
+
+		command_buffer_t& mCommandBuffer;
+#ifdef AVK_USE_SYNCHRONIZATION2_INSTEAD_OF_CORE
+		const DISPATCH_LOADER_EXT_TYPE& mDispatchLoaderExt;
+#else
+		const DISPATCH_LOADER_CORE_TYPE& mDispatchLoaderCore;
+#endif
+		const sync::resource_state_tracker* mResourceStateTracker;
+		int mCurrentIndexIntoRecordedStuff;
+		uint32_t& mNumPipelineBarrierCallsSaved;
+	};
+	
+	// Records the range [aBeginIndex, aEndIndex) of the given list of recorded commands, whose barriers have been resolved by aResourceStateTracker:
+	inline static void record_range_into_command_buffer(
+		command_buffer_t& aCommandBuffer, 
+#ifdef AVK_USE_SYNCHRONIZATION2_INSTEAD_OF_CORE
+		const DISPATCH_LOADER_EXT_TYPE& aDispatchLoaderExt,
+#else
+		const DISPATCH_LOADER_CORE_TYPE& aDispatchLoaderCore,
+#endif
+		const std::vector<recorded_commands_t>& aRecordedCommandsAndSyncInstructions,
+		const sync::resource_state_tracker* aResourceStateTracker,
+		int aBeginIndex,
+		int aEndIndex,
+		uint32_t& aNumPipelineBarrierCallsSaved)
+	{
+		recordee_visitors visitState{ aCommandBuffer, 
+#ifdef AVK_USE_SYNCHRONIZATION2_INSTEAD_OF_CORE
+			aDispatchLoaderExt,
+#else
+			aDispatchLoaderCore,
+#endif
+			aResourceStateTracker, /* Current index: */ aBeginIndex, aNumPipelineBarrierCallsSaved };
+		
+		for (int i = aBeginIndex; i < aEndIndex; ++i) {
+			// Runs of consecutive sync_type_commands are recorded in as few vkCmdPipelineBarrier2 calls as possible
+			// (the halves of split barriers are recorded individually, see record_dependency_into_command_buffer):
+			if (is_batchable_barrier(aRecordedCommandsAndSyncInstructions[i])) {
+				assert(nullptr != aResourceStateTracker);
+				int runEnd = i + 1;
+				while (runEnd < aEndIndex && is_batchable_barrier(aRecordedCommandsAndSyncInstructions[runEnd])) {
+					++runEnd;
+				}
+				aNumPipelineBarrierCallsSaved += record_batched_barriers_into_command_buffer(aCommandBuffer,
+#ifdef AVK_USE_SYNCHRONIZATION2_INSTEAD_OF_CORE
+					aDispatchLoaderExt,
+#else
+					aDispatchLoaderCore,
+#endif
+					aRecordedCommandsAndSyncInstructions, *aResourceStateTracker, i, runEnd);
+				i = runEnd - 1;
+				continue;
+			}
+
+			// Get current element:
+			auto& recordee = aRecordedCommandsAndSyncInstructions[i];
+			// Update current index:
+			visitState.mCurrentIndexIntoRecordedStuff = i;
+			// Handle current element:
+			std::visit(visitState, recordee);
+		}
+	}
+
+	// Internal helper function which resolves all the auto_stage/auto_access parts of all barriers in one go, but only if there are any barriers at all:
+	inline static std::optional<sync::resource_state_tracker> resolve_barriers(const std::vector<recorded_commands_t>& aRecordedCommandsAndSyncInstructions)
+	{
+		std::optional<sync::resource_state_tracker> resourceStateTracker;
+		if (std::any_of(std::begin(aRecordedCommandsAndSyncInstructions), std::end(aRecordedCommandsAndSyncInstructions), [](const recorded_commands_t& r) { return std::holds_alternative<sync::sync_type_command>(r); })) {
+			resourceStateTracker.emplace(aRecordedCommandsAndSyncInstructions);
+		}
+		return resourceStateTracker;
+	}
+
+	inline static void record_into_command_buffer(
+		command_buffer_t& aCommandBuffer, 
+#ifdef AVK_USE_SYNCHRONIZATION2_INSTEAD_OF_CORE
+		const DISPATCH_LOADER_EXT_TYPE& aDispatchLoaderExt,
+#else
+		const DISPATCH_LOADER_CORE_TYPE& aDispatchLoaderCore,
+#endif
+		const std::vector<recorded_commands_t>& aRecordedCommandsAndSyncInstructions,
+		uint32_t& aNumPipelineBarrierCallsSaved)
+	{
+		const auto resourceStateTracker = resolve_barriers(aRecordedCommandsAndSyncInstructions);
+		record_range_into_command_buffer(aCommandBuffer,
+#ifdef AVK_USE_SYNCHRONIZATION2_INSTEAD_OF_CORE
+			aDispatchLoaderExt,
+#else
+			aDispatchLoaderCore,
+#endif
+			aRecordedCommandsAndSyncInstructions, resourceStateTracker.has_value() ? &resourceStateTracker.value() : nullptr,
+			0, static_cast<int>(aRecordedCommandsAndSyncInstructions.size()), aNumPipelineBarrierCallsSaved);
+	}
+	
+	submission_data recorded_command_buffer::then_waiting_for(avk::semaphore_wait_info aWaitInfo)
+	{
+		return submission_data{ mRoot, mCommandBufferToRecordInto, std::move(aWaitInfo) };
+	}
+
+	submission_data recorded_command_buffer::then_submit_to(const queue& aQueue)
+	{
+		return submission_data{ mRoot, mCommandBufferToRecordInto, aQueue, this };
+	}
+
+	recorded_command_buffer::recorded_command_buffer(const root* aRoot, const std::vector<recorded_commands_t>& aRecordedCommandsAndSyncInstructions, avk::resource_argument<avk::command_buffer_t> aCommandBuffer, const avk::recorded_commands* aDangerousRecordedCommandsPointer, bool aBeginEnd)
+		: mRoot{ aRoot }
+		, mCommandBufferToRecordInto{ std::move(aCommandBuffer) }
+		, mDangerousRecordedComandsPointer{ aDangerousRecordedCommandsPointer }
+	{
+		if (aBeginEnd) {
+			mCommandBufferToRecordInto.get().begin_recording();
+		}
+
+		record_into_command_buffer(mCommandBufferToRecordInto.get(), 
+#ifdef AVK_USE_SYNCHRONIZATION2_INSTEAD_OF_CORE
+			mRoot->dispatch_loader_ext(),
+#else
+			mRoot->dispatch_loader_core(),
+#endif
+			aRecordedCommandsAndSyncInstructions, mNumPipelineBarrierCallsSaved);
+
+		if (aBeginEnd) {
+			mCommandBufferToRecordInto.get().end_recording();
+		}
+	}
+
+	// Internal helper for parallel recording: A contiguous range of top-level commands which is either recorded directly
+	// into the primary command buffer, or into a secondary command buffer by one of the worker threads.
+	struct recording_chunk
+	{
+		int mBeginIndex;
+		int mEndIndex;
+		bool mSecondary;
+		// Set for secondary command buffers which are executed within a render pass:
+		std::optional<vk::CommandBufferInheritanceInfo> mRenderPassInheritance;
+		// Set for primary ranges which begin with the next_subpass or end command of a render pass:
+		bool mContinuesRenderPass = false;
+		command_buffer mSecondaryCommandBuffer = {};
+		uint32_t mNumPipelineBarrierCallsSaved = 0u;
+		// Indices of the top-level state_type_commands which establish the state at mBeginIndex, if it must be recorded again:
+		std::vector<int> mStateSnapshot;
+	};
+
+	// Internal helper for parallel recording: Splits the top-level commands at render pass boundaries into ranges which must
+	// be recorded into the primary command buffer, and ranges which can be recorded into secondary command buffers.
+	// The latter are split further into up to aNumWorkers chunks of at least aMinCommandsPerChunk commands each.
+	static std::vector<recording_chunk> partition_for_parallel_recording(const std::vector<recorded_commands_t>& aRecordedCommandsAndSyncInstructions, uint32_t aNumWorkers, uint32_t aMinCommandsPerChunk)
+	{
+		using boundary_kind = command::render_pass_boundary::kind;
+		std::vector<recording_chunk> chunks;
+
+		auto addSecondaryRange = [&chunks, aNumWorkers, lMinCommandsPerChunk = static_cast<int>(std::max(aMinCommandsPerChunk, 1u))](int aBegin, int aEnd, const std::optional<vk::CommandBufferInheritanceInfo>& aInheritance) {
+			const int numCommands = aEnd - aBegin;
+			if (numCommands <= 0) {
+				return;
+			}
+			const int numChunks = std::clamp(numCommands / lMinCommandsPerChunk, 1, static_cast<int>(aNumWorkers));
+			for (int c = 0; c < numChunks; ++c) {
+				chunks.push_back(recording_chunk{ aBegin + numCommands * c / numChunks, aBegin + numCommands * (c + 1) / numChunks, true, aInheritance });
+			}
+		};
+		auto addPrimaryRange = [&chunks](int aBegin, int aEnd, bool aIsBoundary, bool aContinuesRenderPass) {
+			// Consecutive commands (which are not render pass boundaries) are recorded into the primary command buffer as one range:
+			if (!aIsBoundary && !chunks.empty() && !chunks.back().mSecondary && chunks.back().mEndIndex == aBegin) {
+				chunks.back().mEndIndex = aEnd;
+				return;
+			}
+			chunks.push_back(recording_chunk{ aBegin, aEnd, false, std::nullopt, aContinuesRenderPass });
+		};
+
+		bool insideRenderPass = false;
+		vk::RenderPass renderPass;
+		vk::Framebuffer framebuffer;
+		uint32_t subpass = 0u;
+		// Set if the contents of the current subpass are provided via secondary command buffers:
+		std::optional<vk::CommandBufferInheritanceInfo> subpassInheritance;
+
+		const int n = static_cast<int>(aRecordedCommandsAndSyncInstructions.size());
+		int rangeBegin = 0;
+		for (int i = 0; i < n; ++i) {
+			const auto boundary = std::holds_alternative<command::action_type_command>(aRecordedCommandsAndSyncInstructions[i])
+				? std::get<command::action_type_command>(aRecordedCommandsAndSyncInstructions[i]).mRenderPassBoundary
+				: command::render_pass_boundary{};
+
+			if (boundary_kind::none == boundary.mKind) {
+				if (insideRenderPass && !subpassInheritance.has_value()) {
+					// Inline subpass contents must be recorded into the primary command buffer:
+					addPrimaryRange(i, i + 1, false, false);
+					rangeBegin = i + 1;
+				}
+				continue;
+			}
+
+			addSecondaryRange(rangeBegin, i, subpassInheritance);
+			addPrimaryRange(i, i + 1, true, boundary_kind::next_subpass == boundary.mKind || boundary_kind::end == boundary.mKind);
+			rangeBegin = i + 1;
+
+			switch (boundary.mKind) {
+			case boundary_kind::begin:
+				insideRenderPass = true;
+				renderPass = boundary.mRenderPass;
+				framebuffer = boundary.mFramebuffer;
+				subpass = 0u;
+				break;
+			case boundary_kind::next_subpass:
+				++subpass;
+				break;
+			case boundary_kind::end:
+				insideRenderPass = false;
+				break;
+			default:
+				break;
+			}
+			subpassInheritance.reset();
+			if (insideRenderPass && boundary.mSubpassContentsInSecondaryCommandBuffers) {
+				subpassInheritance = vk::CommandBufferInheritanceInfo{}
+					.setRenderPass(renderPass)
+					.setSubpass(subpass)
+					.setFramebuffer(framebuffer);
+			}
+		}
+		addSecondaryRange(rangeBegin, n, subpassInheritance);
+
+		return chunks;
+	}
+
+	// Internal helper for parallel recording: Returns true if the state set by aLater replaces all of the state set by aEarlier.
+	// Only commands with a lowered description can be compared; all others never replace anything.
+	static bool state_supersedes(const command::lowered_command& aLater, const command::lowered_command& aEarlier)
+	{
+		if (std::holds_alternative<command::lowered::bind_pipeline>(aLater) && std::holds_alternative<command::lowered::bind_pipeline>(aEarlier)) {
+			return std::get<command::lowered::bind_pipeline>(aLater).mBindPoint == std::get<command::lowered::bind_pipeline>(aEarlier).mBindPoint;
+		}
+		if (std::holds_alternative<command::lowered::bind_descriptors>(aLater) && std::holds_alternative<command::lowered::bind_descriptors>(aEarlier)) {
+			const auto& later = std::get<command::lowered::bind_descriptors>(aLater);
+			const auto& earlier = std::get<command::lowered::bind_descriptors>(aEarlier);
+			if (later.mBindPoint != earlier.mBindPoint) {
+				return false;
+			}
+			// Every set bound by the earlier command must be bound again by the later one:
+			return std::all_of(std::begin(earlier.mSets), std::end(earlier.mSets), [&later](const auto& bEarlierSet) {
+				return std::any_of(std::begin(later.mSets), std::end(later.mSets), [&bEarlierSet](const auto& bLaterSet) {
+					return std::get<uint32_t>(bLaterSet) == std::get<uint32_t>(bEarlierSet);
+				});
+			});
+		}
+		if (std::holds_alternative<command::lowered::push_constants>(aLater) && std::holds_alternative<command::lowered::push_constants>(aEarlier)) {
+			const auto& later = std::get<command::lowered::push_constants>(aLater);
+			const auto& earlier = std::get<command::lowered::push_constants>(aEarlier);
+			return later.mStages == earlier.mStages
+				&& later.mOffset <= earlier.mOffset
+				&& earlier.mOffset + earlier.mData.size() <= later.mOffset + later.mData.size();
+		}
+		return false;
+	}
+
+	// Internal helper for parallel recording: Secondary command buffers do not inherit any state, and the state of a primary
+	// command buffer is undefined after vkCmdExecuteCommands. Therefore, the state at the beginning of such chunks must be
+	// recorded again. This determines it in one forward pass over all commands, carrying a running snapshot from chunk to chunk
+	// in which state that has been replaced by later commands (e.g., pipelines bound to the same bind point) is dropped.
+	static void capture_state_snapshots(const std::vector<recorded_commands_t>& aRecordedCommandsAndSyncInstructions, std::vector<recording_chunk>& aChunks)
+	{
+		std::vector<std::tuple<int, command::lowered_command>> snapshot; // Indices of the state_type_commands and their compact descriptions
+		int next = 0;
+		bool precededBySecondary = false;
+		for (auto& chunk : aChunks) {
+			for (; next < chunk.mBeginIndex; ++next) {
+				if (!std::holds_alternative<command::state_type_command>(aRecordedCommandsAndSyncInstructions[next])) {
+					continue;
+				}
+				const auto& stateCmd = std::get<command::state_type_command>(aRecordedCommandsAndSyncInstructions[next]);
+				if (!stateCmd.mFun) {
+					continue;
+				}
+				auto lowered = stateCmd.lowered();
+				snapshot.erase(std::remove_if(std::begin(snapshot), std::end(snapshot), [&lowered](const auto& bEntry) {
+					return state_supersedes(lowered, std::get<command::lowered_command>(bEntry));
+				}), std::end(snapshot));
+				snapshot.emplace_back(next, std::move(lowered));
+			}
+			// Nothing but vkCmdExecuteCommands may be recorded in subpasses whose contents are provided via secondary command buffers:
+			if (chunk.mSecondary || (precededBySecondary && !chunk.mContinuesRenderPass)) {
+				chunk.mStateSnapshot.clear();
+				for (const auto& entry : snapshot) {
+					chunk.mStateSnapshot.push_back(std::get<int>(entry));
+				}
+			}
+			precededBySecondary = chunk.mSecondary;
+		}
+	}
+
+	// Internal helper for parallel recording: Records the state_type_commands of a snapshot created by capture_state_snapshots.
+	static void record_state_snapshot(command_buffer_t& aCommandBuffer, const std::vector<recorded_commands_t>& aRecordedCommandsAndSyncInstructions, const std::vector<int>& aStateSnapshot)
+	{
+		for (auto i : aStateSnapshot) {
+			std::get<command::state_type_command>(aRecordedCommandsAndSyncInstructions[i]).mFun(aCommandBuffer);
+		}
+	}
+
+	recorded_command_buffer::recorded_command_buffer(const root* aRoot, const std::vector<recorded_commands_t>& aRecordedCommandsAndSyncInstructions, avk::resource_argument<avk::command_buffer_t> aCommandBuffer, const parallel_recording_config& aParallelRecordingConfig, const avk::recorded_commands* aDangerousRecordedCommandsPointer, bool aBeginEnd)
+		: mRoot{ aRoot }
+		, mCommandBufferToRecordInto{ std::move(aCommandBuffer) }
+		, mDangerousRecordedComandsPointer{ aDangerousRecordedCommandsPointer }
+	{
+		const auto& commandPools = aParallelRecordingConfig.mPerThreadCommandPools;
+		if (commandPools.empty()) {
+			throw avk::logic_error("At least one command pool must be passed to parallel_recording_config::mPerThreadCommandPools.");
+		}
+		const auto numWorkers = static_cast<uint32_t>(commandPools.size());
+
+		// Resolve all barriers w.r.t. the whole list of commands BEFORE splitting it up:
+		const auto resourceStateTracker = resolve_barriers(aRecordedCommandsAndSyncInstructions);
+		const auto* tracker = resourceStateTracker.has_value() ? &resourceStateTracker.value() : nullptr;
+
+		auto chunks = partition_for_parallel_recording(aRecordedCommandsAndSyncInstructions, numWorkers, aParallelRecordingConfig.mMinCommandsPerSecondaryCommandBuffer);
+		capture_state_snapshots(aRecordedCommandsAndSyncInstructions, chunks);
+		std::vector<size_t> secondaryChunkIndices;
+		for (size_t c = 0; c < chunks.size(); ++c) {
+			if (chunks[c].mSecondary) {
+				secondaryChunkIndices.push_back(c);
+			}
+		}
+
+		// Record the secondary command buffers, distributed round-robin among the jobs, each of which uses its own command pool:
+		auto work = [&](uint32_t aJobIndex) {
+			auto& commandPool = commandPools[aJobIndex].get();
+			for (size_t s = aJobIndex; s < secondaryChunkIndices.size(); s += numWorkers) {
+				auto& chunk = chunks[secondaryChunkIndices[s]];
+				vk::CommandBufferUsageFlags usageFlags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit;
+				if (chunk.mRenderPassInheritance.has_value()) {
+					usageFlags |= vk::CommandBufferUsageFlagBits::eRenderPassContinue;
+				}
+				auto secondary = commandPool.alloc_command_buffer(usageFlags, vk::CommandBufferLevel::eSecondary);
+				secondary->begin_recording(chunk.mRenderPassInheritance.value_or(vk::CommandBufferInheritanceInfo{}));
+				record_state_snapshot(secondary.get(), aRecordedCommandsAndSyncInstructions, chunk.mStateSnapshot);
+				record_range_into_command_buffer(secondary.get(),
+#ifdef AVK_USE_SYNCHRONIZATION2_INSTEAD_OF_CORE
+					mRoot->dispatch_loader_ext(),
+#else
+					mRoot->dispatch_loader_core(),
+#endif
+					aRecordedCommandsAndSyncInstructions, tracker, chunk.mBeginIndex, chunk.mEndIndex, chunk.mNumPipelineBarrierCallsSaved);
+				secondary->end_recording();
+				chunk.mSecondaryCommandBuffer = std::move(secondary);
+			}
+		};
+		auto& workerPool = nullptr != aParallelRecordingConfig.mWorkerPool ? *aParallelRecordingConfig.mWorkerPool : worker_pool::shared();
+		workerPool.run(std::min(numWorkers, static_cast<uint32_t>(secondaryChunkIndices.size())), work);
+
+		// Stitch everything together in the primary command buffer:
+		auto& primary = mCommandBufferToRecordInto.get();
+		if (aBeginEnd) {
+			primary.begin_recording();
+		}
+
+		std::vector<vk::CommandBuffer> secondariesToExecute;
+		bool stateUndefined = false;
+		auto executeSecondaries = [&]() {
+			if (secondariesToExecute.empty()) {
+				return;
+			}
+			primary.handle().executeCommands(static_cast<uint32_t>(secondariesToExecute.size()), secondariesToExecute.data(), mRoot->dispatch_loader_core());
+			secondariesToExecute.clear();
+			stateUndefined = true;
+		};
+
+		for (auto& chunk : chunks) {
+			if (chunk.mSecondary) {
+				secondariesToExecute.push_back(chunk.mSecondaryCommandBuffer->handle());
+				mNumPipelineBarrierCallsSaved += chunk.mNumPipelineBarrierCallsSaved;
+				primary.handle_lifetime_of(std::move(chunk.mSecondaryCommandBuffer));
+				continue;
+			}
+			executeSecondaries();
+			if (stateUndefined && !chunk.mContinuesRenderPass) {
+				record_state_snapshot(primary, aRecordedCommandsAndSyncInstructions, chunk.mStateSnapshot);
+				stateUndefined = false;
+			}
+			record_range_into_command_buffer(primary,
+#ifdef AVK_USE_SYNCHRONIZATION2_INSTEAD_OF_CORE
+				mRoot->dispatch_loader_ext(),
+#else
+				mRoot->dispatch_loader_core(),
+#endif
+				aRecordedCommandsAndSyncInstructions, tracker, chunk.mBeginIndex, chunk.mEndIndex, mNumPipelineBarrierCallsSaved);
+		}
+		executeSecondaries();
+
+		if (aBeginEnd) {
+			primary.end_recording();
+		}
+	}
+
+	// Internal helper for eliminate_redundant_barriers: Returns true if the first stage mask includes all stages of the second:
+	inline static bool stage_mask_covers(vk::PipelineStageFlags2KHR aCovering, vk::PipelineStageFlags2KHR aCovered)
+	{
+		if (aCovering & vk::PipelineStageFlagBits2KHR::eAllCommands) {
+			return true;
+		}
+		return !(aCovered & ~aCovering);
+	}
+
+	// Internal helper for eliminate_redundant_barriers: Returns true if the first access mask includes all accesses of the second:
+	inline static bool access_mask_covers(vk::AccessFlags2KHR aCovering, vk::AccessFlags2KHR aCovered)
+	{
+		if ((aCovering & vk::AccessFlagBits2KHR::eMemoryRead) && (aCovering & vk::AccessFlagBits2KHR::eMemoryWrite)) {
+			return true;
+		}
+		return !(aCovered & ~aCovering);
+	}
+
+	// Internal helper for eliminate_redundant_barriers: Returns true if both barriers refer to the same image or the same buffer:
+	inline static bool barriers_refer_to_same_resource(const sync::sync_type_command& aFirst, const sync::sync_type_command& aSecond)
+	{
+		if (aFirst.is_image_memory_barrier() && aSecond.is_image_memory_barrier()) {
+			return aFirst.image_memory_barrier_data().mImage == aSecond.image_memory_barrier_data().mImage;
+		}
+		if (aFirst.is_buffer_memory_barrier() && aSecond.is_buffer_memory_barrier()) {
+			return aFirst.buffer_memory_barrier_data().mBuffer == aSecond.buffer_memory_barrier_data().mBuffer;
+		}
+		return false;
+	}
+
+	// Internal helper for eliminate_redundant_barriers: Returns true if the earlier barrier establishes (at least) all the
+	// dependencies of the later barrier, given that there is no action_type_command in between the two.
+	inline static bool barrier_covers(const sync::sync_type_command& aEarlier, const resolved_barrier_masks& aEarlierMasks, const sync::sync_type_command& aLater, const resolved_barrier_masks& aLaterMasks)
+	{
+		if (aEarlier.queue_family_ownership_transfer().has_value()) {
+			return false;
+		}
+		// A global barrier applies to all resources, a resource-specific barrier only to (a range of) its resource:
+		if (aEarlier.is_image_memory_barrier() || aEarlier.is_buffer_memory_barrier()) {
+			if (!barriers_refer_to_same_resource(aEarlier, aLater) || !range_contains(range_of(aEarlier), range_of(aLater))) {
+				return false;
+			}
+		}
+		return stage_mask_covers (aEarlierMasks.mSrcStage,  aLaterMasks.mSrcStage)
+			&& stage_mask_covers (aEarlierMasks.mDstStage,  aLaterMasks.mDstStage)
+			&& access_mask_covers(aEarlierMasks.mSrcAccess, aLaterMasks.mSrcAccess)
+			&& access_mask_covers(aEarlierMasks.mDstAccess, aLaterMasks.mDstAccess);
+	}
+
+	// Internal helper for eliminate_redundant_barriers: Returns true if the later barrier can be merged into the earlier one,
+	// which is the case for two global barriers, or for two barriers which refer to exactly the same range of the same resource.
+	inline static bool barriers_are_mergeable(const sync::sync_type_command& aEarlier, const sync::sync_type_command& aLater)
+	{
+		if (aEarlier.queue_family_ownership_transfer().has_value()) {
+			return false;
+		}
+		const auto isGlobal = [](const sync::sync_type_command& c) { return c.is_global_execution_barrier() || c.is_global_memory_barrier(); };
+		if (isGlobal(aEarlier) && isGlobal(aLater)) {
+			return true;
+		}
+		return barriers_refer_to_same_resource(aEarlier, aLater) && range_of(aEarlier) == range_of(aLater);
+	}
+
+	// Internal helper for eliminate_redundant_barriers: Combines one component (i.e., a source or destination stage or access) of two barriers.
+	// If both are auto_stage/auto_access, it stays auto (it will be resolved w.r.t. the same commands); otherwise the union of the resolved masks is used.
+	template <typename F>
+	inline static std::variant<std::monostate, F, uint8_t> widened_component(const std::variant<std::monostate, F, uint8_t>& aEarlier, F aEarlierResolved, const std::variant<std::monostate, F, uint8_t>& aLater, F aLaterResolved)
+	{
+		if (std::holds_alternative<std::monostate>(aEarlier) && std::holds_alternative<std::monostate>(aLater)) {
+			return std::monostate{};
+		}
+		if (std::holds_alternative<uint8_t>(aEarlier) && std::holds_alternative<uint8_t>(aLater)) {
+			return std::variant<std::monostate, F, uint8_t>{ std::in_place_type<uint8_t>, std::max(std::get<uint8_t>(aEarlier), std::get<uint8_t>(aLater)) };
+		}
+		return std::variant<std::monostate, F, uint8_t>{ std::in_place_type<F>, aEarlierResolved | aLaterResolved };
+	}
+
+	// Internal helper which performs the elimination of redundant barriers for one list of recorded commands (and, recursively, for its nested commands):
+	static void eliminate_redundant_barriers(std::vector<recorded_commands_t>& aRecordedCommandsAndSyncInstructions, sync::barrier_elimination_statistics& aStats)
+	{
+		for (auto& recordee : aRecordedCommandsAndSyncInstructions) {
+			if (std::holds_alternative<command::action_type_command>(recordee)) {
+				auto& nested = std::get<command::action_type_command>(recordee).mNestedCommandsAndSyncInstructions;
+				if (!nested.empty()) {
+					eliminate_redundant_barriers(nested, aStats);
+				}
+			}
+		}
+
+		// Removing or widening barriers affects how the remaining auto_stage/auto_access parts are resolved
+		// => repeat until nothing changes anymore (but limit the number of iterations, this is just an optimization):
+		constexpr int kMaxIterations = 4;
+		for (int iteration = 0; iteration < kMaxIterations; ++iteration) {
+			const auto n = static_cast<int>(aRecordedCommandsAndSyncInstructions.size());
+			if (std::none_of(std::begin(aRecordedCommandsAndSyncInstructions), std::end(aRecordedCommandsAndSyncInstructions), [](const recorded_commands_t& r) { return std::holds_alternative<sync::sync_type_command>(r); })) {
+				return;
+			}
+
+			const sync::resource_state_tracker tracker{ aRecordedCommandsAndSyncInstructions };
+			std::vector<bool> toBeRemoved(n, false);
+			bool anyChanges = false;
+
+			// Indices of the barriers which have been kept in the current run of barriers without an action_type_command in between:
+			std::vector<int> keptInCurrentRun;
+
+			for (int i = 0; i < n; ++i) {
+				if (std::holds_alternative<command::action_type_command>(aRecordedCommandsAndSyncInstructions[i])) {
+					keptInCurrentRun.clear();
+					continue;
+				}
+				if (!std::holds_alternative<sync::sync_type_command>(aRecordedCommandsAndSyncInstructions[i])) {
+					continue; // state_type_commands do not access any memory
+				}
+
+				auto& syncCmd = std::get<sync::sync_type_command>(aRecordedCommandsAndSyncInstructions[i]);
+				if (syncCmd.is_ill_formed() || syncCmd.is_split_barrier_half()) {
+					// The halves of split barriers must neither be removed nor widened, because both of them must stay the same:
+					continue;
+				}
+				const bool hasLayoutTransition  = syncCmd.is_image_memory_barrier() && syncCmd.image_memory_barrier_data().mLayoutTransition.has_value();
+				const bool hasOwnershipTransfer = syncCmd.queue_family_ownership_transfer().has_value();
+				if (hasLayoutTransition || hasOwnershipTransfer) {
+					// Barriers which modify the resource can not be removed, but subsequent barriers might be merged into them:
+					keptInCurrentRun.push_back(i);
+					continue;
+				}
+
+				const auto masks = resolve_barrier_masks(syncCmd, tracker, i);
+
+				// Provably a no-op? (The tracker only marks a barrier as such if no action_type_command at all, hinted or not, lies
+				// between it and the covering barrier, and if the covering barrier's destination scopes absorb this barrier's.)
+				if (tracker.scopes_at(i).mIsNoOp || !masks.mSrcStage || !masks.mDstStage) {
+					toBeRemoved[i] = true;
+					++aStats.mNumNoOpBarriersRemoved;
+					anyChanges = true;
+					continue;
+				}
+
+				// Covered by or mergeable into an earlier barrier?
+				bool eliminated = false;
+				for (int k : keptInCurrentRun) {
+					auto& earlierCmd = std::get<sync::sync_type_command>(aRecordedCommandsAndSyncInstructions[k]);
+					const auto earlierMasks = resolve_barrier_masks(earlierCmd, tracker, k);
+					if (barrier_covers(earlierCmd, earlierMasks, syncCmd, masks)) {
+						++aStats.mNumCoveredBarriersRemoved;
+						eliminated = true;
+						break;
+					}
+					if (barriers_are_mergeable(earlierCmd, syncCmd)) {
+						earlierCmd.with_stages(avk::stage::execution_dependency{
+							widened_component(earlierCmd.src_stage(), earlierMasks.mSrcStage, syncCmd.src_stage(), masks.mSrcStage),
+							widened_component(earlierCmd.dst_stage(), earlierMasks.mDstStage, syncCmd.dst_stage(), masks.mDstStage)
+						});
+						auto srcAccess = widened_component(earlierCmd.src_access(), earlierMasks.mSrcAccess, syncCmd.src_access(), masks.mSrcAccess);
+						auto dstAccess = widened_component(earlierCmd.dst_access(), earlierMasks.mDstAccess, syncCmd.dst_access(), masks.mDstAccess);
+						if (!std::holds_alternative<std::monostate>(srcAccess) || !std::holds_alternative<std::monostate>(dstAccess)) {
+							earlierCmd.with_memory_access(avk::access::memory_dependency{ std::move(srcAccess), std::move(dstAccess) });
+						}
+						++aStats.mNumMergedBarriersRemoved;
+						eliminated = true;
+						break;
+					}
+				}
+
+				if (eliminated) {
+					toBeRemoved[i] = true;
+					anyChanges = true;
+				}
+				else {
+					keptInCurrentRun.push_back(i);
+				}
+			}
+
+			if (!anyChanges) {
+				return;
+			}
+
+			std::vector<recorded_commands_t> remaining;
+			remaining.reserve(n);
+			for (int i = 0; i < n; ++i) {
+				if (!toBeRemoved[i]) {
+					remaining.push_back(std::move(aRecordedCommandsAndSyncInstructions[i]));
+				}
+			}
+			aRecordedCommandsAndSyncInstructions = std::move(remaining);
+		}
+	}
+
+	// Internal helper for split_barriers: Returns true if the given resource (and range) is affected by the given image memory barrier or buffer memory barrier:
+	inline static bool barrier_refers_to(const sync::sync_type_command& aBarrier, const std::variant<vk::Image, vk::Buffer>& aResource, const resource_range& aRange)
+	{
+		if (aBarrier.is_image_memory_barrier()) {
+			if (!std::holds_alternative<vk::Image>(aResource) || std::get<vk::Image>(aResource) != aBarrier.image_memory_barrier_data().mImage) {
+				return false;
+			}
+		}
+		else if (aBarrier.is_buffer_memory_barrier()) {
+			if (!std::holds_alternative<vk::Buffer>(aResource) || std::get<vk::Buffer>(aResource) != aBarrier.buffer_memory_barrier_data().mBuffer) {
+				return false;
+			}
+		}
+		else {
+			return false;
+		}
+		return ranges_overlap(range_of(aBarrier), aRange);
+	}
+
+	// Internal helper which converts barriers of the given list of recorded commands into split barriers (see recorded_commands::split_barriers).
+	// The events which are required for that are acquired from aEventPool if set, or created with the given root otherwise, and are added to aEvents.
+	// Returns the number of barriers which have been split.
+	static uint32_t split_barriers(std::vector<recorded_commands_t>& aRecordedCommandsAndSyncInstructions, const root& aRoot, event_pool* aEventPool, std::vector<event>& aEvents, uint32_t aMinNumUnrelatedCommands)
+	{
+		const auto n = static_cast<int>(aRecordedCommandsAndSyncInstructions.size());
+		const auto resourceStateTracker = resolve_barriers(aRecordedCommandsAndSyncInstructions);
+		if (!resourceStateTracker.has_value()) {
+			return 0u;
+		}
+
+		// Events must neither be set nor waited on within render pass instances => determine which commands are recorded within one:
+		std::vector<bool> withinRenderPassAfter(n, false);
+		bool withinRenderPass = false;
+		for (int i = 0; i < n; ++i) {
+			if (std::holds_alternative<command::action_type_command>(aRecordedCommandsAndSyncInstructions[i])) {
+				switch (std::get<command::action_type_command>(aRecordedCommandsAndSyncInstructions[i]).mRenderPassBoundary.mKind) {
+				case command::render_pass_boundary::kind::begin: withinRenderPass = true;  break;
+				case command::render_pass_boundary::kind::end:   withinRenderPass = false; break;
+				default: break;
+				}
+			}
+			withinRenderPassAfter[i] = withinRenderPass;
+		}
+
+		// For each index: The signal halves which are to be inserted after it, and the wait half which replaces it:
+		std::vector<std::vector<sync::sync_type_command>> signalHalvesAfter(n);
+		std::vector<std::optional<sync::sync_type_command>> waitHalfAt(n);
+		uint32_t numSplit = 0u;
+
+		for (int b = 0; b < n; ++b) {
+			if (!std::holds_alternative<sync::sync_type_command>(aRecordedCommandsAndSyncInstructions[b])) {
+				continue;
+			}
+			const auto& barrier = std::get<sync::sync_type_command>(aRecordedCommandsAndSyncInstructions[b]);
+			if (!(barrier.is_image_memory_barrier() || barrier.is_buffer_memory_barrier()) || barrier.is_split_barrier_half() || barrier.queue_family_ownership_transfer().has_value()
+				|| resourceStateTracker->scopes_at(b).mIsNoOp || (b > 0 && withinRenderPassAfter[b - 1])) {
+				continue;
+			}
+
+			// Search backwards for the command which produces the data, counting the unrelated commands in between:
+			std::optional<int> producer;
+			uint32_t numUnrelated = 0u;
+			for (int k = b - 1; k >= 0; --k) {
+				const auto& recordee = aRecordedCommandsAndSyncInstructions[k];
+				if (std::holds_alternative<sync::sync_type_command>(recordee)) {
+					const auto& other = std::get<sync::sync_type_command>(recordee);
+					if ((other.is_image_memory_barrier() || other.is_buffer_memory_barrier()) && barriers_refer_to_same_resource(barrier, other) && ranges_overlap(range_of(barrier), range_of(other))) {
+						break; // Already synchronized by an earlier barrier
+					}
+					continue;
+				}
+				if (!std::holds_alternative<command::action_type_command>(recordee)) {
+					continue; // state_type_commands do not access any memory
+				}
+				const auto& actionCmd = std::get<command::action_type_command>(recordee);
+				if (std::any_of(std::begin(actionCmd.mResourceSpecificSyncHints), std::end(actionCmd.mResourceSpecificSyncHints), [&barrier](const auto& bResourceAndHint) {
+						return barrier_refers_to(barrier, std::get<0>(bResourceAndHint), range_of(std::get<0>(bResourceAndHint), std::get<1>(bResourceAndHint)));
+					})) {
+					producer = k;
+					break;
+				}
+				if (actionCmd.mResourceSpecificSyncHints.empty()) {
+					break; // It might access the resource without saying so => the signal half must not be moved above it
+				}
+				if (!actionCmd.mNestedCommandsAndSyncInstructions.empty() || command::render_pass_boundary::kind::none != actionCmd.mRenderPassBoundary.mKind) {
+					break; // Nested commands might use the resource; and the signal half must not be moved across render pass boundaries
+				}
+				++numUnrelated;
+			}
+
+			if (!producer.has_value() || numUnrelated < std::max(aMinNumUnrelatedCommands, 1u) || withinRenderPassAfter[producer.value()]) {
+				continue;
+			}
+
+			aEvents.push_back(nullptr != aEventPool ? aEventPool->acquire() : root::create_event(aRoot.device(), aRoot.dispatch_loader_core()));
+			const auto resolvedBarrier = with_resolved_scopes(barrier, resourceStateTracker.value(), b);
+			signalHalvesAfter[producer.value()].push_back(sync::signal_split_barrier(aEvents.back().get(), resolvedBarrier));
+			waitHalfAt[b] = sync::wait_split_barrier(aEvents.back().get(), resolvedBarrier);
+			++numSplit;
+		}
+
+		if (0u == numSplit) {
+			return 0u;
+		}
+
+		std::vector<recorded_commands_t> result;
+		result.reserve(n + numSplit);
+		for (int i = 0; i < n; ++i) {
+			if (waitHalfAt[i].has_value()) {
+				result.push_back(std::move(waitHalfAt[i].value()));
+			}
+			else {
+				result.push_back(std::move(aRecordedCommandsAndSyncInstructions[i]));
+			}
+			for (auto& signalHalf : signalHalvesAfter[i]) {
+				result.push_back(std::move(signalHalf));
+			}
+		}
+		aRecordedCommandsAndSyncInstructions = std::move(result);
+		return numSplit;
+	}
+
+	std::string to_string(sync::analyzed_barrier_type aValue)
+	{
+		switch (aValue) {
+		case sync::analyzed_barrier_type::global_execution_barrier: return "global_execution_barrier";
+		case sync::analyzed_barrier_type::global_memory_barrier:    return "global_memory_barrier";
+		case sync::analyzed_barrier_type::image_memory_barrier:     return "image_memory_barrier";
+		case sync::analyzed_barrier_type::buffer_memory_barrier:    return "buffer_memory_barrier";
+		default:                                                    return "ill_formed";
+		}
+	}
+
+	// Internal helper for analyze_barriers: Analyzes the barriers of one list of recorded commands and, recursively, those of its nested commands.
+	static void analyze_barriers(const std::vector<recorded_commands_t>& aRecordedCommandsAndSyncInstructions, std::vector<int>& aPath, std::vector<sync::barrier_analysis>& aResult)
+	{
+		const sync::resource_state_tracker tracker{ aRecordedCommandsAndSyncInstructions, true };
+		const int n = static_cast<int>(aRecordedCommandsAndSyncInstructions.size());
+		for (int i = 0; i < n; ++i) {
+			const auto& recordee = aRecordedCommandsAndSyncInstructions[i];
+			if (std::holds_alternative<command::action_type_command>(recordee)) {
+				const auto& nested = std::get<command::action_type_command>(recordee).mNestedCommandsAndSyncInstructions;
+				if (!nested.empty()) {
+					aPath.push_back(i);
+					analyze_barriers(nested, aPath, aResult);
+					aPath.pop_back();
+				}
+				continue;
+			}
+			if (!std::holds_alternative<sync::sync_type_command>(recordee)) {
+				continue;
+			}
+
+			const auto& syncCmd = std::get<sync::sync_type_command>(recordee);
+			auto& analysis = aResult.emplace_back();
+			analysis.mPath = aPath;
+			analysis.mPath.push_back(i);
+			analysis.mType = syncCmd.is_global_execution_barrier() ? sync::analyzed_barrier_type::global_execution_barrier
+			               : syncCmd.is_global_memory_barrier()    ? sync::analyzed_barrier_type::global_memory_barrier
+			               : syncCmd.is_image_memory_barrier()     ? sync::analyzed_barrier_type::image_memory_barrier
+			               : syncCmd.is_buffer_memory_barrier()    ? sync::analyzed_barrier_type::buffer_memory_barrier
+			               :                                         sync::analyzed_barrier_type::ill_formed;
+			if (syncCmd.is_split_barrier_half()) {
+				analysis.mSplitBarrierHalf = syncCmd.split_barrier_event_data().mHalf;
+			}
+			if (syncCmd.is_ill_formed()) {
+				continue;
+			}
+
+			const auto& scopes = tracker.scopes_at(i);
+			const auto* details = tracker.resolution_details_at(i);
+			assert(nullptr != details);
+			const auto masks = resolve_barrier_masks(syncCmd, tracker, i);
+			analysis.mIsNoOp    = scopes.mIsNoOp;
+			analysis.mSrcStage  = masks.mSrcStage;
+			analysis.mSrcAccess = masks.mSrcAccess;
+			analysis.mDstStage  = masks.mDstStage;
+			analysis.mDstAccess = masks.mDstAccess;
+			analysis.mSrcCommandsScanned = details->mSrcCommands;
+			analysis.mDstCommandsScanned = details->mDstCommands;
+			if (analysis.mIsNoOp) {
+				continue; // Not recorded at all => neither a fallback nor over-synchronization
+			}
+
+			const bool autoSrcStage  = std::holds_alternative<stage::auto_stage_t>(syncCmd.src_stage());
+			const bool autoSrcAccess = std::holds_alternative<access::auto_access_t>(syncCmd.src_access());
+			const bool autoDstStage  = std::holds_alternative<stage::auto_stage_t>(syncCmd.dst_stage());
+			const bool autoDstAccess = std::holds_alternative<access::auto_access_t>(syncCmd.dst_access());
+			analysis.mSrcStageFallback  = autoSrcStage  && (!scopes.mSrcStage.has_value()  || details->mSrcIncludesUnspecified);
+			analysis.mSrcAccessFallback = autoSrcAccess && (!scopes.mSrcAccess.has_value() || details->mSrcIncludesUnspecified);
+			analysis.mDstStageFallback  = autoDstStage  && (!scopes.mDstStage.has_value()  || details->mDstIncludesUnspecified);
+			analysis.mDstAccessFallback = autoDstAccess && (!scopes.mDstAccess.has_value() || details->mDstIncludesUnspecified);
+
+			// Auto parts, and fixed parts of resource-specific barriers which have been resolved w.r.t. some commands, could be as tight
+			// as the specified sync hints of these commands. For all other fixed parts, nothing better can be determined:
+			const bool isResourceSpecific = syncCmd.is_image_memory_barrier() || syncCmd.is_buffer_memory_barrier();
+			const bool srcScanned = isResourceSpecific && !details->mSrcCommands.empty();
+			const bool dstScanned = isResourceSpecific && !details->mDstCommands.empty();
+			analysis.mTightSrcStage  = (autoSrcStage  || srcScanned) ? details->mSpecifiedSrcStage  : masks.mSrcStage;
+			analysis.mTightSrcAccess = (autoSrcAccess || srcScanned) ? details->mSpecifiedSrcAccess : masks.mSrcAccess;
+			analysis.mTightDstStage  = (autoDstStage  || dstScanned) ? details->mSpecifiedDstStage  : masks.mDstStage;
+			analysis.mTightDstAccess = (autoDstAccess || dstScanned) ? details->mSpecifiedDstAccess : masks.mDstAccess;
+		}
+	}
+
+	namespace sync
+	{
+		barrier_analysis_report analyze_barriers(const std::vector<recorded_commands_t>& aRecordedCommandsAndSyncInstructions)
+		{
+			barrier_analysis_report result;
+			std::vector<int> path;
+			avk::analyze_barriers(aRecordedCommandsAndSyncInstructions, path, result.mBarriers);
+			return result;
+		}
+
+		uint32_t barrier_analysis_report::num_no_op_barriers() const
+		{
+			return static_cast<uint32_t>(std::count_if(std::begin(mBarriers), std::end(mBarriers), [](const barrier_analysis& b) { return b.mIsNoOp; }));
+		}
+
+		uint32_t barrier_analysis_report::num_barriers_using_fallback() const
+		{
+			return static_cast<uint32_t>(std::count_if(std::begin(mBarriers), std::end(mBarriers), [](const barrier_analysis& b) { return b.uses_fallback(); }));
+		}
+
+		uint32_t barrier_analysis_report::num_over_synchronized_barriers() const
+		{
+			return static_cast<uint32_t>(std::count_if(std::begin(mBarriers), std::end(mBarriers), [](const barrier_analysis& b) { return b.is_over_synchronized(); }));
+		}
+
+		std::string barrier_analysis_report::to_json() const
+		{
+			// vk::to_string of flags yields something like "{ ComputeShader | Transfer }", i.e., nothing that must be escaped:
+			const auto str = [](auto aFlags) { return "\"" + vk::to_string(aFlags) + "\""; };
+			const auto boolean = [](bool aValue) { return aValue ? "true" : "false"; };
+			const auto array = [](const std::vector<int>& aValues) {
+				std::string result = "[";
+				for (size_t i = 0; i < aValues.size(); ++i) {
+					result += (i > 0 ? ", " : "") + std::to_string(aValues[i]);
+				}
+				return result + "]";
+			};
+
+			std::ostringstream json;
+			json << "{\n"
+				<< "\t\"num_barriers\": " << num_barriers() << ",\n"
+				<< "\t\"num_no_op_barriers\": " << num_no_op_barriers() << ",\n"
+				<< "\t\"num_barriers_using_fallback\": " << num_barriers_using_fallback() << ",\n"
+				<< "\t\"num_over_synchronized_barriers\": " << num_over_synchronized_barriers() << ",\n"
+				<< "\t\"barriers\": [";
+			for (size_t i = 0; i < mBarriers.size(); ++i) {
+				const auto& b = mBarriers[i];
+				json << (i > 0 ? ",\n" : "\n")
+					<< "\t\t{ \"path\": " << array(b.mPath)
+					<< ", \"type\": \"" << avk::to_string(b.mType) << "\""
+					<< ", \"split_barrier_half\": " << (b.mSplitBarrierHalf.has_value() ? (split_barrier_half::signal == b.mSplitBarrierHalf.value() ? "\"signal\"" : "\"wait\"") : "null")
+					<< ", \"no_op\": " << boolean(b.mIsNoOp)
+					<< ", \"uses_fallback\": " << boolean(b.uses_fallback())
+					<< ", \"over_synchronized\": " << boolean(b.is_over_synchronized())
+					<< ", \"src_stage\": " << str(b.mSrcStage) << ", \"src_access\": " << str(b.mSrcAccess)
+					<< ", \"dst_stage\": " << str(b.mDstStage) << ", \"dst_access\": " << str(b.mDstAccess)
+					<< ", \"fallback\": { \"src_stage\": " << boolean(b.mSrcStageFallback) << ", \"src_access\": " << boolean(b.mSrcAccessFallback)
+					<< ", \"dst_stage\": " << boolean(b.mDstStageFallback) << ", \"dst_access\": " << boolean(b.mDstAccessFallback) << " }"
+					<< ", \"scanned_commands\": { \"src\": " << array(b.mSrcCommandsScanned) << ", \"dst\": " << array(b.mDstCommandsScanned) << " }"
+					<< ", \"tight\": { \"src_stage\": " << str(b.mTightSrcStage) << ", \"src_access\": " << str(b.mTightSrcAccess)
+					<< ", \"dst_stage\": " << str(b.mTightDstStage) << ", \"dst_access\": " << str(b.mTightDstAccess) << " } }";
+			}
+			json << (mBarriers.empty() ? "]\n" : "\n\t]\n") << "}\n";
+			return json.str();
+		}
+	}
+
+	recorded_commands::recorded_commands(const root* aRoot, std::vector<recorded_commands_t> aRecordedCommandsAndSyncInstructions)
+		: mRoot{ aRoot }
+		, mRecordedCommandsAndSyncInstructions{ std::move(aRecordedCommandsAndSyncInstructions) }
+	{
+		for (auto& recordee : mRecordedCommandsAndSyncInstructions) {
+			if (std::holds_alternative<avk::command::action_type_command>(recordee)) {
+				for (auto& lifetime : std::get<avk::command::action_type_command>(recordee).mLifetimeHandledResources) {
+					handle_lifetime_of(std::move(lifetime));
+				}
+				std::get<avk::command::action_type_command>(recordee).mLifetimeHandledResources.clear();
+			}
+		}
+	}
+	
+	recorded_commands& recorded_commands::move_into(std::vector<recorded_commands_t>& aTarget)
+	{
+		aTarget = std::move(mRecordedCommandsAndSyncInstructions);
+		return *this;
+	}
+
+	recorded_commands& recorded_commands::prepend_by(std::vector<recorded_commands_t>& aCommands)
+	{
+		mRecordedCommandsAndSyncInstructions.insert(std::begin(mRecordedCommandsAndSyncInstructions), std::begin(aCommands), std::end(aCommands));
+		return *this;
+	}
+
+	recorded_commands& recorded_commands::append_by(std::vector<recorded_commands_t>& aTarget)
+	{
+		mRecordedCommandsAndSyncInstructions.insert(std::end(mRecordedCommandsAndSyncInstructions), std::begin(aTarget), std::end(aTarget));
+		return *this;
+	}
+
+	recorded_commands& recorded_commands::handle_lifetime_of(any_owning_resource_t aResource)
+	{
+		mLifetimeHandledResources.push_back(std::move(aResource));
+		return *this;
+	}
+
+	recorded_commands& recorded_commands::eliminate_redundant_barriers()
+	{
+		avk::eliminate_redundant_barriers(mRecordedCommandsAndSyncInstructions, mBarrierEliminationStats);
+		return *this;
+	}
+
+	recorded_commands& recorded_commands::split_barriers(uint32_t aMinNumUnrelatedCommands, event_pool* aEventPool)
+	{
+		assert(nullptr != mRoot);
+		std::vector<event> events;
+		mNumSplitBarriers += avk::split_barriers(mRecordedCommandsAndSyncInstructions, *mRoot, nullptr != aEventPool ? aEventPool : mRoot->split_barrier_event_pool(), events, aMinNumUnrelatedCommands);
+		for (auto& e : events) {
+			handle_lifetime_of(std::move(e));
+		}
+		return *this;
+	}
+
+	std::vector<recorded_commands_t> recorded_commands::and_store()
+	{
+		return std::move(mRecordedCommandsAndSyncInstructions);
+	}
+
+	recorded_command_buffer recorded_commands::into_command_buffer(avk::resource_argument<avk::command_buffer_t> aCommandBuffer, bool aBeginEnd)
+	{
+		recorded_command_buffer result(mRoot, mRecordedCommandsAndSyncInstructions, std::move(aCommandBuffer), this, aBeginEnd);
+		transfer_lifetime_handled_resources_to(result);
+		return result;
+	}
+
+	recorded_command_buffer recorded_commands::into_command_buffer_in_parallel(avk::resource_argument<avk::command_buffer_t> aCommandBuffer, const parallel_recording_config& aParallelRecordingConfig, bool aBeginEnd)
+	{
+		recorded_command_buffer result(mRoot, mRecordedCommandsAndSyncInstructions, std::move(aCommandBuffer), aParallelRecordingConfig, this, aBeginEnd);
+		transfer_lifetime_handled_resources_to(result);
+		return result;
+	}
+
+	void recorded_commands::transfer_lifetime_handled_resources_to(recorded_command_buffer& aRecordedCommandBuffer)
+	{
+		for (int i = static_cast<int>(mLifetimeHandledResources.size() - 1); i > 0; --i) {
+			if (std::visit(lambda_overload{
+				[](const bottom_level_acceleration_structure& a) { return a.is_shared_ownership_enabled(); },
+				[](const buffer&                              a) { return a.is_shared_ownership_enabled(); },
+				[](const buffer_view&                         a) { return a.is_shared_ownership_enabled(); },
+				[](const command_buffer&                      a) { return a.is_shared_ownership_enabled(); },
+				[](const command_pool&                        a) { return a.is_shared_ownership_enabled(); },
+				[](const compute_pipeline&                    a) { return a.is_shared_ownership_enabled(); },
+				[](const event&                               a) { return a.is_shared_ownership_enabled(); },
+				[](const fence&                               a) { return a.is_shared_ownership_enabled(); },
+				[](const framebuffer&                         a) { return a.is_shared_ownership_enabled(); },
+				[](const graphics_pipeline&                   a) { return a.is_shared_ownership_enabled(); },
+				[](const image&                               a) { return a.is_shared_ownership_enabled(); },
+				[](const image_sampler&                       a) { return a.is_shared_ownership_enabled(); },
+				[](const image_view&                          a) { return a.is_shared_ownership_enabled(); },
+				[](const query_pool&                          a) { return a.is_shared_ownership_enabled(); },
+				[](const ray_tracing_pipeline&                a) { return a.is_shared_ownership_enabled(); },
+				[](const renderpass&                          a) { return a.is_shared_ownership_enabled(); },
+				[](const sampler&                             a) { return a.is_shared_ownership_enabled(); },
+				[](const semaphore&                           a) { return a.is_shared_ownership_enabled(); },
+				[](const top_level_acceleration_structure&    a) { return a.is_shared_ownership_enabled(); }
+			}, mLifetimeHandledResources[i])) {
+				// Copy and possibly reuse in future:
+				aRecordedCommandBuffer.handling_lifetime_of(mLifetimeHandledResources[i]);
+			}
+			else {
+				// Move and remove:
+				aRecordedCommandBuffer.handling_lifetime_of(std::move(mLifetimeHandledResources[i]));
+				mLifetimeHandledResources.erase(std::begin(mLifetimeHandledResources) + i);
+			}
+		}
+	}
+
+	command_stream recorded_commands::into_command_stream()
+	{
+		command_stream result;
+		result.append_lowered(mRecordedCommandsAndSyncInstructions);
+		for (auto& resource : mLifetimeHandledResources) {
+			result.handle_lifetime_of(std::move(resource));
+		}
+		mLifetimeHandledResources.clear();
+		return result;
+	}
+
+	command_stream& command_stream::append_lowered(const std::vector<recorded_commands_t>& aRecordedCommandsAndSyncInstructions)
+	{
+		const auto resourceStateTracker = resolve_barriers(aRecordedCommandsAndSyncInstructions);
+
+		const int n = static_cast<int>(aRecordedCommandsAndSyncInstructions.size());
+		for (int i = 0; i < n; ++i) {
+			// Runs of consecutive sync_type_commands are lowered into as few pipeline_barrier commands as possible:
+			if (is_batchable_barrier(aRecordedCommandsAndSyncInstructions[i])) {
+				int runEnd = i + 1;
+				while (runEnd < n && is_batchable_barrier(aRecordedCommandsAndSyncInstructions[runEnd])) {
+					++runEnd;
+				}
+				batch_barriers(aRecordedCommandsAndSyncInstructions, resourceStateTracker.value(), i, runEnd, [this](
+					const std::vector<vk::MemoryBarrier2KHR>& bMemoryBarriers,
+					const std::vector<vk::ImageMemoryBarrier2KHR>& bImageMemoryBarriers,
+					const std::vector<vk::BufferMemoryBarrier2KHR>& bBufferMemoryBarriers
+				) {
+					pipeline_barrier(bMemoryBarriers, bImageMemoryBarriers, bBufferMemoryBarriers);
+				});
+				i = runEnd - 1;
+				continue;
+			}
+
+			// The halves of split barriers become callbacks which set or wait for the event:
+			if (std::holds_alternative<sync::sync_type_command>(aRecordedCommandsAndSyncInstructions[i])) {
+				callback([lSyncCmd = with_resolved_scopes(std::get<sync::sync_type_command>(aRecordedCommandsAndSyncInstructions[i]), resourceStateTracker.value(), i)](avk::command_buffer_t& cb) {
+					record_into_command_buffer(cb,
+#ifdef AVK_USE_SYNCHRONIZATION2_INSTEAD_OF_CORE
+						cb.root_ptr()->dispatch_loader_ext(),
+#else
+						cb.root_ptr()->dispatch_loader_core(),
+#endif
+						lSyncCmd, sync::resource_state_tracker{}, 0);
+				});
+				continue;
+			}
+
+			std::visit(lambda_overload{
+				[this](const command::state_type_command& bStateCmd) {
+					if (nullptr != bStateCmd.mLower) {
+						append_lowered_command(bStateCmd.lowered());
+					}
+					else if (bStateCmd.mFun) {
+						callback(bStateCmd.mFun);
+					}
+				},
+				[this](const command::action_type_command& bActionCmd) {
+					if (nullptr != bActionCmd.mLower) {
+						append_lowered_command(bActionCmd.lowered());
+					}
+					else if (bActionCmd.mBeginFun) {
+						callback(bActionCmd.mBeginFun);
+					}
+					if (!bActionCmd.mNestedCommandsAndSyncInstructions.empty()) {
+						append_lowered(bActionCmd.mNestedCommandsAndSyncInstructions);
+					}
+					if (bActionCmd.mEndFun) {
+						callback(bActionCmd.mEndFun);
+					}
+				},
+				[](const sync::sync_type_command&) {
+					assert(false); // Handled above
+				}
+			}, aRecordedCommandsAndSyncInstructions[i]);
+		}
+		return *this;
+	}
+
+	void command_stream::append_lowered_command(const command::lowered_command& aLoweredCommand)
+	{
+		std::visit(lambda_overload{
+			[](const std::monostate&) {
+				assert(false); // Must be handled by the caller
+			},
+			[this](const command::lowered::bind_pipeline& bCmd) {
+				bind_pipeline(bCmd.mBindPoint, bCmd.mPipeline);
+			},
+			[this](const command::lowered::bind_descriptors& bCmd) {
+				// Only consecutively numbered sets can be bound at once (same as in command_buffer_t::bind_descriptors):
+				std::vector<vk::DescriptorSet> handles;
+				size_t i = 0;
+				while (i < bCmd.mSets.size()) {
+					const auto firstSet = std::get<uint32_t>(bCmd.mSets[i]);
+					handles.clear();
+					do {
+						handles.push_back(std::get<vk::DescriptorSet>(bCmd.mSets[i + handles.size()]));
+					} while (i + handles.size() < bCmd.mSets.size() && std::get<uint32_t>(bCmd.mSets[i + handles.size()]) == firstSet + handles.size());
+					bind_descriptor_sets(bCmd.mBindPoint, bCmd.mLayout, firstSet, handles);
+					i += handles.size();
+				}
+			},
+			[this](const command::lowered::push_constants& bCmd) {
+				push_constants(bCmd.mLayout, bCmd.mStages, bCmd.mOffset, std::span<const std::byte>{ bCmd.mData });
+			},
+			[this](const command::lowered::draw& bCmd) {
+				if (!bCmd.mVertexBuffers.empty()) {
+					bind_vertex_buffers(0u, bCmd.mVertexBuffers, bCmd.mVertexBufferOffsets);
+				}
+				draw(bCmd.mVertexCount, bCmd.mInstanceCount, bCmd.mFirstVertex, bCmd.mFirstInstance);
+			},
+			[this](const command::lowered::draw_indexed& bCmd) {
+				if (!bCmd.mVertexBuffers.empty()) {
+					bind_vertex_buffers(0u, bCmd.mVertexBuffers, bCmd.mVertexBufferOffsets);
+				}
+				bind_index_buffer(bCmd.mIndexBuffer, 0u, bCmd.mIndexType);
+				draw_indexed(bCmd.mIndexCount, bCmd.mInstanceCount, bCmd.mFirstIndex, bCmd.mVertexOffset, bCmd.mFirstInstance);
+			},
+			[this](const command::lowered::dispatch& bCmd) {
+				dispatch(bCmd.mGroupCountX, bCmd.mGroupCountY, bCmd.mGroupCountZ);
+			},
+			[this](const command::lowered::copy_buffer& bCmd) {
+				copy_buffer(bCmd.mSrcBuffer, bCmd.mDstBuffer, std::span<const vk::BufferCopy>{ &bCmd.mRegion, 1 });
+			}
+		}, aLoweredCommand);
+	}
+
+	void command_stream::record_into(command_buffer_t& aCommandBuffer) const
+	{
+		const auto cmdBfr = aCommandBuffer.handle();
+		const auto& dispatchLoaderCore = aCommandBuffer.root_ptr()->dispatch_loader_core();
+		// Reads the trivially copyable header or payload at the given position:
+		const auto read = [](const std::byte* aPosition, auto& aTarget) {
+			std::memcpy(&aTarget, aPosition, sizeof(aTarget));
+		};
+
+		const std::byte* cursor = mData.data();
+		const std::byte* const end = cursor + mData.size();
+		while (cursor < end) {
+			command_header header;
+			read(cursor, header);
+			const std::byte* payload = cursor + aligned_size(sizeof(command_header));
+			cursor = payload + header.mPayloadSize;
+
+			switch (header.mOp) {
+			case command_stream_op::bind_pipeline: {
+				bind_pipeline_data d;
+				read(payload, d);
+				cmdBfr.bindPipeline(d.mBindPoint, d.mPipeline, dispatchLoaderCore);
+				break;
+			}
+			case command_stream_op::bind_descriptor_sets: {
+				bind_descriptor_sets_data d;
+				read(payload, d);
+				const std::byte* sets = payload + aligned_size(sizeof(d));
+				const std::byte* offsets = sets + aligned_size(d.mDescriptorSetCount * sizeof(vk::DescriptorSet));
+				cmdBfr.bindDescriptorSets(d.mBindPoint, d.mLayout, d.mFirstSet,
+					d.mDescriptorSetCount, reinterpret_cast<const vk::DescriptorSet*>(sets),
+					d.mDynamicOffsetCount, reinterpret_cast<const uint32_t*>(offsets),
+					dispatchLoaderCore);
+				break;
+			}
+			case command_stream_op::push_constants: {
+				push_constants_data d;
+				read(payload, d);
+				cmdBfr.pushConstants(d.mLayout, d.mStages, d.mOffset, d.mSize, payload + aligned_size(sizeof(d)), dispatchLoaderCore);
+				break;
+			}
+			case command_stream_op::bind_vertex_buffers: {
+				bind_vertex_buffers_data d;
+				read(payload, d);
+				const std::byte* buffers = payload + aligned_size(sizeof(d));
+				const std::byte* offsets = buffers + aligned_size(d.mBindingCount * sizeof(vk::Buffer));
+				cmdBfr.bindVertexBuffers(d.mFirstBinding, d.mBindingCount, reinterpret_cast<const vk::Buffer*>(buffers), reinterpret_cast<const vk::DeviceSize*>(offsets), dispatchLoaderCore);
+				break;
+			}
+			case command_stream_op::bind_index_buffer: {
+				bind_index_buffer_data d;
+				read(payload, d);
+				cmdBfr.bindIndexBuffer(d.mBuffer, d.mOffset, d.mIndexType, dispatchLoaderCore);
+				break;
+			}
+			case command_stream_op::draw: {
+				draw_data d;
+				read(payload, d);
+				cmdBfr.draw(d.mVertexCount, d.mInstanceCount, d.mFirstVertex, d.mFirstInstance, dispatchLoaderCore);
+				break;
+			}
+			case command_stream_op::draw_indexed: {
+				draw_indexed_data d;
+				read(payload, d);
+				cmdBfr.drawIndexed(d.mIndexCount, d.mInstanceCount, d.mFirstIndex, d.mVertexOffset, d.mFirstInstance, dispatchLoaderCore);
+				break;
+			}
+			case command_stream_op::dispatch: {
+				dispatch_data d;
+				read(payload, d);
+				cmdBfr.dispatch(d.mGroupCountX, d.mGroupCountY, d.mGroupCountZ, dispatchLoaderCore);
+				break;
+			}
+			case command_stream_op::copy_buffer: {
+				copy_buffer_data d;
+				read(payload, d);
+				cmdBfr.copyBuffer(d.mSrcBuffer, d.mDstBuffer, d.mRegionCount, reinterpret_cast<const vk::BufferCopy*>(payload + aligned_size(sizeof(d))), dispatchLoaderCore);
+				break;
+			}
+			case command_stream_op::pipeline_barrier: {
+				pipeline_barrier_data d;
+				read(payload, d);
+				const std::byte* memoryBarriers = payload + aligned_size(sizeof(d));
+				const std::byte* imageMemoryBarriers = memoryBarriers + aligned_size(d.mMemoryBarrierCount * sizeof(vk::MemoryBarrier2KHR));
+				const std::byte* bufferMemoryBarriers = imageMemoryBarriers + aligned_size(d.mImageMemoryBarrierCount * sizeof(vk::ImageMemoryBarrier2KHR));
+				auto dependencyInfo = vk::DependencyInfoKHR{}
+					.setMemoryBarrierCount(d.mMemoryBarrierCount)
+					.setPMemoryBarriers(reinterpret_cast<const vk::MemoryBarrier2KHR*>(memoryBarriers))
+					.setImageMemoryBarrierCount(d.mImageMemoryBarrierCount)
+					.setPImageMemoryBarriers(reinterpret_cast<const vk::ImageMemoryBarrier2KHR*>(imageMemoryBarriers))
+					.setBufferMemoryBarrierCount(d.mBufferMemoryBarrierCount)
+					.setPBufferMemoryBarriers(reinterpret_cast<const vk::BufferMemoryBarrier2KHR*>(bufferMemoryBarriers));
+#ifdef AVK_USE_SYNCHRONIZATION2_INSTEAD_OF_CORE
+				cmdBfr.pipelineBarrier2KHR(dependencyInfo, aCommandBuffer.root_ptr()->dispatch_loader_ext());
+#else
+				cmdBfr.pipelineBarrier2(dependencyInfo, dispatchLoaderCore);
+#endif
+				break;
+			}
+			case command_stream_op::callback: {
+				callback_data d;
+				read(payload, d);
+				mCallbacks[d.mCallbackIndex](aCommandBuffer);
+				break;
+			}
+			default:
+				throw avk::runtime_error("Unknown command_stream_op[" + std::to_string(static_cast<uint32_t>(header.mOp)) + "] encountered in command_stream.");
+			}
+		}
+	}
+
+	namespace command
+	{
+		action_type_command begin_render_pass_for_framebuffer(const renderpass_t& aRenderpass, const framebuffer_t& aFramebuffer, vk::Offset2D aRenderAreaOffset, std::optional<vk::Extent2D> aRenderAreaExtent, bool aSubpassesInline)
+		{
+			auto result = action_type_command{
+				// Define a sync hint that corresponds to the implicit subpass dependencies (see specification chapter 8.1)
+				avk::sync::sync_hint {
+					{{ // What previous commands must synchronize with:
+						vk::PipelineStageFlagBits2KHR::eAllCommands, // eAllGraphics does not include new stages or ext-stages. Therefore, eAllCommands!
+						vk::AccessFlagBits2KHR::eInputAttachmentRead | vk::AccessFlagBits2KHR::eColorAttachmentRead | vk::AccessFlagBits2KHR::eColorAttachmentWrite | vk::AccessFlagBits2KHR::eDepthStencilAttachmentRead | vk::AccessFlagBits2KHR::eDepthStencilAttachmentWrite
+					}},
+					{{ // What subsequent commands must synchronize with:
+						vk::PipelineStageFlagBits2KHR::eAllCommands, // Same comment as above regarding eAllCommands vs. eAllGraphics
+						vk::AccessFlagBits2KHR::eColorAttachmentWrite | vk::AccessFlagBits2KHR::eDepthStencilAttachmentWrite
+					}}
+				},
+				{},
+				[
+					lRoot = aRenderpass.root_ptr(),
+					lExtent = aFramebuffer.image_view_at(0)->get_image().create_info().extent,
+					lClearValues = aRenderpass.clear_values(),
+					lRenderPassHandle = aRenderpass.handle(),
+					lFramebufferHandle = aFramebuffer.handle(),
+					aRenderAreaOffset, aRenderAreaExtent, aSubpassesInline
+				](avk::command_buffer_t& cb) {
+					// TODO: make vk::SubpassContentscontents state explicit
+					cb.save_subpass_contents_state(aSubpassesInline ? vk::SubpassContents::eInline : vk::SubpassContents::eSecondaryCommandBuffers);
+
+					auto renderPassBeginInfo = vk::RenderPassBeginInfo()
+						.setRenderPass(lRenderPassHandle)
+						.setFramebuffer(lFramebufferHandle)
+						.setRenderArea(vk::Rect2D{}
+							.setOffset(vk::Offset2D{ aRenderAreaOffset.x, aRenderAreaOffset.y })
+							.setExtent(aRenderAreaExtent.has_value()
+										? vk::Extent2D{ aRenderAreaExtent.value() }
+										: vk::Extent2D{ lExtent.width, lExtent.height }
+								)
+							)
+						.setClearValueCount(static_cast<uint32_t>(lClearValues.size()))
+						.setPClearValues(lClearValues.data());
+
+#ifdef AVK_USE_SYNCHRONIZATION2_INSTEAD_OF_CORE
+					cb.handle().beginRenderPass2KHR(
+						renderPassBeginInfo,
+						vk::SubpassBeginInfo{ aSubpassesInline ? vk::SubpassContents::eInline : vk::SubpassContents::eSecondaryCommandBuffers },
+						lRoot->dispatch_loader_ext()
+					);
+#else
+					cb.handle().beginRenderPass2(
+						renderPassBeginInfo,
+						vk::SubpassBeginInfo{ aSubpassesInline ? vk::SubpassContents::eInline : vk::SubpassContents::eSecondaryCommandBuffers },
+						lRoot->dispatch_loader_core()
+					);
+#endif
+				}
+			};
+			result.mRenderPassBoundary = render_pass_boundary{ render_pass_boundary::kind::begin, !aSubpassesInline, aRenderpass.handle(), aFramebuffer.handle() };
+			return result;
+		}
+
+		action_type_command end_render_pass()
+		{
+			auto result = action_type_command{
+				// Define a sync hint that corresponds to the implicit subpass dependencies (see specification chapter 8.1)
+				avk::sync::sync_hint {
+					{{ // What previous commands must synchronize with:
+						vk::PipelineStageFlagBits2KHR::eAllCommands, // eAllGraphics does not include new stages or ext-stages. Therefore, eAllCommands!
+						vk::AccessFlagBits2KHR::eInputAttachmentRead | vk::AccessFlagBits2KHR::eColorAttachmentRead | vk::AccessFlagBits2KHR::eColorAttachmentWrite | vk::AccessFlagBits2KHR::eDepthStencilAttachmentRead | vk::AccessFlagBits2KHR::eDepthStencilAttachmentWrite
+					}},
+					{{ // What subsequent commands must synchronize with:
+						vk::PipelineStageFlagBits2KHR::eAllCommands, // Same comment as above regarding eAllCommands vs. eAllGraphics
+						vk::AccessFlagBits2KHR::eColorAttachmentWrite | vk::AccessFlagBits2KHR::eDepthStencilAttachmentWrite
+					}}
+				},
+				{},
+				[](avk::command_buffer_t& cb) {
+#ifdef AVK_USE_SYNCHRONIZATION2_INSTEAD_OF_CORE
+					cb.handle().endRenderPass2KHR(vk::SubpassEndInfo{}, cb.root_ptr()->dispatch_loader_ext());
+#else
+					cb.handle().endRenderPass2(vk::SubpassEndInfo{}, cb.root_ptr()->dispatch_loader_core());
+#endif
+				}
+			};
+			result.mRenderPassBoundary.mKind = render_pass_boundary::kind::end;
+			return result;
+		}
+		
+		action_type_command render_pass(
+			const renderpass_t& aRenderpass,
+			const framebuffer_t& aFramebuffer,
+			std::vector<recorded_commands_t> aNestedCommands,
+			vk::Offset2D aRenderAreaOffset,
+			std::optional<vk::Extent2D> aRenderAreaExtent,
+			bool aSubpassesInline)
+		{
+			auto tmpBeginRenderPass = begin_render_pass_for_framebuffer(aRenderpass, aFramebuffer, aRenderAreaOffset, aRenderAreaExtent, aSubpassesInline);
+			auto tmpEndRenderPass = end_render_pass();
+
+			auto result = action_type_command{
+				// Define a sync hint that corresponds to the implicit subpass dependencies (see specification chapter 8.1)
+				avk::sync::sync_hint {
+					tmpBeginRenderPass.mSyncHint.mDstForPreviousCmds,
+					tmpEndRenderPass.mSyncHint.mSrcForSubsequentCmds
+				},
+				std::move(tmpBeginRenderPass.mResourceSpecificSyncHints),
+				std::move(tmpBeginRenderPass.mBeginFun),
+				std::move(aNestedCommands),
+				std::move(tmpEndRenderPass.mBeginFun)
+			};
+			result.mRenderPassBoundary.mKind = render_pass_boundary::kind::whole;
+			return result;
+		}
+
+		action_type_command next_subpass(bool aSubpassesInline)
+		{
+			auto result = action_type_command{
+				{}, {}, // Sync hints not applicable here, I guess
+				[aSubpassesInline](avk::command_buffer_t& cb) {
+#ifdef AVK_USE_SYNCHRONIZATION2_INSTEAD_OF_CORE
+					cb.handle().nextSubpass2KHR(
+						vk::SubpassBeginInfo{ aSubpassesInline ? vk::SubpassContents::eInline : vk::SubpassContents::eSecondaryCommandBuffers },
+						vk::SubpassEndInfo{},
+						cb.root_ptr()->dispatch_loader_ext()
+					);
+#else
+					cb.handle().nextSubpass2(
+						vk::SubpassBeginInfo{ aSubpassesInline ? vk::SubpassContents::eInline : vk::SubpassContents::eSecondaryCommandBuffers },
+						vk::SubpassEndInfo{},
+						cb.root_ptr()->dispatch_loader_core()
+					);
+#endif
+				}
+			};
+			result.mRenderPassBoundary.mKind = render_pass_boundary::kind::next_subpass;
+			result.mRenderPassBoundary.mSubpassContentsInSecondaryCommandBuffers = !aSubpassesInline;
+			return result;
+		}
+
+		// Internal helper which creates the compact description of a bind_descriptors command:
+		static lowered::bind_descriptors lowered_bind_descriptors(vk::PipelineBindPoint aBindPoint, vk::PipelineLayout aLayout, const std::vector<descriptor_set>& aDescriptorSets)
+		{
+			lowered::bind_descriptors result{ aBindPoint, aLayout, {} };
+			result.mSets.reserve(aDescriptorSets.size());
+			for (const auto& dset : aDescriptorSets) {
+				result.mSets.emplace_back(dset.set_id(), dset.handle());
+			}
+			return result;
+		}
+
+		state_type_command bind_pipeline(const graphics_pipeline_t& aPipeline)
+		{
+			auto fun = [
+					lPipelineHandle = aPipeline.handle()
+				] (auto& aTarget) {
+					if constexpr (is_lowering_target_v<decltype(aTarget)>) {
+						aTarget = lowered::bind_pipeline{ vk::PipelineBindPoint::eGraphics, lPipelineHandle };
+					}
+					else {
+						aTarget.handle().bindPipeline(vk::PipelineBindPoint::eGraphics, lPipelineHandle);
+					}
+				};
+			return state_type_command{ fun, &lower_recording_function<decltype(fun)> };
+		}
+
+		state_type_command bind_pipeline(const compute_pipeline_t& aPipeline)
+		{
+			auto fun = [
+					lPipelineHandle = aPipeline.handle()
+				] (auto& aTarget) {
+					if constexpr (is_lowering_target_v<decltype(aTarget)>) {
+						aTarget = lowered::bind_pipeline{ vk::PipelineBindPoint::eCompute, lPipelineHandle };
+					}
+					else {
+						aTarget.handle().bindPipeline(vk::PipelineBindPoint::eCompute, lPipelineHandle);
+					}
+				};
+			return state_type_command{ fun, &lower_recording_function<decltype(fun)> };
+		}
+
+#if VK_HEADER_VERSION >= 135
+		state_type_command bind_pipeline(const ray_tracing_pipeline_t& aPipeline)
+		{
+			auto fun = [
+					lPipelineHandle = aPipeline.handle()
+				] (auto& aTarget) {
+					if constexpr (is_lowering_target_v<decltype(aTarget)>) {
+						aTarget = lowered::bind_pipeline{ vk::PipelineBindPoint::eRayTracingKHR, lPipelineHandle };
+					}
+					else {
+						aTarget.handle().bindPipeline(vk::PipelineBindPoint::eRayTracingKHR, lPipelineHandle);
+					}
+				};
+			return state_type_command{ fun, &lower_recording_function<decltype(fun)> };
+		}
+#endif
+
+		state_type_command bind_descriptors(std::tuple<const graphics_pipeline_t*, const vk::PipelineLayout, const std::vector<vk::PushConstantRange>*> aPipelineLayout, std::vector<descriptor_set> aDescriptorSets)
+		{
+			auto fun = [
+					lLayoutHandle = std::get<const graphics_pipeline_t*>(aPipelineLayout)->layout_handle(),
+					lDescriptorSets = std::move(aDescriptorSets)
+				] (auto& aTarget) {
+					if constexpr (is_lowering_target_v<decltype(aTarget)>) {
+						aTarget = lowered_bind_descriptors(vk::PipelineBindPoint::eGraphics, lLayoutHandle, lDescriptorSets);
+					}
+					else {
+						aTarget.bind_descriptors(
+							vk::PipelineBindPoint::eGraphics,
+							lLayoutHandle,
+							lDescriptorSets // Attention: Copy! => Potentially expensive?! TODO: What was the reason for bind_descriptors requiring std::vector<descriptor_set> being passed by value?
+						);
+					}
+				};
+			return state_type_command{ fun, &lower_recording_function<decltype(fun)> };
+		}
+
+		state_type_command bind_descriptors(std::tuple<const compute_pipeline_t*, const vk::PipelineLayout, const std::vector<vk::PushConstantRange>*> aPipelineLayout, std::vector<descriptor_set> aDescriptorSets)
+		{
+			auto fun = [
+					lLayoutHandle = std::get<const compute_pipeline_t*>(aPipelineLayout)->layout_handle(),
+					lDescriptorSets = std::move(aDescriptorSets)
+				] (auto& aTarget) {
+					if constexpr (is_lowering_target_v<decltype(aTarget)>) {
+						aTarget = lowered_bind_descriptors(vk::PipelineBindPoint::eCompute, lLayoutHandle, lDescriptorSets);
+					}
+					else {
+						aTarget.bind_descriptors(
+							vk::PipelineBindPoint::eCompute,
+							lLayoutHandle,
+							lDescriptorSets // Attention: Copy! => Potentially expensive?! TODO: What was the reason for bind_descriptors requiring std::vector<descriptor_set> being passed by value?
+						);
+					}
+				};
+			return state_type_command{ fun, &lower_recording_function<decltype(fun)> };
+		}
+
+#if VK_HEADER_VERSION >= 135
+		state_type_command bind_descriptors(std::tuple<const ray_tracing_pipeline_t*, const vk::PipelineLayout, const std::vector<vk::PushConstantRange>*> aPipelineLayout, std::vector<descriptor_set> aDescriptorSets)
+		{
+			auto fun = [
+					lLayoutHandle = std::get<const ray_tracing_pipeline_t*>(aPipelineLayout)->layout_handle(),
+					lDescriptorSets = std::move(aDescriptorSets)
+				] (auto& aTarget) {
+					if constexpr (is_lowering_target_v<decltype(aTarget)>) {
+						aTarget = lowered_bind_descriptors(vk::PipelineBindPoint::eRayTracingKHR, lLayoutHandle, lDescriptorSets);
+					}
+					else {
+						aTarget.bind_descriptors(
+							vk::PipelineBindPoint::eRayTracingKHR,
+							lLayoutHandle,
+							lDescriptorSets // Attention: Copy! => Potentially expensive?! TODO: What was the reason for bind_descriptors requiring std::vector<descriptor_set> being passed by value?
+						);
+					}
+				};
+			return state_type_command{ fun, &lower_recording_function<decltype(fun)> };
+		}
+#endif 
+
+		action_type_command draw(uint32_t aVertexCount, uint32_t aInstanceCount, uint32_t aFirstVertex, uint32_t aFirstInstance)
+		{
+			auto fun = [aVertexCount, aInstanceCount, aFirstVertex, aFirstInstance](auto& aTarget) {
+				if constexpr (is_lowering_target_v<decltype(aTarget)>) {
+					aTarget = lowered::draw{ {}, {}, aVertexCount, aInstanceCount, aFirstVertex, aFirstInstance };
+				}
+				else {
+					aTarget.handle().draw(aVertexCount, aInstanceCount, aFirstVertex, aFirstInstance, aTarget.root_ptr()->dispatch_loader_core());
+				}
+			};
+			auto result = action_type_command{
+				avk::sync::sync_hint {
+					{{ // What previous commands must synchronize with:
+						vk::PipelineStageFlagBits2KHR::eAllGraphics,
+						vk::AccessFlagBits2KHR::eInputAttachmentRead | vk::AccessFlagBits2KHR::eColorAttachmentRead | vk::AccessFlagBits2KHR::eColorAttachmentWrite | vk::AccessFlagBits2KHR::eDepthStencilAttachmentRead | vk::AccessFlagBits2KHR::eDepthStencilAttachmentWrite
+					}},
+					{{ // What subsequent commands must synchronize with:
+						vk::PipelineStageFlagBits2KHR::eAllGraphics,
+						vk::AccessFlagBits2KHR::eColorAttachmentWrite | vk::AccessFlagBits2KHR::eDepthStencilAttachmentWrite
+					}}
+				},
+				{},
+				fun
+			};
+			result.mLower = &lower_recording_function<decltype(fun)>;
+			return result;
+		}
+
+		action_type_command dispatch(uint32_t aGroupCountX, uint32_t aGroupCountY, uint32_t aGroupCountZ)
+		{
+			auto fun = [aGroupCountX, aGroupCountY, aGroupCountZ](auto& aTarget) {
+				if constexpr (is_lowering_target_v<decltype(aTarget)>) {
+					aTarget = lowered::dispatch{ aGroupCountX, aGroupCountY, aGroupCountZ };
+				}
+				else {
+					aTarget.handle().dispatch(aGroupCountX, aGroupCountY, aGroupCountZ, aTarget.root_ptr()->dispatch_loader_core());
+				}
+			};
+			auto result = action_type_command{
+				avk::sync::sync_hint {
+					{{ // What previous commands must synchronize with:
+						vk::PipelineStageFlagBits2KHR::eComputeShader,
+						vk::AccessFlagBits2KHR::eShaderSampledRead | vk::AccessFlagBits2KHR::eShaderStorageRead | vk::AccessFlagBits2KHR::eShaderStorageWrite
+					}},
+					{{ // What subsequent commands must synchronize with:
+						vk::PipelineStageFlagBits2KHR::eComputeShader,
+						vk::AccessFlagBits2KHR::eShaderStorageWrite
+					}}
+				},
+				{},
+				fun
+			};
+			result.mLower = &lower_recording_function<decltype(fun)>;
+			return result;
+		}
+		
+		action_type_command dispatch_indirect(const buffer_t& aParametersBuffer, vk::DeviceSize aParametersOffset)
+		{
+			return action_type_command{
+				avk::sync::sync_hint {
+					{{ // What previous commands must synchronize with:
+						vk::PipelineStageFlagBits2KHR::eDrawIndirect | vk::PipelineStageFlagBits2KHR::eComputeShader,
+						vk::AccessFlagBits2KHR::eIndirectCommandRead | vk::AccessFlagBits2KHR::eShaderSampledRead | vk::AccessFlagBits2KHR::eShaderStorageRead | vk::AccessFlagBits2KHR::eShaderStorageWrite
+					}},
+					{{ // What subsequent commands must synchronize with:
+						vk::PipelineStageFlagBits2KHR::eComputeShader,
+						vk::AccessFlagBits2KHR::eShaderStorageWrite
+					}}
+				},
+				{
+					// The parameters are only read by the indirect command processing:
+					std::make_tuple(aParametersBuffer.handle(), avk::sync::sync_hint{ stage::draw_indirect + access::indirect_command_read, stage::draw_indirect + access::none, {}, std::make_tuple(aParametersOffset, static_cast<vk::DeviceSize>(sizeof(vk::DispatchIndirectCommand))) })
+				},
+				[lParametersBufferHandle = aParametersBuffer.handle(), aParametersOffset](avk::command_buffer_t& cb) {
+					cb.handle().dispatchIndirect(lParametersBufferHandle, aParametersOffset, cb.root_ptr()->dispatch_loader_core());
+				}
+			};
+		}
+
+		action_type_command draw_indirect(const buffer_t& aParametersBuffer, uint32_t aNumberOfDraws, vk::DeviceSize aParametersOffset, uint32_t aParametersStride)
+		{
+			const auto parametersSize = 0u == aNumberOfDraws ? vk::DeviceSize{ 0 } : static_cast<vk::DeviceSize>(aNumberOfDraws - 1) * aParametersStride + static_cast<vk::DeviceSize>(sizeof(vk::DrawIndirectCommand));
+			return action_type_command{
+				avk::sync::sync_hint {
+					{{ // What previous commands must synchronize with:
+						vk::PipelineStageFlagBits2KHR::eDrawIndirect | vk::PipelineStageFlagBits2KHR::eAllGraphics,
+						vk::AccessFlagBits2KHR::eIndirectCommandRead | vk::AccessFlagBits2KHR::eInputAttachmentRead | vk::AccessFlagBits2KHR::eColorAttachmentRead | vk::AccessFlagBits2KHR::eColorAttachmentWrite | vk::AccessFlagBits2KHR::eDepthStencilAttachmentRead | vk::AccessFlagBits2KHR::eDepthStencilAttachmentWrite
+					}},
+					{{ // What subsequent commands must synchronize with:
+						vk::PipelineStageFlagBits2KHR::eAllGraphics,
+						vk::AccessFlagBits2KHR::eColorAttachmentWrite | vk::AccessFlagBits2KHR::eDepthStencilAttachmentWrite
+					}}
+				},
+				{
+					// The parameters are only read by the indirect command processing:
+					std::make_tuple(aParametersBuffer.handle(), avk::sync::sync_hint{ stage::draw_indirect + access::indirect_command_read, stage::draw_indirect + access::none, {}, std::make_tuple(aParametersOffset, parametersSize) })
+				},
+				[lParametersBufferHandle = aParametersBuffer.handle(), aNumberOfDraws, aParametersOffset, aParametersStride](avk::command_buffer_t& cb) {
+					cb.handle().drawIndirect(lParametersBufferHandle, aParametersOffset, aNumberOfDraws, aParametersStride, cb.root_ptr()->dispatch_loader_core());
+				}
+			};
+		}
+
+		action_type_command draw_mesh_tasks_nv(uint32_t aTaskCount, uint32_t aFirstTask)
+		{
+			return action_type_command{
+				avk::sync::sync_hint {
+					{{ // What previous commands must synchronize with:
+						vk::PipelineStageFlagBits2KHR::eAllGraphics,
+						vk::AccessFlagBits2KHR::eInputAttachmentRead
+					    | vk::AccessFlagBits2KHR::eColorAttachmentRead
+					    | vk::AccessFlagBits2KHR::eColorAttachmentWrite
+					    | vk::AccessFlagBits2KHR::eDepthStencilAttachmentRead
+					    | vk::AccessFlagBits2KHR::eDepthStencilAttachmentWrite
+						| vk::AccessFlagBits2KHR::eShaderStorageRead // Because we must expect to read data from buffers
+					}},
+					{{ // What subsequent commands must synchronize with:
+						vk::PipelineStageFlagBits2KHR::eAllGraphics,
+						vk::AccessFlagBits2KHR::eColorAttachmentWrite | vk::AccessFlagBits2KHR::eDepthStencilAttachmentWrite
+					}}
+				},
+				{},
+				[aTaskCount, aFirstTask](avk::command_buffer_t& cb) {
+					cb.handle().drawMeshTasksNV(aTaskCount, aFirstTask, cb.root_ptr()->dispatch_loader_ext());
+				}
+			};
+		}
+
+#if VK_HEADER_VERSION >= 239
+		action_type_command draw_mesh_tasks_ext(uint32_t aGroupCountX, uint32_t aGroupCountY, uint32_t aGroupCountZ)
+		{
+			return action_type_command{
+				avk::sync::sync_hint {
+					{{ // What previous commands must synchronize with:
+						vk::PipelineStageFlagBits2KHR::eAllGraphics,
+						vk::AccessFlagBits2KHR::eInputAttachmentRead
+						| vk::AccessFlagBits2KHR::eColorAttachmentRead
+						| vk::AccessFlagBits2KHR::eColorAttachmentWrite
+						| vk::AccessFlagBits2KHR::eDepthStencilAttachmentRead
+						| vk::AccessFlagBits2KHR::eDepthStencilAttachmentWrite
+						| vk::AccessFlagBits2KHR::eShaderStorageRead // Because we must expect to read data from buffers
+					}},
+					{{ // What subsequent commands must synchronize with:
+						vk::PipelineStageFlagBits2KHR::eAllGraphics,
+						vk::AccessFlagBits2KHR::eColorAttachmentWrite | vk::AccessFlagBits2KHR::eDepthStencilAttachmentWrite
+					}}
+				},
+				{},
+				[aGroupCountX, aGroupCountY, aGroupCountZ](avk::command_buffer_t& cb) {
+					cb.handle().drawMeshTasksEXT(aGroupCountX, aGroupCountY, aGroupCountZ, cb.root_ptr()->dispatch_loader_ext());
+				}
+			};
+		}
+#endif
+
+
+#if VK_HEADER_VERSION >= 135
+		action_type_command trace_rays(
+			vk::Extent3D aRaygenDimensions,
+			const shader_binding_table_ref& aShaderBindingTableRef,
+#if VK_HEADER_VERSION >= 162
+			const vk::StridedDeviceAddressRegionKHR& aRaygenSbtRef,
+			const vk::StridedDeviceAddressRegionKHR& aRaymissSbtRef,
+			const vk::StridedDeviceAddressRegionKHR& aRayhitSbtRef,
+			const vk::StridedDeviceAddressRegionKHR& aCallableSbtRef
+
+#else
+			const vk::StridedBufferRegionKHR& aRaygenSbtRef,
+			const vk::StridedBufferRegionKHR& aRaymissSbtRef,
+			const vk::StridedBufferRegionKHR& aRayhitSbtRef,
+			const vk::StridedBufferRegionKHR& aCallableSbtRef
+#endif
+		)
+		{
+			return action_type_command{
+				avk::sync::sync_hint {
+					stage::ray_tracing_shader + access::acceleration_structure_read,
+					stage::ray_tracing_shader + access::none
+				},
+				{}, // no resource-specific sync hints
+				[
+					lSbtHandle = aShaderBindingTableRef.mSbtBufferHandle,
+					lEntrySize = aShaderBindingTableRef.mSbtEntrySize,
+					lRaygenSbtRef = aRaygenSbtRef,
+					lRaymissSbtRef = aRaymissSbtRef,
+					lRayhitSbtRef = aRayhitSbtRef,
+					lCallableSbtRef = aCallableSbtRef,
+					aRaygenDimensions
+				](avk::command_buffer_t& cb) {
+					cb.handle().traceRaysKHR(
+						&lRaygenSbtRef, &lRaymissSbtRef, &lRayhitSbtRef, &lCallableSbtRef,
+						aRaygenDimensions.width, aRaygenDimensions.height, aRaygenDimensions.depth,
+						cb.root_ptr()->dispatch_loader_ext()
+					);
+				}
+			};
+		}
+#endif
+	}
+
+	submission_data::submission_data(submission_data&& aOther) noexcept
+		: mRoot{ std::move(aOther.mRoot) }
+		, mCommandBufferToSubmit{ std::move(aOther.mCommandBufferToSubmit) }
+		, mQueueToSubmitTo{ std::move(aOther.mQueueToSubmitTo) }
+		, mSemaphoreWaits{ std::move(aOther.mSemaphoreWaits) }
+		, mSemaphoreSignals{ std::move(aOther.mSemaphoreSignals) }
+		, mFence{ std::move(aOther.mFence) }
+		, mSubmissionCount{ std::move(aOther.mSubmissionCount) }
+		, mDangerousRecordedCommandBufferPointer{ aOther.mDangerousRecordedCommandBufferPointer }
+	{
+		aOther.mRoot = nullptr;
+		aOther.mQueueToSubmitTo = nullptr;
+		aOther.mSemaphoreWaits.clear();
+		aOther.mSemaphoreSignals.clear();
+		aOther.mFence.reset();
+		aOther.mSubmissionCount = 0u;
+	}
+
+	submission_data& submission_data::operator=(submission_data&& aOther) noexcept
+	{
+		mRoot = std::move(aOther.mRoot);
+		mCommandBufferToSubmit = std::move(aOther.mCommandBufferToSubmit);
+		mQueueToSubmitTo = std::move(aOther.mQueueToSubmitTo);
+		mSemaphoreWaits = std::move(aOther.mSemaphoreWaits);
+		mSemaphoreSignals = std::move(aOther.mSemaphoreSignals);
+		mFence = std::move(aOther.mFence);
+		mSubmissionCount = std::move(aOther.mSubmissionCount);
+		mDangerousRecordedCommandBufferPointer = aOther.mDangerousRecordedCommandBufferPointer;
+
+		aOther.mRoot = nullptr;
+		aOther.mQueueToSubmitTo = nullptr;
+		aOther.mSemaphoreWaits.clear();
+		aOther.mSemaphoreSignals.clear();
+		aOther.mFence.reset();
+		aOther.mSubmissionCount = 0u;
+
+		return *this;
+	}
+
+	submission_data::~submission_data() noexcept(false)
+	{
+		if (is_sane() && 0 == mSubmissionCount) { // TODO: PROBLEM HERE due to auto submission = .... in imgui_manager.cpp#L337
+			submit();
+		}
+	}
+
+	submission_data& submission_data::submit_to(const queue& aQueue)
+	{
+		mQueueToSubmitTo = &aQueue;
+		return *this;
+	}
+
+	submission_data& submission_data::waiting_for(avk::semaphore_wait_info aWaitInfo)
+	{
+		mSemaphoreWaits.push_back(std::move(aWaitInfo));
+		return *this;
+	}
+
+	submission_data& submission_data::waiting_for(avk::resource_argument<avk::semaphore_t> aTimelineSemaphore, uint64_t aValue, avk::stage::pipeline_stage_flags aDstStage)
+	{
+		assert(aTimelineSemaphore->is_timeline_semaphore());
+		return waiting_for(semaphore_wait_info{ std::move(aTimelineSemaphore), aDstStage, aValue });
+	}
+
+	submission_data& submission_data::signaling_upon_completion(semaphore_signal_info aSignalInfo)
+	{
+		mSemaphoreSignals.push_back(std::move(aSignalInfo));
+		return *this;
+	}
+
+	submission_data& submission_data::signaling_upon_completion(avk::resource_argument<avk::semaphore_t> aTimelineSemaphore, uint64_t aValue, avk::stage::pipeline_stage_flags aSrcStage)
+	{
+		assert(aTimelineSemaphore->is_timeline_semaphore());
+		return signaling_upon_completion(semaphore_signal_info{ aSrcStage, std::move(aTimelineSemaphore), aValue });
+	}
+
+	submission_data& submission_data::signaling_upon_completion(avk::resource_argument<avk::fence_t> aFence)
+	{
+		mFence = std::move(aFence);
+		return *this;
+	}
+
+	submission_data&& submission_data::store_for_now() noexcept
+	{
+		return std::move(*this);
+	}
+
+	void submission_data::gather_semaphore_submit_infos(std::vector<vk::SemaphoreSubmitInfoKHR>& aWaitInfos, std::vector<vk::SemaphoreSubmitInfoKHR>& aSignalInfos) const
+	{
+		// Gather config for wait semaphores:
+		for (auto& semWait : mSemaphoreWaits) {
+			auto& subInfo = aWaitInfos.emplace_back(semWait.mWaitSemaphore->handle(), semWait.mValue); // The value is ignored for binary semaphores
+			std::visit(lambda_overload{
+				[&subInfo](const std::monostate&) {
+					subInfo.setStageMask(vk::PipelineStageFlagBits2KHR::eNone);
+				},
+				[&subInfo](const vk::PipelineStageFlags2KHR& aFixedStage) {
+					subInfo.setStageMask(aFixedStage);
+				},
+				[&subInfo, this](const avk::stage::auto_stage_t& aAutoStage) {
+					// Set something:
+					subInfo.setStageMask(vk::PipelineStageFlagBits2KHR::eAllCommands);
+					// But now try to find a tighter auto-stage:
+					auto* prevPtr = recorded_command_buffer_ptr();
+					if (nullptr != prevPtr) {
+						auto* prevPrevPtr = prevPtr->recorded_commands_ptr();
+						if (nullptr != prevPrevPtr) {
+							subInfo.setStageMask(accumulate_sync_details<vk::PipelineStageFlags2KHR>(
+								prevPrevPtr->recorded_commands_and_sync_instructions(),
+								/* Start index: within std::vector<recorded_commands_t>: */ 0,
+								/* How many steps to accumulate: */ static_cast<uint32_t>(aAutoStage),
+								/* after-wards: */  1,
+								/* If we can't determine something specific, employ a heavy access mask to ensure correctness: */ vk::PipelineStageFlagBits2KHR::eAllCommands,
+								{} // <-- For the semaphore signal, we do not want to restrict looking for specific images or buffers; everything is relevant
+							));
+						}
+					}
+				}
+			}, semWait.mDstStage.mFlags);
+		}
+
+		// Gather config for signal semaphores:
+		for (auto& semSig : mSemaphoreSignals) {
+			auto& subInfo = aSignalInfos.emplace_back(semSig.mSignalSemaphore->handle(), semSig.mValue); // The value is ignored for binary semaphores
+			std::visit(lambda_overload{
+				[&subInfo](const std::monostate&) {
+					subInfo.setStageMask(vk::PipelineStageFlagBits2KHR::eNone);
+				},
+				[&subInfo](const vk::PipelineStageFlags2KHR& lFixedStage) {
+					subInfo.setStageMask(lFixedStage);
+				},
+				[&subInfo, this](const avk::stage::auto_stage_t& lAutoStage) {
+					// Set something:
+					subInfo.setStageMask(vk::PipelineStageFlagBits2KHR::eAllCommands);
+					// But now try to find a tighter auto-stage:
+					auto* prevPtr = recorded_command_buffer_ptr();
+					if (nullptr != prevPtr) {
+						auto* prevPrevPtr = prevPtr->recorded_commands_ptr();
+						if (nullptr != prevPrevPtr) {
+							subInfo.setStageMask(accumulate_sync_details<vk::PipelineStageFlags2KHR>(
+								prevPrevPtr->recorded_commands_and_sync_instructions(),
+								/* Start index: within std::vector<recorded_commands_t>: */ static_cast<int>(prevPrevPtr->recorded_commands_and_sync_instructions().size()) - 1,
+								/* How many steps to accumulate: */ static_cast<uint32_t>(lAutoStage),
+								/* before-wards: */  -1,
+								/* If we can't determine something specific, employ a heavy access mask to ensure correctness: */ vk::PipelineStageFlagBits2KHR::eAllCommands,
+								{} // <-- For the semaphore signal, we do not want to restrict looking for specific images or buffers; everything is relevant
+							));
+						}
+					}
+				}
+				}, semSig.mSrcStage.mFlags);
+		}
+	}
+
+	// Submits the given submit infos with one call to vkQueueSubmit2 and warns about errors
+	static void submit_to_queue(const root& aRoot, const queue& aQueue, const std::vector<vk::SubmitInfo2KHR>& aSubmitInfos, vk::Fence aFence)
+	{
+#ifdef AVK_USE_SYNCHRONIZATION2_INSTEAD_OF_CORE
+		auto errorCode = aQueue.handle().submit2KHR(static_cast<uint32_t>(aSubmitInfos.size()), aSubmitInfos.data(), aFence, aRoot.dispatch_loader_ext());
+		if (vk::Result::eSuccess != errorCode) {
+			AVK_LOG_WARNING("submit2KHR returned " + vk::to_string(errorCode));
+		}
+#else
+		auto errorCode = aQueue.handle().submit2(static_cast<uint32_t>(aSubmitInfos.size()), aSubmitInfos.data(), aFence, aRoot.dispatch_loader_core());
+		if (vk::Result::eSuccess != errorCode) {
+			AVK_LOG_WARNING("submit2 returned " + vk::to_string(errorCode));
+		}
+#endif
+	}
+
+	void submission_data::submit()
+	{
+		std::vector<vk::SemaphoreSubmitInfoKHR> waitSem;
+		std::vector<vk::SemaphoreSubmitInfoKHR> signalSem;
+		gather_semaphore_submit_infos(waitSem, signalSem);
+
+		auto cmdBfrSubmitInfo = vk::CommandBufferSubmitInfoKHR{}
+		.setCommandBuffer(mCommandBufferToSubmit->handle());
+
+		std::vector<vk::SubmitInfo2KHR> submitInfo{ vk::SubmitInfo2KHR{}
+			.setWaitSemaphoreInfoCount(static_cast<uint32_t>(waitSem.size()))
+			.setPWaitSemaphoreInfos(waitSem.data())
+			.setCommandBufferInfoCount(1u)
+			.setPCommandBufferInfos(&cmdBfrSubmitInfo)
+			.setSignalSemaphoreInfoCount(static_cast<uint32_t>(signalSem.size()))
+			.setPSignalSemaphoreInfos(signalSem.data())
+		};
+
+		auto fenceHandle = mFence.has_value() ? mFence.value()->handle() : vk::Fence{};
+		submit_to_queue(*mRoot, *mQueueToSubmitTo, submitInfo, fenceHandle);
+
+		++mSubmissionCount;
+	}
+
+#pragma endregion
+
+#pragma region block_allocator definitions
+	tlsf_free_list::tlsf_free_list(vk::DeviceSize aSize)
+		: mSize{ aSize }
+	{
+		assert(aSize > 0);
+		mSlBitmaps.fill(0u);
+		for (auto& heads : mFreeHeads) {
+			heads.fill(no_chunk);
+		}
+		mChunks.push_back(chunk{ 0, aSize, no_chunk, no_chunk, no_chunk, no_chunk, true });
+		insert_free(0);
+	}
+
+	std::tuple<uint32_t, uint32_t> tlsf_free_list::list_index(vk::DeviceSize aSize)
+	{
+		if (aSize < sl_count) {
+			return { 0u, static_cast<uint32_t>(aSize) };
+		}
+		const auto msb = static_cast<uint32_t>(63 - std::countl_zero(static_cast<uint64_t>(aSize)));
+		return { msb - sl_bits + 1, static_cast<uint32_t>(aSize >> (msb - sl_bits)) ^ sl_count };
+	}
+
+	uint32_t tlsf_free_list::new_chunk()
+	{
+		if (!mUnusedChunks.empty()) {
+			const auto index = mUnusedChunks.back();
+			mUnusedChunks.pop_back();
+			return index;
+		}
+		mChunks.emplace_back();
+		return static_cast<uint32_t>(mChunks.size() - 1);
+	}
+
+	void tlsf_free_list::release_chunk(uint32_t aChunk)
+	{
+		mUnusedChunks.push_back(aChunk);
+	}
+
+	void tlsf_free_list::insert_free(uint32_t aChunk)
+	{
+		const auto [fl, sl] = list_index(mChunks[aChunk].mSize);
+		auto& head = mFreeHeads[fl][sl];
+		mChunks[aChunk].mPrevFree = no_chunk;
+		mChunks[aChunk].mNextFree = head;
+		if (no_chunk != head) {
+			mChunks[head].mPrevFree = aChunk;
+		}
+		head = aChunk;
+		mSlBitmaps[fl] |= 1u << sl;
+		mFlBitmap |= uint64_t{ 1 } << fl;
+	}
+
+	void tlsf_free_list::remove_free(uint32_t aChunk)
+	{
+		const auto [fl, sl] = list_index(mChunks[aChunk].mSize);
+		const auto prev = mChunks[aChunk].mPrevFree;
+		const auto next = mChunks[aChunk].mNextFree;
+		if (no_chunk != prev) {
+			mChunks[prev].mNextFree = next;
+		}
+		if (no_chunk != next) {
+			mChunks[next].mPrevFree = prev;
+		}
+		auto& head = mFreeHeads[fl][sl];
+		if (head == aChunk) {
+			head = next;
+			if (no_chunk == head) {
+				mSlBitmaps[fl] &= ~(1u << sl);
+				if (0 == mSlBitmaps[fl]) {
+					mFlBitmap &= ~(uint64_t{ 1 } << fl);
+				}
+			}
+		}
+	}
+
+	std::optional<std::tuple<vk::DeviceSize, uint32_t>> tlsf_free_list::allocate(vk::DeviceSize aSize, vk::DeviceSize aAlignment)
+	{
+		assert(aSize > 0);
+		aAlignment = std::max(aAlignment, vk::DeviceSize{ 1 });
+
+		// Every chunk which has (at least) this size can hold the range, regardless of its offset:
+		auto requiredSize = aSize + aAlignment - 1;
+		// Round up to the start of the next list, s.t. every chunk of the list that is found is large enough (good fit):
+		if (requiredSize >= sl_count) {
+			const auto msb = static_cast<uint32_t>(63 - std::countl_zero(static_cast<uint64_t>(requiredSize)));
+			requiredSize += (vk::DeviceSize{ 1 } << (msb - sl_bits)) - 1;
+		}
+		auto [fl, sl] = list_index(requiredSize);
+		if (fl >= fl_count) {
+			return {};
+		}
+
+		// Find the first non-empty list of the same first-level class, or of the next larger one:
+		auto slMap = mSlBitmaps[fl] & (~0u << sl);
+		if (0 == slMap) {
+			const auto flMap = fl + 1 < fl_count ? mFlBitmap & (~uint64_t{ 0 } << (fl + 1)) : uint64_t{ 0 };
+			if (0 == flMap) {
+				return {};
+			}
+			fl = static_cast<uint32_t>(std::countr_zero(flMap));
+			slMap = mSlBitmaps[fl];
+		}
+		sl = static_cast<uint32_t>(std::countr_zero(slMap));
+		const auto c = mFreeHeads[fl][sl];
+		assert(no_chunk != c && mChunks[c].mSize >= aSize + aAlignment - 1);
+		remove_free(c);
+
+		// Split off the padding in front of the aligned offset. The previous chunk is in use (otherwise it would have been
+		// merged with this one), therefore, the padding is a free chunk on its own:
+		const auto alignedOffset = (mChunks[c].mOffset + aAlignment - 1) / aAlignment * aAlignment;
+		if (alignedOffset > mChunks[c].mOffset) {
+			const auto p = new_chunk();
+			const auto prev = mChunks[c].mPrevPhysical;
+			mChunks[p] = chunk{ mChunks[c].mOffset, alignedOffset - mChunks[c].mOffset, prev, c, no_chunk, no_chunk, true };
+			if (no_chunk != prev) {
+				mChunks[prev].mNextPhysical = p;
+			}
+			mChunks[c].mPrevPhysical = p;
+			mChunks[c].mSize -= mChunks[p].mSize;
+			mChunks[c].mOffset = alignedOffset;
+			insert_free(p);
+		}
+
+		return take(c, aSize);
+	}
+
+	std::optional<std::tuple<vk::DeviceSize, uint32_t>> tlsf_free_list::allocate_front(vk::DeviceSize aSize)
+	{
+		assert(aSize > 0);
+		if (!empty() || aSize > mSize) {
+			return {};
+		}
+		// Everything is free and merged => the only free chunk spans the whole range:
+		const auto [fl, sl] = list_index(mSize);
+		const auto c = mFreeHeads[fl][sl];
+		assert(no_chunk != c && 0 == mChunks[c].mOffset && mSize == mChunks[c].mSize);
+		remove_free(c);
+		return take(c, aSize);
+	}
+
+	std::tuple<vk::DeviceSize, uint32_t> tlsf_free_list::take(uint32_t aChunk, vk::DeviceSize aSize)
+	{
+		const auto c = aChunk;
+		// Split off the remainder behind the range:
+		if (mChunks[c].mSize > aSize) {
+			const auto r = new_chunk();
+			const auto next = mChunks[c].mNextPhysical;
+			mChunks[r] = chunk{ mChunks[c].mOffset + aSize, mChunks[c].mSize - aSize, c, next, no_chunk, no_chunk, true };
+			if (no_chunk != next) {
+				mChunks[next].mPrevPhysical = r;
+			}
+			mChunks[c].mNextPhysical = r;
+			mChunks[c].mSize = aSize;
+			insert_free(r);
+		}
+
+		mChunks[c].mIsFree = false;
+		mSizeInUse += mChunks[c].mSize;
+		return std::make_tuple(mChunks[c].mOffset, c);
+	}
+
+	void tlsf_free_list::free(uint32_t aChunk)
+	{
+		assert(aChunk < mChunks.size() && !mChunks[aChunk].mIsFree);
+		auto c = aChunk;
+		mSizeInUse -= mChunks[c].mSize;
+		mChunks[c].mIsFree = true;
+
+		// Merge with the next chunk if it is free:
+		const auto next = mChunks[c].mNextPhysical;
+		if (no_chunk != next && mChunks[next].mIsFree) {
+			remove_free(next);
+			mChunks[c].mSize += mChunks[next].mSize;
+			mChunks[c].mNextPhysical = mChunks[next].mNextPhysical;
+			if (no_chunk != mChunks[c].mNextPhysical) {
+				mChunks[mChunks[c].mNextPhysical].mPrevPhysical = c;
+			}
+			release_chunk(next);
+		}
+
+		// Merge with the previous chunk if it is free:
+		const auto prev = mChunks[c].mPrevPhysical;
+		if (no_chunk != prev && mChunks[prev].mIsFree) {
+			remove_free(prev);
+			mChunks[prev].mSize += mChunks[c].mSize;
+			mChunks[prev].mNextPhysical = mChunks[c].mNextPhysical;
+			if (no_chunk != mChunks[prev].mNextPhysical) {
+				mChunks[mChunks[prev].mNextPhysical].mPrevPhysical = prev;
+			}
+			release_chunk(c);
+			c = prev;
+		}
+
+		insert_free(c);
+	}
+
+	block_allocator::block_allocator(vk::PhysicalDevice aPhysicalDevice, vk::Device aDevice, vk::DeviceSize aPreferredBlockSize)
+		: block_allocator(
+			aPhysicalDevice.getMemoryProperties(),
+			aPhysicalDevice.getProperties().limits.bufferImageGranularity,
+			aPhysicalDevice.getProperties().limits.nonCoherentAtomSize,
+			[aDevice](uint32_t aMemoryTypeIndex, vk::DeviceSize aSize, vk::MemoryAllocateFlags aFlags) {
+				auto allocInfo = vk::MemoryAllocateInfo{}
+					.setAllocationSize(aSize)
+					.setMemoryTypeIndex(aMemoryTypeIndex);
+				auto memoryAllocateFlagsInfo = vk::MemoryAllocateFlagsInfo{}.setFlags(aFlags);
+				if (aFlags) {
+					allocInfo.setPNext(&memoryAllocateFlagsInfo);
+				}
+				return aDevice.allocateMemory(allocInfo);
+			},
+			[aDevice](vk::DeviceMemory aMemory) {
+				aDevice.freeMemory(aMemory);
+			},
+			[aDevice](vk::DeviceMemory aMemory) {
+				return aDevice.mapMemory(aMemory, 0, VK_WHOLE_SIZE);
+			},
+			aPreferredBlockSize
+		)
+	{
+		mPhysicalDevice = aPhysicalDevice;
+		mDevice = aDevice;
+	}
+
+	block_allocator::block_allocator(
+		const vk::PhysicalDeviceMemoryProperties& aMemoryProperties,
+		vk::DeviceSize aBufferImageGranularity,
+		vk::DeviceSize aNonCoherentAtomSize,
+		std::function<vk::DeviceMemory(uint32_t, vk::DeviceSize, vk::MemoryAllocateFlags)> aAllocateMemory,
+		std::function<void(vk::DeviceMemory)> aFreeMemory,
+		std::function<void*(vk::DeviceMemory)> aMapMemory,
+		vk::DeviceSize aPreferredBlockSize
+	)
+		: mMemoryProperties{ aMemoryProperties }
+		, mBufferImageGranularity{ std::max(aBufferImageGranularity, vk::DeviceSize{ 1 }) }
+		, mNonCoherentAtomSize{ std::max(aNonCoherentAtomSize, vk::DeviceSize{ 1 }) }
+		, mAllocateMemory{ std::move(aAllocateMemory) }
+		, mFreeMemory{ std::move(aFreeMemory) }
+		, mMapMemory{ std::move(aMapMemory) }
+		, mBlockLists(static_cast<size_t>(aMemoryProperties.memoryTypeCount) * 4)
+	{
+		for (uint32_t i = 0; i < mMemoryProperties.memoryTypeCount; ++i) {
+			const auto heapSize = mMemoryProperties.memoryHeaps[mMemoryProperties.memoryTypes[i].heapIndex].size;
+			mBlockSizes.push_back(std::max(std::min(aPreferredBlockSize, heapSize / 8), vk::DeviceSize{ 1 }));
+		}
+	}
+
+	block_allocator::~block_allocator()
+	{
+		if (mNumAllocations > 0) {
+			AVK_LOG_WARNING("block_allocator is destroyed while " + std::to_string(mNumAllocations) + " allocations have not been freed.");
+		}
+		for (auto& list : mBlockLists) {
+			for (auto& block : list) {
+				if (block) {
+					mFreeMemory(block->mMemory);
+				}
+			}
+		}
+	}
+
+	uint32_t block_allocator::block_list_index(uint32_t aMemoryTypeIndex, bool aLinearResource, vk::MemoryAllocateFlags aAllocateFlags) const
+	{
+		// Linear and optimal resources only have to be kept apart if the granularity could make them alias each other:
+		const uint32_t linear = aLinearResource && mBufferImageGranularity > 1 ? 1u : 0u;
+		const uint32_t deviceAddress = aAllocateFlags ? 2u : 0u;
+		return aMemoryTypeIndex * 4 + (linear | deviceAddress);
+	}
+
+	std::tuple<uint32_t, vk::MemoryPropertyFlags> block_allocator::find_memory_type_index(uint32_t aMemoryTypeBits, vk::MemoryPropertyFlags aMemoryProperties) const
+	{
+		for (auto i = 0u; i < mMemoryProperties.memoryTypeCount; ++i) {
+			if ((aMemoryTypeBits & (1 << i)) && (mMemoryProperties.memoryTypes[i].propertyFlags & aMemoryProperties) == aMemoryProperties) {
+				return std::make_tuple(i, mMemoryProperties.memoryTypes[i].propertyFlags);
+			}
+		}
+		throw avk::runtime_error("failed to find suitable memory type!");
+	}
+
+	block_allocation block_allocator::allocate(const vk::MemoryRequirements& aRequirements, vk::MemoryPropertyFlags aMemoryProperties, bool aLinearResource, vk::MemoryAllocateFlags aAllocateFlags)
+	{
+		const auto [memoryTypeIndex, memoryPropertyFlags] = find_memory_type_index(aRequirements.memoryTypeBits, aMemoryProperties);
+
+		// Ranges of non-coherent memory are padded to whole atoms, s.t. flushing one of them never touches its neighbors:
+		auto alignment = std::max(aRequirements.alignment, vk::DeviceSize{ 1 });
+		auto size = aRequirements.size;
+		if (has_flag(memoryPropertyFlags, vk::MemoryPropertyFlagBits::eHostVisible) && !has_flag(memoryPropertyFlags, vk::MemoryPropertyFlagBits::eHostCoherent)) {
+			alignment = std::max(alignment, mNonCoherentAtomSize);
+			size = (size + mNonCoherentAtomSize - 1) / mNonCoherentAtomSize * mNonCoherentAtomSize;
+		}
+
+		const auto listIndex = block_list_index(memoryTypeIndex, aLinearResource, aAllocateFlags);
+		const auto isDedicated = size > mBlockSizes[memoryTypeIndex] / 2;
+
+		auto makeAllocation = [&, memoryTypeIndex = memoryTypeIndex, memoryPropertyFlags = memoryPropertyFlags](uint32_t aBlock, vk::DeviceSize aOffset, uint32_t aChunk) {
+			const auto& block = *mBlockLists[listIndex][aBlock];
+			++mNumAllocations;
+			return block_allocation{
+				block.mMemory,
+				aOffset,
+				size,
+				memoryTypeIndex,
+				memoryPropertyFlags,
+				nullptr != block.mMappedMemory ? static_cast<std::byte*>(block.mMappedMemory) + aOffset : nullptr,
+				listIndex,
+				aBlock,
+				aChunk
+			};
+		};
+
+		std::scoped_lock lock{ mMutex };
+		auto& list = mBlockLists[listIndex];
+		if (!isDedicated) {
+			for (size_t i = 0; i < list.size(); ++i) {
+				if (!list[i] || list[i]->mIsDedicated) {
+					continue;
+				}
+				if (auto range = list[i]->mFreeList.allocate(size, alignment); range.has_value()) {
+					return makeAllocation(static_cast<uint32_t>(i), std::get<vk::DeviceSize>(*range), std::get<uint32_t>(*range));
+				}
+			}
+		}
+
+		// No block has enough space => allocate a new one, with smaller sizes if the heap is running out of memory:
+		auto blockSize = isDedicated ? size : mBlockSizes[memoryTypeIndex];
+		vk::DeviceMemory memory;
+		while (!memory) {
+			try {
+				memory = mAllocateMemory(memoryTypeIndex, blockSize, aAllocateFlags);
+			}
+			catch (vk::OutOfDeviceMemoryError&) {
+				if (blockSize / 2 < size) {
+					throw;
+				}
+				blockSize /= 2;
+			}
+		}
+		void* mappedMemory = has_flag(memoryPropertyFlags, vk::MemoryPropertyFlagBits::eHostVisible) ? mMapMemory(memory) : nullptr;
+
+		auto freeSlot = std::find_if(std::begin(list), std::end(list), [](const std::unique_ptr<memory_block>& b) { return !b; });
+		if (std::end(list) == freeSlot) {
+			freeSlot = list.insert(std::end(list), nullptr);
+		}
+		*freeSlot = std::make_unique<memory_block>(memory_block{ memory, mappedMemory, tlsf_free_list{ blockSize }, isDedicated });
+		const auto blockIndex = static_cast<uint32_t>(std::distance(std::begin(list), freeSlot));
+
+		// Offset 0 satisfies every alignment. (allocate() would round the required size up to the next size class, which need
+		// not fit into a block that is just large enough, as it is the case for dedicated blocks and halved block sizes.)
+		auto range = (*freeSlot)->mFreeList.allocate_front(size);
+		assert(range.has_value());
+		return makeAllocation(blockIndex, std::get<vk::DeviceSize>(*range), std::get<uint32_t>(*range));
+	}
+
+	void block_allocator::free(const block_allocation& aAllocation)
+	{
+		std::scoped_lock lock{ mMutex };
+		auto& list = mBlockLists.at(aAllocation.mBlockList);
+		auto& block = list.at(aAllocation.mBlock);
+		assert(block && block->mMemory == aAllocation.mMemory);
+		block->mFreeList.free(aAllocation.mChunk);
+		--mNumAllocations;
+
+		if (!block->mFreeList.empty()) {
+			return;
+		}
+		// Keep one empty block per list around, s.t. allocating and freeing repeatedly does not allocate and free memory every time:
+		const auto anotherEmptyBlock = std::any_of(std::begin(list), std::end(list), [&block](const std::unique_ptr<memory_block>& b) {
+			return b && b != block && !b->mIsDedicated && b->mFreeList.empty();
+		});
+		if (block->mIsDedicated || anotherEmptyBlock) {
+			mFreeMemory(block->mMemory); // Implicitly unmaps it
+			block.reset();
+		}
+	}
+
+	block_allocator_statistics block_allocator::statistics() const
+	{
+		std::scoped_lock lock{ mMutex };
+		block_allocator_statistics result;
+		result.mNumAllocations = mNumAllocations;
+		for (const auto& list : mBlockLists) {
+			for (const auto& block : list) {
+				if (block) {
+					++result.mNumDeviceMemoryAllocations;
+					result.mAllocatedBytes += block->mFreeList.size();
+					result.mUsedBytes += block->mFreeList.size_in_use();
+				}
+			}
+		}
+		return result;
+	}
+#pragma endregion
+
+#pragma region submission_batcher definitions
+	submission_batcher::submission_batcher(const root* aRoot, const queue& aQueue, std::optional<std::chrono::nanoseconds> aBatchingWindow)
+		: mRoot{ aRoot }
+		, mQueue{ &aQueue }
+		, mBatchingWindow{ aBatchingWindow }
+	{
+	}
+
+	submission_batcher::~submission_batcher() noexcept(false)
+	{
+		if (nullptr != mRoot) {
+			flush();
+		}
+	}
+
+	submission_batcher& submission_batcher::add(submission_data aSubmission)
+	{
+		if (!aSubmission.is_sane()) {
+			throw avk::logic_error("Invalid submission_data passed to submission_batcher::add.");
+		}
+		if (aSubmission.mSubmissionCount > 0) {
+			throw avk::logic_error("The submission_data passed to submission_batcher::add has already been submitted.");
+		}
+		if (nullptr != aSubmission.mQueueToSubmitTo && aSubmission.mQueueToSubmitTo != mQueue) {
+			throw avk::logic_error("The submission_data passed to submission_batcher::add is meant for a different queue than the one of the batcher.");
+		}
+
+		if (mSubmissions.empty()) {
+			mBatchStart = std::chrono::steady_clock::now();
+		}
+
+		// Resolve everything right away, while the recorded commands (which auto stages refer to) are still around:
+		auto& range = mRanges.emplace_back();
+		range.mFirstWait = static_cast<uint32_t>(mWaitInfos.size());
+		range.mFirstSignal = static_cast<uint32_t>(mSignalInfos.size());
+		aSubmission.gather_semaphore_submit_infos(mWaitInfos, mSignalInfos);
+		range.mNumWaits = static_cast<uint32_t>(mWaitInfos.size()) - range.mFirstWait;
+		range.mNumSignals = static_cast<uint32_t>(mSignalInfos.size()) - range.mFirstSignal;
+		mCommandBufferInfos.emplace_back(aSubmission.mCommandBufferToSubmit->handle());
+
+		// vkQueueSubmit2 takes only one fence, which is signalled when all of the batch's submissions have completed.
+		// Therefore, a submission with a fence closes the batch. It is flushed immediately, s.t. waiting on the fence can not deadlock.
+		const bool hasFence = aSubmission.mFence.has_value();
+		aSubmission.mDangerousRecordedCommandBufferPointer = nullptr;
+		mSubmissions.push_back(std::move(aSubmission));
+
+		if (hasFence) {
+			flush();
+		}
+		else {
+			flush_if_due();
+		}
+		return *this;
+	}
+
+	bool submission_batcher::flush_if_due()
+	{
+		if (mSubmissions.empty() || !mBatchingWindow.has_value()) {
+			return false;
+		}
+		if (std::chrono::steady_clock::now() - mBatchStart < mBatchingWindow.value()) {
+			return false;
+		}
+		flush();
+		return true;
+	}
+
+	void submission_batcher::flush()
+	{
+		if (mSubmissions.empty()) {
+			return;
+		}
+
+		std::vector<vk::SubmitInfo2KHR> submitInfos;
+		submitInfos.reserve(mRanges.size());
+		for (size_t i = 0; i < mRanges.size(); ++i) {
+			const auto& range = mRanges[i];
+			submitInfos.push_back(vk::SubmitInfo2KHR{}
+				.setWaitSemaphoreInfoCount(range.mNumWaits)
+				.setPWaitSemaphoreInfos(mWaitInfos.data() + range.mFirstWait)
+				.setCommandBufferInfoCount(1u)
+				.setPCommandBufferInfos(&mCommandBufferInfos[i])
+				.setSignalSemaphoreInfoCount(range.mNumSignals)
+				.setPSignalSemaphoreInfos(mSignalInfos.data() + range.mFirstSignal)
+			);
+		}
+
+		// Only the last submission can have a fence (see add):
+		auto fenceHandle = mSubmissions.back().mFence.has_value() ? mSubmissions.back().mFence.value()->handle() : vk::Fence{};
+		submit_to_queue(*mRoot, *mQueue, submitInfos, fenceHandle);
+
+		for (auto& submission : mSubmissions) {
+			++submission.mSubmissionCount;
+		}
+		++mNumFlushes;
+
+		mSubmissions.clear();
+		mRanges.clear();
+		mWaitInfos.clear();
+		mSignalInfos.clear();
+		mCommandBufferInfos.clear();
+	}
+
+#pragma endregion
+
+#pragma region retirement_queue definitions
+	uint32_t retirement_queue::move_front(std::vector<any_owning_resource_t>& aFrom, std::vector<any_owning_resource_t>& aTo, uint32_t aMaxNumResources)
+	{
+		const auto n = std::min(static_cast<uint32_t>(aFrom.size()), aMaxNumResources);
+		std::move(std::begin(aFrom), std::begin(aFrom) + n, std::back_inserter(aTo));
+		aFrom.erase(std::begin(aFrom), std::begin(aFrom) + n);
+		return n;
+	}
+
+	void retirement_queue::retire(any_owning_resource_t aResource, const semaphore_t& aTimelineSemaphore, uint64_t aValue)
+	{
+		assert(aTimelineSemaphore.is_timeline_semaphore());
+		std::scoped_lock lock{ mMutex };
+		auto it = std::find_if(std::begin(mTimelineEntries), std::end(mTimelineEntries), [&aTimelineSemaphore](const timeline_entries& e) {
+			return e.mSemaphore == &aTimelineSemaphore;
+		});
+		if (std::end(mTimelineEntries) == it) {
+			it = mTimelineEntries.insert(it, timeline_entries{ &aTimelineSemaphore, {} });
+		}
+		it->mResourcesPerValue[aValue].push_back(std::move(aResource));
+		++mNumPendingResources;
+	}
+
+	void retirement_queue::retire(any_owning_resource_t aResource, avk::resource_argument<avk::fence_t> aFence)
+	{
+		std::scoped_lock lock{ mMutex };
+		auto it = std::find_if(std::begin(mFenceEntries), std::end(mFenceEntries), [&aFence](const fence_entries& e) {
+			return e.mFence->handle() == aFence->handle();
+		});
+		if (std::end(mFenceEntries) == it) {
+			it = mFenceEntries.insert(it, fence_entries{ std::move(aFence), {} });
+		}
+		it->mResources.push_back(std::move(aResource));
+		++mNumPendingResources;
+	}
+
+	uint32_t retirement_queue::release_completed(std::optional<uint32_t> aMaxNumResources)
+	{
+		// Declared before the lock, s.t. the resources are destroyed after the lock has been released:
+		std::vector<any_owning_resource_t> released;
+		std::scoped_lock lock{ mMutex };
+		auto budget = aMaxNumResources.value_or(std::numeric_limits<uint32_t>::max());
+
+		for (auto& entries : mTimelineEntries) {
+			if (0 == budget || entries.mResourcesPerValue.empty()) {
+				continue;
+			}
+			// One query per semaphore, regardless of the number of values:
+			const auto completedValue = entries.mSemaphore->current_value();
+			auto it = std::begin(entries.mResourcesPerValue);
+			while (it != std::end(entries.mResourcesPerValue) && it->first <= completedValue && budget > 0) {
+				budget -= move_front(it->second, released, budget);
+				it = it->second.empty() ? entries.mResourcesPerValue.erase(it) : std::next(it);
+			}
+		}
+		std::erase_if(mTimelineEntries, [](const timeline_entries& e) { return e.mResourcesPerValue.empty(); });
+
+		for (auto& entries : mFenceEntries) {
+			if (0 == budget) {
+				break;
+			}
+			if (entries.mFence->is_signalled()) {
+				budget -= move_front(entries.mResources, released, budget);
+			}
+		}
+		std::erase_if(mFenceEntries, [](const fence_entries& e) { return e.mResources.empty(); });
+
+		const auto numReleased = static_cast<uint32_t>(released.size());
+		mNumPendingResources -= numReleased;
+		return numReleased;
+	}
+
+	void retirement_queue::release_all()
+	{
+		std::vector<timeline_entries> timelineEntries;
+		std::vector<fence_entries> fenceEntries;
+		std::scoped_lock lock{ mMutex };
+		std::swap(timelineEntries, mTimelineEntries);
+		std::swap(fenceEntries, mFenceEntries);
+		mNumPendingResources = 0;
+	}
+
+	uint32_t retirement_queue::num_pending_resources() const
+	{
+		std::scoped_lock lock{ mMutex };
+		return mNumPendingResources;
+	}
+#pragma endregion
+
+#pragma region command_buffer_recycler definitions
+	command_buffer_recycler::command_buffer_recycler(root* aRoot, uint32_t aNumFrameSlots)
+		: mRoot{ aRoot }
+		, mSignals(aNumFrameSlots)
+	{
+	}
+
+	command_buffer_t& command_buffer_recycler::get_command_buffer(uint32_t aQueueFamilyIndex, uint32_t aFrameSlot, vk::CommandBufferUsageFlags aUsageFlags, vk::CommandBufferLevel aLevel)
+	{
+		if (aFrameSlot >= mSignals.size()) {
+			throw avk::logic_error("Frame slot " + std::to_string(aFrameSlot) + " is out of range for a command_buffer_recycler with " + std::to_string(mSignals.size()) + " frame slots.");
+		}
+
+		pool_entry* entry;
+		{
+			std::scoped_lock lock{ mMutex };
+			auto it = mPools.find(pool_key{ aFrameSlot, aQueueFamilyIndex, std::this_thread::get_id() });
+			if (std::end(mPools) == it) {
+				it = mPools.emplace(pool_key{ aFrameSlot, aQueueFamilyIndex, std::this_thread::get_id() }, pool_entry{
+					mRoot->create_command_pool(aQueueFamilyIndex, vk::CommandPoolCreateFlagBits::eTransient)
+				}).first;
+			}
+			entry = &it->second;
+		}
+		// From here on, only the calling thread accesses the entry:
+
+		const bool isPrimary = vk::CommandBufferLevel::ePrimary == aLevel;
+		auto& commandBuffers = isPrimary ? entry->mPrimaryCommandBuffers : entry->mSecondaryCommandBuffers;
+		auto& numInUse = isPrimary ? entry->mNumPrimaryInUse : entry->mNumSecondaryInUse;
+		if (numInUse < commandBuffers.size()) {
+			mNumRecycledCommandBuffers.fetch_add(1, std::memory_order_relaxed);
+		}
+		else {
+			commandBuffers.push_back(entry->mCommandPool->alloc_command_buffer(aUsageFlags, aLevel));
+			mNumAllocatedCommandBuffers.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		auto& result = commandBuffers[numInUse++].get();
+		result.mBeginInfo.setFlags(aUsageFlags);
+		return result;
+	}
+
+	void command_buffer_recycler::set_completion_signal(uint32_t aFrameSlot, const semaphore_t& aTimelineSemaphore, uint64_t aValue)
+	{
+		assert(aTimelineSemaphore.is_timeline_semaphore());
+		std::scoped_lock lock{ mMutex };
+		mSignals.at(aFrameSlot) = frame_slot_signal{ &aTimelineSemaphore, aValue, nullptr };
+	}
+
+	void command_buffer_recycler::set_completion_signal(uint32_t aFrameSlot, const fence_t& aFence)
+	{
+		std::scoped_lock lock{ mMutex };
+		mSignals.at(aFrameSlot) = frame_slot_signal{ nullptr, 0, &aFence };
+	}
+
+	bool command_buffer_recycler::try_recycle(uint32_t aFrameSlot)
+	{
+		frame_slot_signal signal;
+		{
+			std::scoped_lock lock{ mMutex };
+			signal = mSignals.at(aFrameSlot);
+		}
+		if (nullptr != signal.mTimelineSemaphore && signal.mTimelineSemaphore->current_value() < signal.mValue) {
+			return false;
+		}
+		if (nullptr != signal.mFence && !signal.mFence->is_signalled()) {
+			return false;
+		}
+		reset_frame_slot(aFrameSlot);
+		return true;
+	}
+
+	void command_buffer_recycler::recycle(uint32_t aFrameSlot)
+	{
+		frame_slot_signal signal;
+		{
+			std::scoped_lock lock{ mMutex };
+			signal = mSignals.at(aFrameSlot);
+		}
+		if (nullptr != signal.mTimelineSemaphore) {
+			signal.mTimelineSemaphore->wait_until_signalled(signal.mValue);
+		}
+		if (nullptr != signal.mFence) {
+			signal.mFence->wait_until_signalled();
+		}
+		reset_frame_slot(aFrameSlot);
+	}
+
+	void command_buffer_recycler::reset_frame_slot(uint32_t aFrameSlot)
+	{
+		std::scoped_lock lock{ mMutex };
+		for (auto& [key, entry] : mPools) {
+			if (std::get<0>(key) != aFrameSlot || (0 == entry.mNumPrimaryInUse && 0 == entry.mNumSecondaryInUse)) {
+				continue;
+			}
+			for (size_t i = 0; i < entry.mNumPrimaryInUse; ++i) {
+				entry.mPrimaryCommandBuffers[i]->prepare_for_reuse();
+			}
+			for (size_t i = 0; i < entry.mNumSecondaryInUse; ++i) {
+				entry.mSecondaryCommandBuffers[i]->prepare_for_reuse();
+			}
+			entry.mCommandPool->reset();
+			entry.mNumPrimaryInUse = 0;
+			entry.mNumSecondaryInUse = 0;
+		}
+		mSignals.at(aFrameSlot) = frame_slot_signal{};
+	}
+#pragma endregion
+
+#pragma region fence_pool and semaphore_pool definitions
+	fence_pool::fence_pool(const root* aRoot, uint32_t aNumPreallocated)
+		: mRoot{ aRoot }
+		, mState{ std::make_shared<shared_state>() }
+	{
+		for (uint32_t i = 0; i < aNumPreallocated; ++i) {
+			mState->mAvailable.push_back(mRoot->device().createFenceUnique(vk::FenceCreateInfo{}, nullptr, mRoot->dispatch_loader_core()));
+		}
+	}
+
+	fence fence_pool::acquire()
+	{
+		fence_t result;
+		result.mCreateInfo = vk::FenceCreateInfo{};
+		{
+			std::scoped_lock lock{ mState->mMutex };
+			if (!mState->mAvailable.empty()) {
+				result.mFence = std::move(mState->mAvailable.back());
+				mState->mAvailable.pop_back();
+			}
+		}
+		if (result.mFence) {
+			mState->mNumHits.fetch_add(1, std::memory_order_relaxed);
+		}
+		else {
+			mState->mNumMisses.fetch_add(1, std::memory_order_relaxed);
+			result.mFence = mRoot->device().createFenceUnique(result.mCreateInfo, nullptr, mRoot->dispatch_loader_core());
+		}
+
+		result.mReturnHandleTo = [lWeakState = std::weak_ptr<shared_state>(mState)](vk::UniqueHandle<vk::Fence, DISPATCH_LOADER_CORE_TYPE>&& aHandle) {
+			auto state = lWeakState.lock();
+			if (!state) {
+				return; // The pool is gone => the handle is destroyed as usual
+			}
+			// The fence must not be pending anymore => it can be reset right away:
+			// ReSharper disable once CppExpressionWithoutSideEffects
+			auto resetResult = aHandle.getOwner().resetFences(1u, &aHandle.get(), aHandle.getDispatch());
+			assert(static_cast<VkResult>(resetResult) >= 0);
+			std::scoped_lock lock{ state->mMutex };
+			state->mAvailable.push_back(std::move(aHandle));
+			state->mNumReturned.fetch_add(1, std::memory_order_relaxed);
+		};
+		return result;
+	}
+
+	sync_object_pool_statistics fence_pool::statistics() const
+	{
+		std::scoped_lock lock{ mState->mMutex };
+		return sync_object_pool_statistics{
+			mState->mNumHits.load(std::memory_order_relaxed),
+			mState->mNumMisses.load(std::memory_order_relaxed),
+			mState->mNumReturned.load(std::memory_order_relaxed),
+			static_cast<uint32_t>(mState->mAvailable.size())
+		};
+	}
+
+	semaphore_pool::semaphore_pool(const root* aRoot, uint32_t aNumPreallocated)
+		: mRoot{ aRoot }
+		, mState{ std::make_shared<shared_state>() }
+	{
+		for (uint32_t i = 0; i < aNumPreallocated; ++i) {
+			mState->mAvailable.push_back(mRoot->device().createSemaphoreUnique(vk::SemaphoreCreateInfo{}, nullptr, mRoot->dispatch_loader_core()));
+		}
+	}
+
+	semaphore semaphore_pool::acquire()
+	{
+		semaphore_t result;
+		result.mCreateInfo = vk::SemaphoreCreateInfo{};
+		{
+			std::scoped_lock lock{ mState->mMutex };
+			if (!mState->mAvailable.empty()) {
+				result.mSemaphore = std::move(mState->mAvailable.back());
+				mState->mAvailable.pop_back();
+			}
+		}
+		if (result.mSemaphore) {
+			mState->mNumHits.fetch_add(1, std::memory_order_relaxed);
+		}
+		else {
+			mState->mNumMisses.fetch_add(1, std::memory_order_relaxed);
+			result.mSemaphore = mRoot->device().createSemaphoreUnique(result.mCreateInfo, nullptr, mRoot->dispatch_loader_core());
+		}
+
+		result.mReturnHandleTo = [lWeakState = std::weak_ptr<shared_state>(mState)](vk::UniqueHandle<vk::Semaphore, DISPATCH_LOADER_CORE_TYPE>&& aHandle) {
+			auto state = lWeakState.lock();
+			if (!state) {
+				return; // The pool is gone => the handle is destroyed as usual
+			}
+			std::scoped_lock lock{ state->mMutex };
+			state->mAvailable.push_back(std::move(aHandle));
+			state->mNumReturned.fetch_add(1, std::memory_order_relaxed);
+		};
+		return result;
+	}
+
+	sync_object_pool_statistics semaphore_pool::statistics() const
+	{
+		std::scoped_lock lock{ mState->mMutex };
+		return sync_object_pool_statistics{
+			mState->mNumHits.load(std::memory_order_relaxed),
+			mState->mNumMisses.load(std::memory_order_relaxed),
+			mState->mNumReturned.load(std::memory_order_relaxed),
+			static_cast<uint32_t>(mState->mAvailable.size())
+		};
+	}
+
+	event_pool::event_pool(const root* aRoot, uint32_t aNumPreallocated)
+		: mRoot{ aRoot }
+		, mState{ std::make_shared<shared_state>() }
+	{
+		for (uint32_t i = 0; i < aNumPreallocated; ++i) {
+			mState->mAvailable.push_back(mRoot->device().createEventUnique(vk::EventCreateInfo{}, nullptr, mRoot->dispatch_loader_core()));
+		}
+	}
+
+	event event_pool::acquire()
+	{
+		event_t result;
+		result.mCreateInfo = vk::EventCreateInfo{};
+		{
+			std::scoped_lock lock{ mState->mMutex };
+			if (!mState->mAvailable.empty()) {
+				result.mEvent = std::move(mState->mAvailable.back());
+				mState->mAvailable.pop_back();
+			}
+		}
+		if (result.mEvent) {
+			mState->mNumHits.fetch_add(1, std::memory_order_relaxed);
+		}
+		else {
+			mState->mNumMisses.fetch_add(1, std::memory_order_relaxed);
+			result.mEvent = mRoot->device().createEventUnique(result.mCreateInfo, nullptr, mRoot->dispatch_loader_core());
+		}
+
+		result.mReturnHandleTo = [lWeakState = std::weak_ptr<shared_state>(mState)](vk::UniqueHandle<vk::Event, DISPATCH_LOADER_CORE_TYPE>&& aHandle) {
+			auto state = lWeakState.lock();
+			if (!state) {
+				return; // The pool is gone => the handle is destroyed as usual
+			}
+			// The event must not be used by any pending command buffer anymore => it can be reset right away:
+			aHandle.getOwner().resetEvent(aHandle.get(), aHandle.getDispatch());
+			std::scoped_lock lock{ state->mMutex };
+			state->mAvailable.push_back(std::move(aHandle));
+			state->mNumReturned.fetch_add(1, std::memory_order_relaxed);
+		};
+		return result;
+	}
+
+	sync_object_pool_statistics event_pool::statistics() const
+	{
+		std::scoped_lock lock{ mState->mMutex };
+		return sync_object_pool_statistics{
+			mState->mNumHits.load(std::memory_order_relaxed),
+			mState->mNumMisses.load(std::memory_order_relaxed),
+			mState->mNumReturned.load(std::memory_order_relaxed),
+			static_cast<uint32_t>(mState->mAvailable.size())
+		};
+	}
+#pragma endregion
+
+#pragma region completion_set definitions
+	completion_set::completion_id completion_set::add(const fence_t& aFence)
+	{
+		mPoints.push_back(completion_point{ mNextId++, aFence.handle(), vk::Semaphore{}, 0 });
+		mFences.push_back(aFence.handle());
+		return mPoints.back().mId;
+	}
+
+	completion_set::completion_id completion_set::add(const semaphore_t& aTimelineSemaphore, uint64_t aValue)
+	{
+		assert(aTimelineSemaphore.is_timeline_semaphore());
+		mPoints.push_back(completion_point{ mNextId++, vk::Fence{}, aTimelineSemaphore.handle(), aValue });
+		mSemaphores.push_back(aTimelineSemaphore.handle());
+		mValues.push_back(aValue);
+		return mPoints.back().mId;
+	}
+
+	void completion_set::clear()
+	{
+		mPoints.clear();
+		mFences.clear();
+		mSemaphores.clear();
+		mValues.clear();
+	}
+
+	void completion_set::remove(completion_id aId)
+	{
+		// The points are sorted by their ids:
+		auto it = std::lower_bound(std::begin(mPoints), std::end(mPoints), aId, [](const completion_point& bPoint, completion_id bId) { return bPoint.mId < bId; });
+		assert(std::end(mPoints) != it && it->mId == aId);
+		mPoints.erase(it);
+		rebuild_wait_arrays();
+	}
+
+	std::vector<completion_set::completion_id> completion_set::remove_completed()
+	{
+		auto result = poll();
+		if (result.empty()) {
+			return result;
+		}
+		// Compact the remaining points in one pass, keeping their order:
+		size_t write = 0, nextCompleted = 0;
+		for (size_t read = 0; read < mPoints.size(); ++read) {
+			if (nextCompleted < result.size() && result[nextCompleted] == mPoints[read].mId) {
+				++nextCompleted;
+				continue;
+			}
+			mPoints[write++] = mPoints[read];
+		}
+		mPoints.resize(write);
+		rebuild_wait_arrays();
+		return result;
+	}
+
+	void completion_set::rebuild_wait_arrays()
+	{
+		mFences.clear();
+		mSemaphores.clear();
+		mValues.clear();
+		for (const auto& point : mPoints) {
+			if (point.mFence) {
+				mFences.push_back(point.mFence);
+			}
+			else {
+				mSemaphores.push_back(point.mSemaphore);
+				mValues.push_back(point.mValue);
+			}
+		}
+	}
+
+	bool completion_set::wait_fences(bool aWaitAll, uint64_t aTimeout) const
+	{
+		auto result = mRoot->device().waitForFences(static_cast<uint32_t>(mFences.size()), mFences.data(), aWaitAll ? VK_TRUE : VK_FALSE, aTimeout, mRoot->dispatch_loader_core());
+		assert(static_cast<VkResult>(result) >= 0);
+		return vk::Result::eSuccess == result;
+	}
+
+	bool completion_set::wait_semaphores(bool aWaitAll, uint64_t aTimeout) const
+	{
+		const auto waitInfo = vk::SemaphoreWaitInfo{}
+			.setFlags(aWaitAll ? vk::SemaphoreWaitFlags{} : vk::SemaphoreWaitFlagBits::eAny)
+			.setSemaphoreCount(static_cast<uint32_t>(mSemaphores.size()))
+			.setPSemaphores(mSemaphores.data())
+			.setPValues(mValues.data());
+		auto result = mRoot->device().waitSemaphores(waitInfo, aTimeout, mRoot->dispatch_loader_core());
+		assert(static_cast<VkResult>(result) >= 0);
+		return vk::Result::eSuccess == result;
+	}
+
+	bool completion_set::wait_all(std::optional<uint64_t> aTimeout) const
+	{
+		const auto start = std::chrono::steady_clock::now();
+		if (!mFences.empty() && !wait_fences(true, aTimeout.value_or(UINT64_MAX))) {
+			return false;
+		}
+		if (mSemaphores.empty()) {
+			return true;
+		}
+		// Whatever is left of the timeout:
+		auto remaining = aTimeout.value_or(UINT64_MAX);
+		if (aTimeout.has_value()) {
+			const auto elapsed = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+			remaining = elapsed < remaining ? remaining - elapsed : 0;
+		}
+		return wait_semaphores(true, remaining);
+	}
+
+	bool completion_set::wait_any(std::optional<uint64_t> aTimeout, uint64_t aMixedWaitSliceNs) const
+	{
+		if (mPoints.empty()) {
+			return true;
+		}
+		if (mSemaphores.empty()) {
+			return wait_fences(false, aTimeout.value_or(UINT64_MAX));
+		}
+		if (mFences.empty()) {
+			return wait_semaphores(false, aTimeout.value_or(UINT64_MAX));
+		}
+
+		// Fences and timeline values can not be waited on with one call => alternate between them:
+		const auto start = std::chrono::steady_clock::now();
+		for (;;) {
+			if (wait_fences(false, aMixedWaitSliceNs) || wait_semaphores(false, 0)) {
+				return true;
+			}
+			if (aTimeout.has_value() && static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count()) >= aTimeout.value()) {
+				return false;
+			}
+		}
+	}
+
+	std::vector<completion_set::completion_id> completion_set::poll() const
+	{
+		std::vector<completion_id> result;
+		std::unordered_map<VkSemaphore, uint64_t> currentValues;
+		for (const auto& point : mPoints) {
+			if (point.mFence) {
+				if (vk::Result::eSuccess == mRoot->device().getFenceStatus(point.mFence, mRoot->dispatch_loader_core())) {
+					result.push_back(point.mId);
+				}
+				continue;
+			}
+			auto it = currentValues.find(static_cast<VkSemaphore>(point.mSemaphore));
+			if (std::end(currentValues) == it) {
+				it = currentValues.emplace(static_cast<VkSemaphore>(point.mSemaphore), mRoot->device().getSemaphoreCounterValue(point.mSemaphore, mRoot->dispatch_loader_core())).first;
+			}
+			if (it->second >= point.mValue) {
+				result.push_back(point.mId);
+			}
+		}
+		return result;
+	}
+#pragma endregion
+
+#pragma region cross_queue_scheduler definitions
+	cross_queue_scheduler::cross_queue_scheduler(root* aRoot, const queue& aGraphicsQueue, const queue* aAsyncComputeQueue, const queue* aTransferQueue)
+		: mRoot{ aRoot }
+	{
+		const auto* computeQueue = nullptr != aAsyncComputeQueue ? aAsyncComputeQueue : &aGraphicsQueue;
+		const auto* transferQueue = nullptr != aTransferQueue ? aTransferQueue : computeQueue;
+		const std::array<const queue*, 3> queueOfRole{ &aGraphicsQueue, computeQueue, transferQueue };
+
+		// Roles which share the same queue also share its timeline semaphore:
+		for (size_t r = 0; r < queueOfRole.size(); ++r) {
+			auto it = std::find_if(std::begin(mQueueSlots), std::end(mQueueSlots), [q = queueOfRole[r]](const queue_slot& slot) { return slot.mQueue == q; });
+			if (std::end(mQueueSlots) == it) {
+				mQueueSlots.push_back(queue_slot{
+					queueOfRole[r],
+					root::create_timeline_semaphore(mRoot->device(), mRoot->dispatch_loader_core(), 0),
+					mRoot->create_command_pool(queueOfRole[r]->family_index(), vk::CommandPoolCreateFlagBits::eTransient)
+				});
+				it = std::prev(std::end(mQueueSlots));
+			}
+			mSlotOfRole[r] = static_cast<size_t>(std::distance(std::begin(mQueueSlots), it));
+		}
+	}
+
+	cross_queue_scheduler::~cross_queue_scheduler()
+	{
+		if (!mPendingGroups.empty()) {
+			AVK_LOG_WARNING("cross_queue_scheduler is destroyed with " + std::to_string(mPendingGroups.size()) + " groups of commands which have never been submitted.");
+		}
+		wait_idle();
+	}
+
+	cross_queue_scheduler& cross_queue_scheduler::track(const image_t& aImage, avk::layout::image_layout aCurrentLayout)
+	{
+		tracked_resource state;
+		state.mImage = &aImage;
+		state.mConcurrentSharing = vk::SharingMode::eConcurrent == aImage.create_info().sharingMode;
+		state.mLayout = aCurrentLayout.mLayout;
+		mTrackedImages[static_cast<VkImage>(aImage.handle())] = state;
+		return *this;
+	}
+
+	cross_queue_scheduler& cross_queue_scheduler::track(const buffer_t& aBuffer)
+	{
+		tracked_resource state;
+		state.mBuffer = &aBuffer;
+		state.mConcurrentSharing = vk::SharingMode::eConcurrent == aBuffer.create_info().sharingMode;
+		mTrackedBuffers[static_cast<VkBuffer>(aBuffer.handle())] = state;
+		return *this;
+	}
+
+	cross_queue_scheduler::pending_group& cross_queue_scheduler::add_pending_group(size_t aQueueSlot, std::vector<recorded_commands_t> aCommands)
+	{
+		auto& slot = mQueueSlots[aQueueSlot];
+		return mPendingGroups.emplace_back(pending_group{
+			aQueueSlot,
+			++slot.mLastValue,
+			std::move(aCommands),
+			std::vector<uint64_t>(mQueueSlots.size(), 0),
+			{},
+			{}
+		});
+	}
+
+	scheduled_work cross_queue_scheduler::add(queue_role aRole, std::vector<recorded_commands_t> aCommands, std::vector<scheduled_work> aDependencies)
+	{
+		const auto slot = slot_of(aRole);
+		const auto family = mQueueSlots[slot].mQueue->family_index();
+
+		// Find out which tracked resources the group uses, and which layouts it leaves images in:
+		std::vector<tracked_resource*> usedResources;
+		std::vector<std::tuple<tracked_resource*, vk::ImageLayout>> layoutTransitions;
+		auto markUsed = [&usedResources](tracked_resource* aResource) {
+			if (std::find(std::begin(usedResources), std::end(usedResources), aResource) == std::end(usedResources)) {
+				usedResources.push_back(aResource);
+			}
+		};
+		auto findImage = [this](vk::Image aImage) -> tracked_resource* {
+			auto it = mTrackedImages.find(static_cast<VkImage>(aImage));
+			return std::end(mTrackedImages) == it ? nullptr : &it->second;
+		};
+		auto findBuffer = [this](vk::Buffer aBuffer) -> tracked_resource* {
+			auto it = mTrackedBuffers.find(static_cast<VkBuffer>(aBuffer));
+			return std::end(mTrackedBuffers) == it ? nullptr : &it->second;
+		};
+		std::function<void(const std::vector<recorded_commands_t>&)> gatherUsage = [&](const std::vector<recorded_commands_t>& aList) {
+			for (const auto& recordee : aList) {
+				if (std::holds_alternative<command::action_type_command>(recordee)) {
+					const auto& actionCmd = std::get<command::action_type_command>(recordee);
+					for (const auto& [resource, hint] : actionCmd.mResourceSpecificSyncHints) {
+						auto* tracked = std::holds_alternative<vk::Image>(resource) ? findImage(std::get<vk::Image>(resource)) : findBuffer(std::get<vk::Buffer>(resource));
+						if (nullptr != tracked) {
+							markUsed(tracked);
+						}
+					}
+					gatherUsage(actionCmd.mNestedCommandsAndSyncInstructions);
+				}
+				else if (std::holds_alternative<sync::sync_type_command>(recordee)) {
+					const auto& syncCmd = std::get<sync::sync_type_command>(recordee);
+					if (syncCmd.is_image_memory_barrier()) {
+						const auto data = syncCmd.image_memory_barrier_data();
+						auto* tracked = findImage(data.mImage);
+						if (nullptr != tracked) {
+							markUsed(tracked);
+							if (data.mLayoutTransition.has_value()) {
+								layoutTransitions.emplace_back(tracked, data.mLayoutTransition->mNew.mLayout);
+							}
+						}
+					}
+					else if (syncCmd.is_buffer_memory_barrier()) {
+						auto* tracked = findBuffer(syncCmd.buffer_memory_barrier_data().mBuffer);
+						if (nullptr != tracked) {
+							markUsed(tracked);
+						}
+					}
+				}
+			}
+		};
+		gatherUsage(aCommands);
+
+		std::vector<uint64_t> waitValues(mQueueSlots.size(), 0);
+		for (const auto& dependency : aDependencies) {
+			auto it = std::find_if(std::begin(mQueueSlots), std::end(mQueueSlots), [&dependency](const queue_slot& s) { return s.mQueue == dependency.mQueue; });
+			if (std::end(mQueueSlots) == it) {
+				throw avk::logic_error("A dependency passed to cross_queue_scheduler::add refers to a queue which is not managed by the scheduler.");
+			}
+			auto& value = waitValues[static_cast<size_t>(std::distance(std::begin(mQueueSlots), it))];
+			value = std::max(value, dependency.mTimelineValue);
+		}
+
+		// Resources which have last been used on a different queue:
+		std::vector<sync::sync_type_command> acquireBarriers;
+		std::vector<std::optional<size_t>> releaseGroupOfSlot(mQueueSlots.size());
+		for (auto* resource : usedResources) {
+			if (!resource->mLastQueueSlot.has_value() || resource->mLastQueueSlot.value() == slot) {
+				continue;
+			}
+			const auto prevSlot = resource->mLastQueueSlot.value();
+			const auto prevFamily = mQueueSlots[prevSlot].mQueue->family_index();
+			// The contents of an image in undefined layout need not be preserved => no ownership transfer required:
+			const bool needsOwnershipTransfer = prevFamily != family && !resource->mConcurrentSharing
+				&& (nullptr == resource->mImage || vk::ImageLayout::eUndefined != resource->mLayout);
+
+			if (needsOwnershipTransfer) {
+				const bool previousUseIsPending = resource->mLastPendingGroup.has_value();
+				// If the previous use has already been submitted, the release has to happen in an extra group of commands:
+				if (!previousUseIsPending && !releaseGroupOfSlot[prevSlot].has_value()) {
+					add_pending_group(prevSlot, {});
+					releaseGroupOfSlot[prevSlot] = mPendingGroups.size() - 1;
+				}
+				auto& releasingGroup = mPendingGroups[previousUseIsPending ? resource->mLastPendingGroup.value() : releaseGroupOfSlot[prevSlot].value()];
+				const auto releaseStages = previousUseIsPending ? stage::auto_stage >> stage::none : stage::all_commands >> stage::none;
+				const auto releaseAccesses = previousUseIsPending ? access::auto_access >> access::none : access::memory_write >> access::none;
+
+				if (nullptr != resource->mImage) {
+					const auto keepLayout = layout::image_layout{ resource->mLayout } >> layout::image_layout{ resource->mLayout };
+					releasingGroup.mReleaseBarriers.push_back(sync::image_memory_barrier(*resource->mImage, releaseStages, releaseAccesses)
+						.with_layout_transition(keepLayout)
+						.with_queue_family_ownership_transfer(prevFamily, family));
+					acquireBarriers.push_back(sync::image_memory_barrier(*resource->mImage, stage::none >> stage::auto_stage, access::none >> access::auto_access)
+						.with_layout_transition(keepLayout)
+						.with_queue_family_ownership_transfer(prevFamily, family));
+				}
+				else {
+					releasingGroup.mReleaseBarriers.push_back(sync::buffer_memory_barrier(*resource->mBuffer, releaseStages, releaseAccesses)
+						.with_queue_family_ownership_transfer(prevFamily, family));
+					acquireBarriers.push_back(sync::buffer_memory_barrier(*resource->mBuffer, stage::none >> stage::auto_stage, access::none >> access::auto_access)
+						.with_queue_family_ownership_transfer(prevFamily, family));
+				}
+				resource->mLastTimelineValue = releasingGroup.mTimelineValue;
+			}
+
+			waitValues[prevSlot] = std::max(waitValues[prevSlot], resource->mLastTimelineValue);
+		}
+
+		auto& group = add_pending_group(slot, std::move(aCommands));
+		waitValues[slot] = 0; // <-- Submission order takes care of that
+		group.mWaitValues = std::move(waitValues);
+		group.mAcquireBarriers = std::move(acquireBarriers);
+		const auto groupIndex = mPendingGroups.size() - 1;
+
+		for (auto* resource : usedResources) {
+			resource->mLastQueueSlot = slot;
+			resource->mLastTimelineValue = group.mTimelineValue;
+			resource->mLastPendingGroup = groupIndex;
+		}
+		for (auto& [resource, newLayout] : layoutTransitions) {
+			resource->mLayout = newLayout;
+		}
+
+		return scheduled_work{ mQueueSlots[slot].mQueue, &mQueueSlots[slot].mTimelineSemaphore.get(), group.mTimelineValue };
+	}
+
+	void cross_queue_scheduler::submit()
+	{
+		// Release the command buffers which the GPU is done with:
+		std::vector<uint64_t> completedValues(mQueueSlots.size());
+		for (size_t s = 0; s < mQueueSlots.size(); ++s) {
+			completedValues[s] = mQueueSlots[s].mTimelineSemaphore->current_value();
+		}
+		std::erase_if(mInFlight, [&completedValues](const in_flight_command_buffer& cb) { return cb.mTimelineValue <= completedValues[cb.mQueueSlot]; });
+
+		for (auto& group : mPendingGroups) {
+			auto& slot = mQueueSlots[group.mQueueSlot];
+
+			std::vector<recorded_commands_t> commands;
+			commands.reserve(group.mAcquireBarriers.size() + group.mCommands.size() + group.mReleaseBarriers.size());
+			std::move(std::begin(group.mAcquireBarriers), std::end(group.mAcquireBarriers), std::back_inserter(commands));
+			std::move(std::begin(group.mCommands), std::end(group.mCommands), std::back_inserter(commands));
+			std::move(std::begin(group.mReleaseBarriers), std::end(group.mReleaseBarriers), std::back_inserter(commands));
+
+			auto cmdBfr = slot.mCommandPool->alloc_command_buffer(vk::CommandBufferUsageFlagBits::eOneTimeSubmit);
+			auto submission = mRoot->record(std::move(commands))
+				.into_command_buffer(cmdBfr.get())
+				.then_submit_to(*slot.mQueue);
+			for (size_t s = 0; s < mQueueSlots.size(); ++s) {
+				if (group.mWaitValues[s] > 0) {
+					submission.waiting_for(mQueueSlots[s].mTimelineSemaphore.get(), group.mWaitValues[s], stage::all_commands);
+				}
+			}
+			submission.signaling_upon_completion(slot.mTimelineSemaphore.get(), group.mTimelineValue, stage::all_commands);
+			submission.submit();
+
+			slot.mLastSubmittedValue = group.mTimelineValue;
+			mInFlight.push_back(in_flight_command_buffer{ std::move(cmdBfr), group.mQueueSlot, group.mTimelineValue });
+		}
+		mPendingGroups.clear();
+
+		for (auto& [handle, resource] : mTrackedImages) {
+			resource.mLastPendingGroup.reset();
+		}
+		for (auto& [handle, resource] : mTrackedBuffers) {
+			resource.mLastPendingGroup.reset();
+		}
+	}
+
+	bool cross_queue_scheduler::is_complete(const scheduled_work& aWork) const
+	{
+		return aWork.mTimelineSemaphore->current_value() >= aWork.mTimelineValue;
+	}
+
+	void cross_queue_scheduler::wait_idle() const
+	{
+		for (const auto& slot : mQueueSlots) {
+			if (slot.mLastSubmittedValue > 0) {
+				slot.mTimelineSemaphore->wait_until_signalled(slot.mLastSubmittedValue);
+			}
+		}
+	}
+#pragma endregion
+
+#pragma region completion_reactor and gpu_completion definitions
+	completion_reactor::completion_reactor(const root* aRoot, uint64_t aMaxWaitSliceNs)
+		: mRoot{ aRoot }
+		, mMaxWaitSliceNs{ aMaxWaitSliceNs }
+	{
+		mReactorThread = std::thread([this]() { reactor_loop(); });
+	}
+
+	completion_reactor::~completion_reactor()
+	{
+		{
+			std::scoped_lock lock{ mMutex };
+			mStopRequested = true;
+		}
+		mCondition.notify_one();
+		if (mReactorThread.joinable()) {
+			mReactorThread.join();
+		}
+	}
+
+	void completion_reactor::when_complete(const semaphore_t& aTimelineSemaphore, uint64_t aValue, avk::unique_function<void()> aContinuation)
+	{
+		assert(aTimelineSemaphore.is_timeline_semaphore());
+		{
+			std::scoped_lock lock{ mMutex };
+			mNewWaiters.push_back(waiter{ nullptr, &aTimelineSemaphore, aValue, std::move(aContinuation) });
+		}
+		mCondition.notify_one();
+	}
+
+	void completion_reactor::when_complete(const fence_t& aFence, avk::unique_function<void()> aContinuation)
+	{
+		{
+			std::scoped_lock lock{ mMutex };
+			mNewWaiters.push_back(waiter{ &aFence, nullptr, 0, std::move(aContinuation) });
+		}
+		mCondition.notify_one();
+	}
+
+	void completion_reactor::reactor_loop()
+	{
+		// The active waiters by the ids of their completion points in pending:
+		std::unordered_map<completion_set::completion_id, waiter> active;
+		completion_set pending{ mRoot };
+		for (;;) {
+			{
+				std::unique_lock lock{ mMutex };
+				if (active.empty()) {
+					mCondition.wait(lock, [this]() { return mStopRequested || !mNewWaiters.empty(); });
+					if (mNewWaiters.empty()) {
+						break; // Stop requested and nothing pending anymore
+					}
+				}
+				for (auto& w : mNewWaiters) {
+					const auto id = nullptr != w.mFence ? pending.add(*w.mFence) : pending.add(*w.mSemaphore, w.mValue);
+					active.emplace(id, std::move(w));
+				}
+				mNewWaiters.clear();
+			}
+
+			if (!pending.wait_any(mMaxWaitSliceNs)) {
+				continue;
+			}
+
+			// Take the completed ones out before invoking their continuations, which might register new waiters:
+			std::vector<waiter> completed;
+			for (auto id : pending.remove_completed()) {
+				auto node = active.extract(id);
+				assert(!node.empty());
+				completed.push_back(std::move(node.mapped()));
+			}
+			for (auto& w : completed) {
+				try {
+					w.mContinuation();
+				}
+				catch (const std::exception& e) {
+					AVK_LOG_ERROR(std::string("Exception in a continuation invoked by a completion_reactor: ") + e.what());
+				}
+			}
+		}
+	}
+
+	bool gpu_completion::is_complete() const
+	{
+		if (mFence.has_value()) {
+			return mFence->get_const_reference().is_signalled();
+		}
+		return mTimelineSemaphore->get_const_reference().current_value() >= mTimelineValue;
+	}
+
+	void gpu_completion::handle_post_execution()
+	{
+		if (!mPostExecutionHandled && mCommandBuffer.has_value()) {
+			mCommandBuffer->get_const_reference().invoke_post_execution_handler();
+		}
+		mPostExecutionHandled = true;
+	}
+
+	void gpu_completion::await_suspend(std::coroutine_handle<> aCoroutine)
+	{
+		// This object lives in the coroutine's frame, i.e., it stays valid until the coroutine has been resumed:
+		auto continuation = [this, aCoroutine]() {
+			handle_post_execution();
+			aCoroutine.resume();
+		};
+		if (mFence.has_value()) {
+			mReactor->when_complete(mFence->get_const_reference(), std::move(continuation));
+		}
+		else {
+			mReactor->when_complete(mTimelineSemaphore->get_const_reference(), mTimelineValue, std::move(continuation));
+		}
+	}
+
+	void gpu_completion::await_resume()
+	{
+		handle_post_execution();
+	}
+
+	gpu_completion submission_data::completion(completion_reactor& aReactor)
+	{
+		gpu_completion result{ &aReactor };
+
+		// Prefer a timeline semaphore which is signalled anyways over an additional fence:
+		auto timelineSignal = std::find_if(std::begin(mSemaphoreSignals), std::end(mSemaphoreSignals), [](const semaphore_signal_info& aSignal) {
+			return aSignal.mSignalSemaphore.get_const_reference().is_timeline_semaphore();
+		});
+		const bool useTimelineSemaphore = !mFence.has_value() && std::end(mSemaphoreSignals) != timelineSignal;
+		if (!mFence.has_value() && !useTimelineSemaphore) {
+			if (mSubmissionCount > 0) {
+				throw avk::logic_error("submission_data::completion has been called after the submission has been submitted without a fence or timeline semaphore to signal, i.e., its completion can not be determined anymore.");
+			}
+			mFence = avk::resource_argument<avk::fence_t>{ root::create_fence(mRoot->device(), mRoot->dispatch_loader_core(), false) };
+		}
+
+		if (0 == mSubmissionCount) {
+			submit();
+		}
+
+		// Move everything over instead of copying it, since copying owning resources throws unless they are shared:
+		if (useTimelineSemaphore) {
+			result.mTimelineSemaphore = std::move(timelineSignal->mSignalSemaphore);
+			result.mTimelineValue = timelineSignal->mValue;
+		}
+		else {
+			result.mFence = std::move(mFence.value());
+			mFence.reset();
+		}
+		result.mCommandBuffer = std::move(mCommandBufferToSubmit);
+		return result;
+	}
+#pragma endregion
+
+#pragma region frame_context definitions
+	frame_context::frame_context(root* aRoot, uint32_t aNumFrameSlots, vk::DeviceSize aUploadArenaSize, std::vector<vk::DescriptorPoolSize> aDescriptorPoolSizes, uint32_t aMaxDescriptorSetsPerPool)
+		: mRoot{ aRoot }
+		, mTimelineSemaphore{ root::create_timeline_semaphore(aRoot->device(), aRoot->dispatch_loader_core(), 0) }
+		, mCommandBuffers{ aRoot, aNumFrameSlots }
+		, mSlots(aNumFrameSlots)
+		, mUploadArenaSize{ aUploadArenaSize }
+	{
+		if (0 == aNumFrameSlots) {
+			throw avk::logic_error("A frame_context requires at least one frame slot.");
+		}
+
+		const auto& limits = mRoot->physical_device().getProperties().limits;
+		mMinUploadAlignment = std::max({ limits.minUniformBufferOffsetAlignment, limits.minStorageBufferOffsetAlignment, vk::DeviceSize{ 1 } });
+
+		// Let descriptor_alloc_request sort and merge the sizes, because descriptor_pool::has_capacity_for relies on that:
+		for (const auto& size : aDescriptorPoolSizes) {
+			mDescriptorPoolCapacity.add_size_requirements(size);
+		}
+		mDescriptorPoolCapacity.set_num_sets(aMaxDescriptorSetsPerPool);
+
+		if (mUploadArenaSize > 0) {
+			for (auto& slot : mSlots) {
+				slot.mUploadBlocks.push_back(create_upload_block(mUploadArenaSize));
+			}
+		}
+	}
+
+	frame_context::~frame_context()
+	{
+		if (mFrameValue > 0) {
+			mTimelineSemaphore->wait_until_signalled(mFrameValue);
+		}
+	}
+
+	uint32_t frame_context::begin_frame()
+	{
+		++mFrameValue;
+		auto& slot = current_slot();
+
+		// A single wait covers everything that has been used during the slot's previous frame:
+		if (slot.mFrameValue > 0) {
+			mTimelineSemaphore->wait_until_signalled(slot.mFrameValue);
+		}
+		slot.mFrameValue = mFrameValue;
+
+		mCommandBuffers.recycle(current_frame_slot());
+		slot.mCurrentUploadBlock = 0;
+		slot.mUploadOffset = 0;
+		for (size_t i = 0; i < slot.mNumDescriptorPoolsInUse; ++i) {
+			slot.mDescriptorPools[i].reset();
+		}
+		slot.mNumDescriptorPoolsInUse = 0;
+		slot.mRetiredResources.clear();
+
+		return current_frame_slot();
+	}
+
+	command_buffer_t& frame_context::get_command_buffer(uint32_t aQueueFamilyIndex, vk::CommandBufferLevel aLevel)
+	{
+		assert(mFrameValue > 0);
+		return mCommandBuffers.get_command_buffer(aQueueFamilyIndex, current_frame_slot(), vk::CommandBufferUsageFlagBits::eOneTimeSubmit, aLevel);
+	}
+
+	frame_upload_allocation frame_context::allocate_upload(vk::DeviceSize aSize, vk::DeviceSize aAlignment)
+	{
+		assert(mFrameValue > 0);
+		if (0 == aAlignment) {
+			aAlignment = mMinUploadAlignment;
+		}
+		auto& slot = current_slot();
+
+		// Move on to the next block (and create it if required) until there is a block with enough space left:
+		auto alignedOffset = (slot.mUploadOffset + aAlignment - 1) / aAlignment * aAlignment;
+		while (slot.mCurrentUploadBlock >= slot.mUploadBlocks.size() || alignedOffset + aSize > slot.mUploadBlocks[slot.mCurrentUploadBlock].mBuffer->meta_at_index<buffer_meta>().total_size()) {
+			if (slot.mCurrentUploadBlock < slot.mUploadBlocks.size()) {
+				++slot.mCurrentUploadBlock;
+			}
+			if (slot.mCurrentUploadBlock == slot.mUploadBlocks.size()) {
+				slot.mUploadBlocks.push_back(create_upload_block(std::max(mUploadArenaSize, aSize)));
+			}
+			slot.mUploadOffset = 0;
+			alignedOffset = 0;
+		}
+
+		auto& block = slot.mUploadBlocks[slot.mCurrentUploadBlock];
+		slot.mUploadOffset = alignedOffset + aSize;
+		return frame_upload_allocation{
+			&block.mBuffer.get(),
+			alignedOffset,
+			aSize,
+			static_cast<std::byte*>(block.mMappedMemory) + alignedOffset
+		};
+	}
+
+	frame_upload_allocation frame_context::upload(const void* aData, vk::DeviceSize aSize, vk::DeviceSize aAlignment)
+	{
+		auto result = allocate_upload(aSize, aAlignment);
+		std::memcpy(result.mMappedMemory, aData, static_cast<size_t>(aSize));
+		return result;
+	}
+
+	std::vector<vk::DescriptorSet> frame_context::allocate_descriptor_sets(const std::vector<std::reference_wrapper<const descriptor_set_layout>>& aLayouts)
+	{
+		assert(mFrameValue > 0);
+		auto& slot = current_slot();
+		const auto request = descriptor_alloc_request{ aLayouts };
+
+		// Try the pool which is currently in use, then the ones which have been reset in begin_frame:
+		while (true) {
+			if (slot.mNumDescriptorPoolsInUse > 0 && slot.mDescriptorPools[slot.mNumDescriptorPoolsInUse - 1].has_capacity_for(request)) {
+				return slot.mDescriptorPools[slot.mNumDescriptorPoolsInUse - 1].allocate(aLayouts);
+			}
+			if (slot.mNumDescriptorPoolsInUse == slot.mDescriptorPools.size()) {
+				break;
+			}
+			++slot.mNumDescriptorPoolsInUse;
+		}
+
+		// Every pool of this slot is in use => create a new one, which is large enough for (at least) this request:
+		auto capacity = mDescriptorPoolCapacity;
+		for (const auto& size : request.accumulated_pool_sizes()) {
+			auto it = std::find_if(std::begin(capacity.accumulated_pool_sizes()), std::end(capacity.accumulated_pool_sizes()), [&size](const vk::DescriptorPoolSize& el) {
+				return el.type == size.type;
+			});
+			if (std::end(capacity.accumulated_pool_sizes()) == it || it->descriptorCount < size.descriptorCount) {
+				capacity.add_size_requirements(vk::DescriptorPoolSize{ size.type, size.descriptorCount - (std::end(capacity.accumulated_pool_sizes()) == it ? 0u : it->descriptorCount) });
+			}
+		}
+		capacity.set_num_sets(std::max(capacity.num_sets(), request.num_sets()));
+		slot.mDescriptorPools.push_back(root::create_descriptor_pool(mRoot->device(), mRoot->dispatch_loader_core(), capacity.accumulated_pool_sizes(), static_cast<int>(capacity.num_sets())));
+		slot.mNumDescriptorPoolsInUse = slot.mDescriptorPools.size();
+		return slot.mDescriptorPools.back().allocate(aLayouts);
+	}
+
+	void frame_context::retire(any_owning_resource_t aResource)
+	{
+		assert(mFrameValue > 0);
+		current_slot().mRetiredResources.push_back(std::move(aResource));
+	}
+
+	frame_context::upload_block frame_context::create_upload_block(vk::DeviceSize aSize) const
+	{
+		upload_block result;
+		result.mBuffer = mRoot->create_buffer(
+			memory_usage::host_coherent,
+			vk::BufferUsageFlagBits::eTransferSrc | vk::BufferUsageFlagBits::eVertexBuffer | vk::BufferUsageFlagBits::eIndexBuffer,
+			uniform_buffer_meta::create_from_size(static_cast<size_t>(aSize)),
+			storage_buffer_meta::create_from_size(static_cast<size_t>(aSize)),
+			indirect_buffer_meta::create_from_size(static_cast<size_t>(aSize))
+		);
+		// The mapping refers to the buffer's memory handle => its address must remain stable when the block is moved:
+		result.mBuffer.enable_shared_ownership();
+		result.mMapping.emplace(result.mBuffer->memory_handle(), mapping_access::write);
+		result.mMappedMemory = result.mMapping->get();
+		return result;
+	}
+#pragma endregion
+
+#pragma region staging_ring definitions
+	struct staging_ring::ring_state
+	{
+		void release(uint64_t aRegion);
+
+		// A range of the ring which has been handed out, and whether it has been released already
+		struct region
+		{
+			vk::DeviceSize mOffset;
+			vk::DeviceSize mEnd;
+			bool mReleased;
+		};
+
+		avk::buffer mBuffer;
+		std::optional<scoped_mapping<AVK_MEM_BUFFER_HANDLE>> mMapping;
+		uint8_t* mMappedMemory = nullptr;
+		vk::DeviceSize mSize = 0;
+		bool mIsHostCoherent = true;
+
+		mutable std::mutex mMutex;
+		// All ranges between tail and head, in the order they have been allocated in:
+		std::deque<region> mRegions;
+		// The id of mRegions.front(); ids are assigned consecutively:
+		uint64_t mFrontRegion = 0;
+		vk::DeviceSize mHead = 0;
+	};
+
+	struct staging_ring::region_lease
+	{
+		region_lease(std::shared_ptr<ring_state> aState, uint64_t aRegion) : mState{ std::move(aState) }, mRegion{ aRegion } {}
+		region_lease(const region_lease&) = delete;
+		region_lease(region_lease&&) noexcept = delete;
+		region_lease& operator=(const region_lease&) = delete;
+		region_lease& operator=(region_lease&&) noexcept = delete;
+		~region_lease() { mState->release(mRegion); }
+
+		std::shared_ptr<ring_state> mState;
+		uint64_t mRegion;
+	};
+
+	void staging_ring::ring_state::release(uint64_t aRegion)
+	{
+		std::scoped_lock<std::mutex> guard(mMutex);
+		assert(aRegion >= mFrontRegion && aRegion - mFrontRegion < mRegions.size());
+		mRegions[static_cast<size_t>(aRegion - mFrontRegion)].mReleased = true;
+		// Advance the tail over all released ranges:
+		while (!mRegions.empty() && mRegions.front().mReleased) {
+			mRegions.pop_front();
+			++mFrontRegion;
+		}
+	}
+
+	staging_ring::staging_ring(const root* aRoot, vk::DeviceSize aSize)
+		: mState{ std::make_shared<ring_state>() }
+	{
+		assert(aSize > 0);
+		mState->mBuffer = root::create_buffer(
+			*aRoot,
+			AVK_STAGING_BUFFER_MEMORY_USAGE,
+			vk::BufferUsageFlagBits::eTransferSrc,
+			generic_buffer_meta::create_from_size(static_cast<size_t>(aSize))
+		);
+		// The mapping refers to the buffer's memory handle => its address must remain stable:
+		mState->mBuffer.enable_shared_ownership();
+		mState->mMapping.emplace(mState->mBuffer->memory_handle(), mapping_access::write);
+		mState->mMappedMemory = static_cast<uint8_t*>(mState->mMapping->get());
+		mState->mSize = aSize;
+		mState->mIsHostCoherent = avk::has_flag(mState->mBuffer->memory_properties(), vk::MemoryPropertyFlagBits::eHostCoherent);
+	}
+
+	std::optional<staging_ring_allocation> staging_ring::allocate(vk::DeviceSize aSize, vk::DeviceSize aAlignment)
+	{
+		auto& state = *mState;
+		if (0 == aSize || aSize > state.mSize) {
+			return {};
+		}
+		const auto alignment = std::max(aAlignment, vk::DeviceSize{ 1 });
+
+		std::scoped_lock<std::mutex> guard(state.mMutex);
+		if (state.mRegions.empty()) {
+			// Nothing in use => start over at the beginning, which leaves the largest contiguous range:
+			state.mHead = 0;
+		}
+
+		auto offset = (state.mHead + alignment - 1) / alignment * alignment;
+		if (!state.mRegions.empty()) {
+			const auto tail = state.mRegions.front().mOffset;
+			const bool wrapped = state.mRegions.back().mOffset < tail;
+			if (wrapped) {
+				// Free space is [head, tail):
+				if (offset + aSize > tail) {
+					return {};
+				}
+			}
+			else if (offset + aSize > state.mSize) {
+				// Free space is [head, size) and [0, tail) => wrap around if the range fits before the tail:
+				if (aSize > tail) {
+					return {};
+				}
+				offset = 0;
+			}
+		}
+		else if (offset + aSize > state.mSize) {
+			offset = 0;
 		}
 
-		action_type_command end_render_pass()
-		{
-			return action_type_command{
-				// Define a sync hint that corresponds to the implicit subpass dependencies (see specification chapter 8.1)
-				avk::sync::sync_hint {
-					{{ // What previous commands must synchronize with:
-						vk::PipelineStageFlagBits2KHR::eAllCommands, // eAllGraphics does not include new stages or ext-stages. Therefore, eAllCommands!
-						vk::AccessFlagBits2KHR::eInputAttachmentRead | vk::AccessFlagBits2KHR::eColorAttachmentRead | vk::AccessFlagBits2KHR::eColorAttachmentWrite | vk::AccessFlagBits2KHR::eDepthStencilAttachmentRead | vk::AccessFlagBits2KHR::eDepthStencilAttachmentWrite
-					}},
-					{{ // What subsequent commands must synchronize with:
-						vk::PipelineStageFlagBits2KHR::eAllCommands, // Same comment as above regarding eAllCommands vs. eAllGraphics
-						vk::AccessFlagBits2KHR::eColorAttachmentWrite | vk::AccessFlagBits2KHR::eDepthStencilAttachmentWrite
-					}}
-				},
-				{},
-				[](avk::command_buffer_t& cb) {
-#ifdef AVK_USE_SYNCHRONIZATION2_INSTEAD_OF_CORE
-					cb.handle().endRenderPass2KHR(vk::SubpassEndInfo{}, cb.root_ptr()->dispatch_loader_ext());
-#else
-					cb.handle().endRenderPass2(vk::SubpassEndInfo{}, cb.root_ptr()->dispatch_loader_core());
-#endif
-				}
-			};
+		const auto regionId = state.mFrontRegion + state.mRegions.size();
+		state.mRegions.push_back(ring_state::region{ offset, offset + aSize, false });
+		state.mHead = offset + aSize;
+
+		staging_ring_allocation result;
+		result.mBuffer = state.mBuffer->handle();
+		result.mOffset = offset;
+		result.mSize = aSize;
+		result.mMappedMemory = state.mMappedMemory + offset;
+		result.mLease = std::make_shared<region_lease>(mState, regionId);
+		return result;
+	}
+
+	void staging_ring::flush(const staging_ring_allocation& aAllocation) const
+	{
+		if (!mState->mIsHostCoherent) {
+			mState->mBuffer->memory_handle().flush({ mapped_range{ aAllocation.mOffset, aAllocation.mSize } });
 		}
-		
-		action_type_command render_pass(
-			const renderpass_t& aRenderpass,
-			const framebuffer_t& aFramebuffer,
-			std::vector<recorded_commands_t> aNestedCommands,
-			vk::Offset2D aRenderAreaOffset,
-			std::optional<vk::Extent2D> aRenderAreaExtent,
-			bool aSubpassesInline)
-		{
-			auto tmpBeginRenderPass = begin_render_pass_for_framebuffer(aRenderpass, aFramebuffer, aRenderAreaOffset, aRenderAreaExtent, aSubpassesInline);
-			auto tmpEndRenderPass = end_render_pass();
+	}
 
-			return action_type_command{
-				// Define a sync hint that corresponds to the implicit subpass dependencies (see specification chapter 8.1)
-				avk::sync::sync_hint {
-					tmpBeginRenderPass.mSyncHint.mDstForPreviousCmds,
-					tmpEndRenderPass.mSyncHint.mSrcForSubsequentCmds
-				},
-				std::move(tmpBeginRenderPass.mResourceSpecificSyncHints),
-				std::move(tmpBeginRenderPass.mBeginFun),
-				std::move(aNestedCommands),
-				std::move(tmpEndRenderPass.mBeginFun)
-			};
+	void staging_ring::release_upon_reuse_of(command_buffer_t& aCommandBuffer, staging_ring_allocation aAllocation)
+	{
+		aCommandBuffer.keep_alive_until_reuse(std::move(aAllocation.mLease));
+	}
+
+	vk::DeviceSize staging_ring::size() const
+	{
+		return mState->mSize;
+	}
+
+	vk::DeviceSize staging_ring::size_in_use() const
+	{
+		const auto& state = *mState;
+		std::scoped_lock<std::mutex> guard(state.mMutex);
+		if (state.mRegions.empty()) {
+			return 0;
 		}
+		const auto tail = state.mRegions.front().mOffset;
+		return tail < state.mHead ? state.mHead - tail : state.mSize - tail + state.mHead;
+	}
+#pragma endregion
 
-		action_type_command next_subpass(bool aSubpassesInline)
-		{
-			return action_type_command{
-				{}, {}, // Sync hints not applicable here, I guess
-				[aSubpassesInline](avk::command_buffer_t& cb) {
-#ifdef AVK_USE_SYNCHRONIZATION2_INSTEAD_OF_CORE
-					cb.handle().nextSubpass2KHR(
-						vk::SubpassBeginInfo{ aSubpassesInline ? vk::SubpassContents::eInline : vk::SubpassContents::eSecondaryCommandBuffers },
-						vk::SubpassEndInfo{},
-						cb.root_ptr()->dispatch_loader_ext()
-					);
-#else
-					cb.handle().nextSubpass2(
-						vk::SubpassBeginInfo{ aSubpassesInline ? vk::SubpassContents::eInline : vk::SubpassContents::eSecondaryCommandBuffers },
-						vk::SubpassEndInfo{},
-						cb.root_ptr()->dispatch_loader_core()
-					);
-#endif
-				}
-			};
+#pragma region upload_batcher definitions
+	upload_batcher::upload_batcher(const root* aRoot, vk::DeviceSize aStagingBlockSize)
+		: mRoot{ aRoot }
+		, mStagingBlockSize{ aStagingBlockSize }
+		, mRecycledBlocks{ std::make_shared<recycled_blocks>() }
+	{
+		assert(aStagingBlockSize > 0);
+	}
+
+	upload_batcher::recorded_batch::~recorded_batch()
+	{
+		auto recycled = mReturnBlocksTo.lock();
+		if (!recycled) {
+			return; // The batcher is gone => the staging buffers are destroyed as usual
+		}
+		std::scoped_lock lock{ recycled->mMutex };
+		for (auto& block : mStagingBlocks) {
+			if (block.mBuffer->meta_at_index<buffer_meta>().total_size() == mRecyclableBlockSize) {
+				block.mOffset = 0;
+				recycled->mAvailable.push_back(std::move(block));
+			}
 		}
+	}
 
-		state_type_command bind_pipeline(const graphics_pipeline_t& aPipeline)
-		{
-			return state_type_command{
-				[
-					lPipelineHandle = aPipeline.handle()
-				] (avk::command_buffer_t& cb) {
-					cb.handle().bindPipeline(vk::PipelineBindPoint::eGraphics, lPipelineHandle);
+	std::tuple<size_t, vk::DeviceSize> upload_batcher::stage(const void* aData, vk::DeviceSize aSize, vk::DeviceSize aAlignment)
+	{
+		aAlignment = std::max(aAlignment, vk::DeviceSize{ 4 });
+		auto alignedOffset = mStagingBlocks.empty() ? 0 : (mStagingBlocks.back().mOffset + aAlignment - 1) / aAlignment * aAlignment;
+		if (mStagingBlocks.empty() || alignedOffset + aSize > mStagingBlocks.back().mBuffer->meta_at_index<buffer_meta>().total_size()) {
+			std::optional<staging_block> recycled;
+			if (aSize <= mStagingBlockSize) {
+				std::scoped_lock lock{ mRecycledBlocks->mMutex };
+				if (!mRecycledBlocks->mAvailable.empty()) {
+					recycled = std::move(mRecycledBlocks->mAvailable.back());
+					mRecycledBlocks->mAvailable.pop_back();
 				}
-			};
+			}
+			if (recycled.has_value()) {
+				mStagingBlocks.push_back(std::move(recycled.value()));
+			}
+			else {
+				staging_block block;
+				block.mBuffer = root::create_buffer(
+					*mRoot,
+					AVK_STAGING_BUFFER_MEMORY_USAGE,
+					vk::BufferUsageFlagBits::eTransferSrc,
+					generic_buffer_meta::create_from_size(static_cast<size_t>(std::max(mStagingBlockSize, aSize)))
+				);
+				block.mMappedMemory = static_cast<std::byte*>(block.mBuffer->memory_handle().map_memory(mapping_access::write));
+				mStagingBlocks.push_back(std::move(block));
+			}
+			alignedOffset = 0;
 		}
 
-		state_type_command bind_pipeline(const compute_pipeline_t& aPipeline)
-		{
-			return state_type_command{
-				[
-					lPipelineHandle = aPipeline.handle()
-				] (avk::command_buffer_t& cb) {
-					cb.handle().bindPipeline(vk::PipelineBindPoint::eCompute, lPipelineHandle);
-				}
-			};
+		auto& block = mStagingBlocks.back();
+		memcpy(block.mMappedMemory + alignedOffset, aData, aSize);
+		block.mOffset = alignedOffset + aSize;
+		return std::make_tuple(mStagingBlocks.size() - 1, alignedOffset);
+	}
+
+	upload_batcher& upload_batcher::fill(const buffer_t& aDstBuffer, const void* aData, vk::DeviceSize aSize, vk::DeviceSize aDstOffset)
+	{
+		if (0 == aSize) {
+			return *this;
 		}
+		assert(aDstOffset + aSize <= aDstBuffer.meta_at_index<buffer_meta>().total_size()); // The upload would write beyond the buffer's size.
 
-#if VK_HEADER_VERSION >= 135
-		state_type_command bind_pipeline(const ray_tracing_pipeline_t& aPipeline)
-		{
-			return state_type_command{
-				[
-					lPipelineHandle = aPipeline.handle()
-				] (avk::command_buffer_t& cb) {
-					cb.handle().bindPipeline(vk::PipelineBindPoint::eRayTracingKHR, lPipelineHandle);
-				}
-			};
+		const auto [stagingBlock, stagingOffset] = stage(aData, aSize, 4);
+		const VkBuffer dst = aDstBuffer.handle();
+
+		// Regions of one copy must not overlap, and neither must copies without a barrier in between => start a new phase if they would:
+		auto& writtenRanges = mBufferRangesInPhase[dst];
+		auto next = writtenRanges.upper_bound(aDstOffset);
+		const bool overlapsNext = std::end(writtenRanges) != next && next->first < aDstOffset + aSize;
+		const bool overlapsPrevious = std::begin(writtenRanges) != next && std::prev(next)->second > aDstOffset;
+		if (overlapsNext || overlapsPrevious) {
+			++mPhase;
+			mBufferRangesInPhase.clear();
+			mImageSubresourcesInPhase.clear();
 		}
-#endif
+		mBufferRangesInPhase[dst].emplace(aDstOffset, aDstOffset + aSize);
 
-		state_type_command bind_descriptors(std::tuple<const graphics_pipeline_t*, const vk::PipelineLayout, const std::vector<vk::PushConstantRange>*> aPipelineLayout, std::vector<descriptor_set> aDescriptorSets)
-		{
-			return state_type_command{
-				[
-					lLayoutHandle = std::get<const graphics_pipeline_t*>(aPipelineLayout)->layout_handle(),
-					lDescriptorSets = std::move(aDescriptorSets)
-				] (avk::command_buffer_t& cb) {
-					cb.bind_descriptors(
-						vk::PipelineBindPoint::eGraphics,
-						lLayoutHandle,
-						lDescriptorSets // Attention: Copy! => Potentially expensive?! TODO: What was the reason for bind_descriptors requiring std::vector<descriptor_set> being passed by value?
-					);
-				}
-			};
+		// Add the region to the most recent entry of this buffer, unless that one copies from a different staging block or in an earlier phase:
+		auto it = mBufferCopiesIndex.find(dst);
+		if (std::end(mBufferCopiesIndex) == it || mBufferCopies[it->second].mStagingBlock != stagingBlock || mBufferCopies[it->second].mPhase != mPhase) {
+			mBufferCopies.push_back(buffer_copies{ aDstBuffer.handle(), stagingBlock, mPhase, {} });
+			it = mBufferCopiesIndex.insert_or_assign(dst, mBufferCopies.size() - 1).first;
 		}
+		mBufferCopies[it->second].mRegions.push_back(vk::BufferCopy{ stagingOffset, aDstOffset, aSize });
+		return *this;
+	}
 
-		state_type_command bind_descriptors(std::tuple<const compute_pipeline_t*, const vk::PipelineLayout, const std::vector<vk::PushConstantRange>*> aPipelineLayout, std::vector<descriptor_set> aDescriptorSets)
-		{
-			return state_type_command{
-				[
-					lLayoutHandle = std::get<const compute_pipeline_t*>(aPipelineLayout)->layout_handle(),
-					lDescriptorSets = std::move(aDescriptorSets)
-				] (avk::command_buffer_t& cb) {
-					cb.bind_descriptors(
-						vk::PipelineBindPoint::eCompute,
-						lLayoutHandle,
-						lDescriptorSets // Attention: Copy! => Potentially expensive?! TODO: What was the reason for bind_descriptors requiring std::vector<descriptor_set> being passed by value?
-					);
-				}
-			};
+	upload_batcher& upload_batcher::upload_to_image(const image_t& aDstImage, const void* aData, vk::DeviceSize aSize, avk::layout::image_layout aDstImageLayout, uint32_t aDstLayer, uint32_t aDstLevel, vk::ImageAspectFlags aImageAspectFlags, vk::DeviceSize aAlignment)
+	{
+		if (0 == aSize) {
+			return *this;
 		}
 
-#if VK_HEADER_VERSION >= 135
-		state_type_command bind_descriptors(std::tuple<const ray_tracing_pipeline_t*, const vk::PipelineLayout, const std::vector<vk::PushConstantRange>*> aPipelineLayout, std::vector<descriptor_set> aDescriptorSets)
-		{
-			return state_type_command{
-				[
-					lLayoutHandle = std::get<const ray_tracing_pipeline_t*>(aPipelineLayout)->layout_handle(),
-					lDescriptorSets = std::move(aDescriptorSets)
-				] (avk::command_buffer_t& cb) {
-					cb.bind_descriptors(
-						vk::PipelineBindPoint::eRayTracingKHR,
-						lLayoutHandle,
-						lDescriptorSets // Attention: Copy! => Potentially expensive?! TODO: What was the reason for bind_descriptors requiring std::vector<descriptor_set> being passed by value?
-					);
-				}
-			};
+		auto extent = aDstImage.create_info().extent;
+		extent.width  = std::max(1u, extent.width  >> aDstLevel);
+		extent.height = std::max(1u, extent.height >> aDstLevel);
+		extent.depth  = std::max(1u, extent.depth  >> aDstLevel);
+
+		const auto [stagingBlock, stagingOffset] = stage(aData, aSize, aAlignment);
+		const VkImage dst = aDstImage.handle();
+
+		// Every upload writes a whole subresource => it overlaps an earlier one if they share an aspect, the layer, and the mip level:
+		const auto subresource = vk::ImageSubresourceLayers{ aImageAspectFlags, aDstLevel, aDstLayer, 1u };
+		auto& writtenSubresources = mImageSubresourcesInPhase[dst];
+		if (std::any_of(std::begin(writtenSubresources), std::end(writtenSubresources), [&subresource](const vk::ImageSubresourceLayers& bWritten) {
+				return bWritten.mipLevel == subresource.mipLevel && bWritten.baseArrayLayer == subresource.baseArrayLayer && (bWritten.aspectMask & subresource.aspectMask);
+			})) {
+			++mPhase;
+			mBufferRangesInPhase.clear();
+			mImageSubresourcesInPhase.clear();
 		}
-#endif 
+		mImageSubresourcesInPhase[dst].push_back(subresource);
 
-		action_type_command draw(uint32_t aVertexCount, uint32_t aInstanceCount, uint32_t aFirstVertex, uint32_t aFirstInstance)
-		{
-			return action_type_command{
-				avk::sync::sync_hint {
-					{{ // What previous commands must synchronize with:
-						vk::PipelineStageFlagBits2KHR::eAllGraphics,
-						vk::AccessFlagBits2KHR::eInputAttachmentRead | vk::AccessFlagBits2KHR::eColorAttachmentRead | vk::AccessFlagBits2KHR::eColorAttachmentWrite | vk::AccessFlagBits2KHR::eDepthStencilAttachmentRead | vk::AccessFlagBits2KHR::eDepthStencilAttachmentWrite
-					}},
-					{{ // What subsequent commands must synchronize with:
-						vk::PipelineStageFlagBits2KHR::eAllGraphics,
-						vk::AccessFlagBits2KHR::eColorAttachmentWrite | vk::AccessFlagBits2KHR::eDepthStencilAttachmentWrite
-					}}
-				},
-				{},
-				[aVertexCount, aInstanceCount, aFirstVertex, aFirstInstance](avk::command_buffer_t& cb) {
-					cb.handle().draw(aVertexCount, aInstanceCount, aFirstVertex, aFirstInstance, cb.root_ptr()->dispatch_loader_core());
-				}
-			};
+		// Add the region to the most recent entry of this image, unless that one copies from a different staging block, in a different layout, or in an earlier phase:
+		auto it = mImageCopiesIndex.find(dst);
+		if (std::end(mImageCopiesIndex) == it || mImageCopies[it->second].mStagingBlock != stagingBlock || mImageCopies[it->second].mDstLayout != aDstImageLayout.mLayout || mImageCopies[it->second].mPhase != mPhase) {
+			mImageCopies.push_back(image_copies{ aDstImage.handle(), aDstImageLayout.mLayout, stagingBlock, mPhase, {} });
+			it = mImageCopiesIndex.insert_or_assign(dst, mImageCopies.size() - 1).first;
 		}
+		// Tightly packed, i.e., bufferRowLength and bufferImageHeight are 0:
+		mImageCopies[it->second].mRegions.push_back(vk::BufferImageCopy{
+			stagingOffset, 0u, 0u,
+			subresource,
+			vk::Offset3D{ 0, 0, 0 }, extent
+		});
+		return *this;
+	}
 
-		action_type_command dispatch(uint32_t aGroupCountX, uint32_t aGroupCountY, uint32_t aGroupCountZ)
-		{
-			return action_type_command{
-				avk::sync::sync_hint {
-					{{ // What previous commands must synchronize with:
-						vk::PipelineStageFlagBits2KHR::eComputeShader,
-						vk::AccessFlagBits2KHR::eShaderSampledRead | vk::AccessFlagBits2KHR::eShaderStorageRead | vk::AccessFlagBits2KHR::eShaderStorageWrite
-					}},
-					{{ // What subsequent commands must synchronize with:
-						vk::PipelineStageFlagBits2KHR::eComputeShader,
-						vk::AccessFlagBits2KHR::eShaderStorageWrite
-					}}
-				},
-				{},
-				[aGroupCountX, aGroupCountY, aGroupCountZ](avk::command_buffer_t& cb) {
-					cb.handle().dispatch(aGroupCountX, aGroupCountY, aGroupCountZ, cb.root_ptr()->dispatch_loader_core());
-				}
-			};
+	vk::DeviceSize upload_batcher::staged_size() const
+	{
+		vk::DeviceSize result = 0;
+		for (const auto& block : mStagingBlocks) {
+			result += block.mOffset;
 		}
-		
-		action_type_command draw_mesh_tasks_nv(uint32_t aTaskCount, uint32_t aFirstTask)
-		{
-			return action_type_command{
-				avk::sync::sync_hint {
-					{{ // What previous commands must synchronize with:
-						vk::PipelineStageFlagBits2KHR::eAllGraphics,
-						vk::AccessFlagBits2KHR::eInputAttachmentRead
-					    | vk::AccessFlagBits2KHR::eColorAttachmentRead
-					    | vk::AccessFlagBits2KHR::eColorAttachmentWrite
-					    | vk::AccessFlagBits2KHR::eDepthStencilAttachmentRead
-					    | vk::AccessFlagBits2KHR::eDepthStencilAttachmentWrite
-						| vk::AccessFlagBits2KHR::eShaderStorageRead // Because we must expect to read data from buffers
-					}},
-					{{ // What subsequent commands must synchronize with:
-						vk::PipelineStageFlagBits2KHR::eAllGraphics,
-						vk::AccessFlagBits2KHR::eColorAttachmentWrite | vk::AccessFlagBits2KHR::eDepthStencilAttachmentWrite
-					}}
-				},
-				{},
-				[aTaskCount, aFirstTask](avk::command_buffer_t& cb) {
-					cb.handle().drawMeshTasksNV(aTaskCount, aFirstTask, cb.root_ptr()->dispatch_loader_ext());
-				}
-			};
+		return result;
+	}
+
+	std::vector<recorded_commands_t> upload_batcher::record(avk::stage::pipeline_stage_flags aDstStages, avk::access::memory_access_flags aDstAccesses)
+	{
+		std::vector<recorded_commands_t> result;
+		if (empty()) {
+			return result;
 		}
 
-#if VK_HEADER_VERSION >= 239
-		action_type_command draw_mesh_tasks_ext(uint32_t aGroupCountX, uint32_t aGroupCountY, uint32_t aGroupCountZ)
-		{
-			return action_type_command{
-				avk::sync::sync_hint {
-					{{ // What previous commands must synchronize with:
-						vk::PipelineStageFlagBits2KHR::eAllGraphics,
-						vk::AccessFlagBits2KHR::eInputAttachmentRead
-						| vk::AccessFlagBits2KHR::eColorAttachmentRead
-						| vk::AccessFlagBits2KHR::eColorAttachmentWrite
-						| vk::AccessFlagBits2KHR::eDepthStencilAttachmentRead
-						| vk::AccessFlagBits2KHR::eDepthStencilAttachmentWrite
-						| vk::AccessFlagBits2KHR::eShaderStorageRead // Because we must expect to read data from buffers
-					}},
-					{{ // What subsequent commands must synchronize with:
-						vk::PipelineStageFlagBits2KHR::eAllGraphics,
-						vk::AccessFlagBits2KHR::eColorAttachmentWrite | vk::AccessFlagBits2KHR::eDepthStencilAttachmentWrite
-					}}
-				},
-				{},
-				[aGroupCountX, aGroupCountY, aGroupCountZ](avk::command_buffer_t& cb) {
-					cb.handle().drawMeshTasksEXT(aGroupCountX, aGroupCountY, aGroupCountZ, cb.root_ptr()->dispatch_loader_ext());
+		auto batch = std::make_shared<recorded_batch>();
+		batch->mRecyclableBlockSize = mStagingBlockSize;
+		batch->mReturnBlocksTo = mRecycledBlocks;
+		auto actionTypeCommand = avk::command::action_type_command{};
+
+		for (auto& block : mStagingBlocks) {
+			// The blocks stay mapped; this only makes the written range available if the memory is not host coherent:
+			block.mBuffer->memory_handle().unmap_memory(mapping_access::write, { mapped_range{ 0, block.mOffset } });
+			actionTypeCommand.mResourceSpecificSyncHints.push_back(std::make_tuple(block.mBuffer->handle(), avk::sync::sync_hint{ stage::copy + access::transfer_read, stage::copy + access::none }));
+			batch->mStagingBlocks.push_back(std::move(block));
+		}
+		// Every destination is written by the copies, but is only mentioned once, regardless of its number of regions:
+		for (const auto& [dst, index] : mBufferCopiesIndex) {
+			actionTypeCommand.mResourceSpecificSyncHints.push_back(std::make_tuple(mBufferCopies[index].mDstBuffer, avk::sync::sync_hint{ stage::copy + access::transfer_write, stage::copy + access::transfer_write }));
+		}
+		for (const auto& [dst, index] : mImageCopiesIndex) {
+			actionTypeCommand.mResourceSpecificSyncHints.push_back(std::make_tuple(mImageCopies[index].mDstImage, avk::sync::sync_hint{ stage::copy + access::transfer_write, stage::copy + access::transfer_write }));
+		}
+		actionTypeCommand.infer_sync_hint_from_resource_sync_hints();
+
+		batch->mBufferCopies = std::move(mBufferCopies);
+		batch->mImageCopies = std::move(mImageCopies);
+		mStagingBlocks.clear();
+		mBufferCopies.clear();
+		mImageCopies.clear();
+		mBufferCopiesIndex.clear();
+		mImageCopiesIndex.clear();
+		mBufferRangesInPhase.clear();
+		mImageSubresourcesInPhase.clear();
+		mPhase = 0;
+
+		actionTypeCommand.mBeginFun = [
+			lRoot = mRoot,
+			lBatch = std::move(batch)
+		](avk::command_buffer_t& cb) {
+			// Both lists are sorted by phase => walk through them in lockstep, with a barrier between consecutive phases:
+			auto bufferCopies = std::begin(lBatch->mBufferCopies);
+			auto imageCopies = std::begin(lBatch->mImageCopies);
+			for (uint32_t phase = 0; std::end(lBatch->mBufferCopies) != bufferCopies || std::end(lBatch->mImageCopies) != imageCopies; ++phase) {
+				if (phase > 0) {
+					const auto barrier = vk::MemoryBarrier{ vk::AccessFlagBits::eTransferWrite, vk::AccessFlagBits::eTransferWrite };
+					cb.handle().pipelineBarrier(
+						vk::PipelineStageFlagBits::eTransfer,
+						vk::PipelineStageFlagBits::eTransfer,
+						vk::DependencyFlags{},
+						1u, &barrier,
+						0u, nullptr,
+						0u, nullptr,
+						lRoot->dispatch_loader_core()
+					);
+				}
+				for (; std::end(lBatch->mBufferCopies) != bufferCopies && bufferCopies->mPhase == phase; ++bufferCopies) {
+					cb.handle().copyBuffer(
+						lBatch->mStagingBlocks[bufferCopies->mStagingBlock].mBuffer->handle(), bufferCopies->mDstBuffer,
+						static_cast<uint32_t>(bufferCopies->mRegions.size()), bufferCopies->mRegions.data(),
+						lRoot->dispatch_loader_core()
+					);
 				}
-			};
-		}
-#endif
+				for (; std::end(lBatch->mImageCopies) != imageCopies && imageCopies->mPhase == phase; ++imageCopies) {
+					cb.handle().copyBufferToImage(
+						lBatch->mStagingBlocks[imageCopies->mStagingBlock].mBuffer->handle(), imageCopies->mDstImage, imageCopies->mDstLayout,
+						static_cast<uint32_t>(imageCopies->mRegions.size()), imageCopies->mRegions.data(),
+						lRoot->dispatch_loader_core()
+					);
+				}
+			}
 
+			// The staging blocks might still be in use when this method returns => keep them alive until the command buffer is
+			// reused or destroyed, after which they return to the batcher (once this function has been destroyed as well):
+			cb.keep_alive_until_reuse(lBatch);
+		};
 
-#if VK_HEADER_VERSION >= 135
-		action_type_command trace_rays(
-			vk::Extent3D aRaygenDimensions,
-			const shader_binding_table_ref& aShaderBindingTableRef,
-#if VK_HEADER_VERSION >= 162
-			const vk::StridedDeviceAddressRegionKHR& aRaygenSbtRef,
-			const vk::StridedDeviceAddressRegionKHR& aRaymissSbtRef,
-			const vk::StridedDeviceAddressRegionKHR& aRayhitSbtRef,
-			const vk::StridedDeviceAddressRegionKHR& aCallableSbtRef
+		result.push_back(std::move(actionTypeCommand));
+		result.push_back(sync::global_memory_barrier(stage::copy >> aDstStages, access::transfer_write >> aDstAccesses));
+		return result;
+	}
+#pragma endregion
 
-#else
-			const vk::StridedBufferRegionKHR& aRaygenSbtRef,
-			const vk::StridedBufferRegionKHR& aRaymissSbtRef,
-			const vk::StridedBufferRegionKHR& aRayhitSbtRef,
-			const vk::StridedBufferRegionKHR& aCallableSbtRef
-#endif
-		)
-		{
-			return action_type_command{
-				avk::sync::sync_hint {
-					stage::ray_tracing_shader + access::acceleration_structure_read,
-					stage::ray_tracing_shader + access::none
-				},
-				{}, // no resource-specific sync hints
-				[
-					lSbtHandle = aShaderBindingTableRef.mSbtBufferHandle,
-					lEntrySize = aShaderBindingTableRef.mSbtEntrySize,
-					lRaygenSbtRef = aRaygenSbtRef,
-					lRaymissSbtRef = aRaymissSbtRef,
-					lRayhitSbtRef = aRayhitSbtRef,
-					lCallableSbtRef = aCallableSbtRef,
-					aRaygenDimensions
-				](avk::command_buffer_t& cb) {
-					cb.handle().traceRaysKHR(
-						&lRaygenSbtRef, &lRaymissSbtRef, &lRayhitSbtRef, &lCallableSbtRef,
-						aRaygenDimensions.width, aRaygenDimensions.height, aRaygenDimensions.depth,
-						cb.root_ptr()->dispatch_loader_ext()
-					);
-				}
-			};
-		}
-#endif
+#pragma region submission_service definitions
+	submission_service::submission_service(const root* aRoot, const queue& aQueue, uint64_t aIdlePollIntervalNs)
+		: mRoot{ aRoot }
+		, mQueue{ &aQueue }
+		, mIdlePollIntervalNs{ aIdlePollIntervalNs }
+		, mTimelineSemaphore{ root::create_timeline_semaphore(aRoot->device(), aRoot->dispatch_loader_core(), 0) }
+	{
+		mSubmitThread = std::thread([this]() { submit_thread_loop(); });
 	}
 
-	submission_data::submission_data(submission_data&& aOther) noexcept
-		: mRoot{ std::move(aOther.mRoot) }
-		, mCommandBufferToSubmit{ std::move(aOther.mCommandBufferToSubmit) }
-		, mQueueToSubmitTo{ std::move(aOther.mQueueToSubmitTo) }
-		, mSemaphoreWaits{ std::move(aOther.mSemaphoreWaits) }
-		, mSemaphoreSignals{ std::move(aOther.mSemaphoreSignals) }
-		, mFence{ std::move(aOther.mFence) }
-		, mSubmissionCount{ std::move(aOther.mSubmissionCount) }
+	submission_service::~submission_service()
 	{
-		aOther.mRoot = nullptr;
-		aOther.mQueueToSubmitTo = nullptr;
-		aOther.mSemaphoreWaits.clear();
-		aOther.mSemaphoreSignals.clear();
-		aOther.mFence.reset();
-		aOther.mSubmissionCount = 0u;
+		mStopRequested.store(true, std::memory_order_release);
+		mWakeUpCounter.fetch_add(1, std::memory_order_release);
+		mWakeUpCounter.notify_one();
+		if (mSubmitThread.joinable()) {
+			mSubmitThread.join();
+		}
 	}
 
-	submission_data& submission_data::operator=(submission_data&& aOther) noexcept
+	submission_token submission_service::enqueue(submission_data aSubmission)
 	{
-		mRoot = std::move(aOther.mRoot);
-		mCommandBufferToSubmit = std::move(aOther.mCommandBufferToSubmit);
-		mQueueToSubmitTo = std::move(aOther.mQueueToSubmitTo);
-		mSemaphoreWaits = std::move(aOther.mSemaphoreWaits);
-		mSemaphoreSignals = std::move(aOther.mSemaphoreSignals);
-		mFence = std::move(aOther.mFence);
-		mSubmissionCount = std::move(aOther.mSubmissionCount);
+		if (!aSubmission.is_sane() || aSubmission.mSubmissionCount > 0) {
+			throw avk::logic_error("Invalid or already submitted submission_data passed to submission_service::enqueue.");
+		}
+		if (nullptr != aSubmission.mQueueToSubmitTo && aSubmission.mQueueToSubmitTo != mQueue) {
+			throw avk::logic_error("The submission_data passed to submission_service::enqueue is meant for a different queue than the one of the service.");
+		}
 
-		aOther.mRoot = nullptr;
-		aOther.mQueueToSubmitTo = nullptr;
-		aOther.mSemaphoreWaits.clear();
-		aOther.mSemaphoreSignals.clear();
-		aOther.mFence.reset();
-		aOther.mSubmissionCount = 0u;
+		auto pending = std::make_unique<pending_submission>(pending_submission{ std::move(aSubmission) });
+		pending->mSubmission.gather_semaphore_submit_infos(pending->mWaitInfos, pending->mSignalInfos);
+		pending->mSubmission.mDangerousRecordedCommandBufferPointer = nullptr;
+		pending->mCommandBufferInfo = vk::CommandBufferSubmitInfoKHR{}.setCommandBuffer(pending->mSubmission.mCommandBufferToSubmit->handle());
 
-		return *this;
-	}
+		// Values might be pushed out of order by concurrent callers; the submit thread restores the order:
+		pending->mTimelineValue = mLastTimelineValue.fetch_add(1, std::memory_order_relaxed) + 1;
+		pending->mSignalInfos.emplace_back(mTimelineSemaphore->handle(), pending->mTimelineValue, vk::PipelineStageFlagBits2KHR::eAllCommands);
+		const submission_token token{ pending->mTimelineValue };
 
-	submission_data::~submission_data() noexcept(false)
-	{
-		if (is_sane() && 0 == mSubmissionCount) { // TODO: PROBLEM HERE due to auto submission = .... in imgui_manager.cpp#L337
-			submit();
+		auto* node = pending.release();
+		node->mNext = mEnqueued.load(std::memory_order_relaxed);
+		while (!mEnqueued.compare_exchange_weak(node->mNext, node, std::memory_order_release, std::memory_order_relaxed)) {
 		}
+		mWakeUpCounter.fetch_add(1, std::memory_order_release);
+		mWakeUpCounter.notify_one();
+
+		return token;
 	}
 
-	submission_data& submission_data::submit_to(const queue& aQueue)
+	submission_token submission_service::enqueue(recorded_command_buffer& aRecordedCommandBuffer)
 	{
-		mQueueToSubmitTo = &aQueue;
-		return *this;
+		return enqueue(aRecordedCommandBuffer.then_submit_to(*mQueue));
 	}
 
-	submission_data& submission_data::waiting_for(avk::semaphore_wait_info aWaitInfo)
+	bool submission_service::is_complete(submission_token aToken) const
 	{
-		mSemaphoreWaits.push_back(std::move(aWaitInfo));
-		return *this;
+		return mTimelineSemaphore->current_value() >= aToken.mTimelineValue;
 	}
 
-	submission_data& submission_data::signaling_upon_completion(semaphore_signal_info aSignalInfo)
+	bool submission_service::wait_until_complete(submission_token aToken, std::optional<uint64_t> aTimeout) const
 	{
-		mSemaphoreSignals.push_back(std::move(aSignalInfo));
-		return *this;
+		return mTimelineSemaphore->wait_until_signalled(aToken.mTimelineValue, aTimeout);
 	}
 
-	submission_data& submission_data::signaling_upon_completion(avk::resource_argument<avk::fence_t> aFence)
+	void submission_service::wait_idle() const
 	{
-		mFence = std::move(aFence);
-		return *this;
+		mTimelineSemaphore->wait_until_signalled(mLastTimelineValue.load(std::memory_order_relaxed));
 	}
 
-	submission_data&& submission_data::store_for_now() noexcept
+	void submission_service::submit_in_order(std::vector<std::unique_ptr<pending_submission>>& aReadySubmissions)
 	{
-		return std::move(*this);
+		std::vector<vk::SubmitInfo2KHR> submitInfos;
+		submitInfos.reserve(aReadySubmissions.size());
+		for (size_t i = 0; i < aReadySubmissions.size(); ++i) {
+			auto& pending = *aReadySubmissions[i];
+			submitInfos.push_back(vk::SubmitInfo2KHR{}
+				.setWaitSemaphoreInfoCount(static_cast<uint32_t>(pending.mWaitInfos.size()))
+				.setPWaitSemaphoreInfos(pending.mWaitInfos.data())
+				.setCommandBufferInfoCount(1u)
+				.setPCommandBufferInfos(&pending.mCommandBufferInfo)
+				.setSignalSemaphoreInfoCount(static_cast<uint32_t>(pending.mSignalInfos.size()))
+				.setPSignalSemaphoreInfos(pending.mSignalInfos.data())
+			);
+
+			// vkQueueSubmit2 takes only one fence => a submission with a fence ends one call:
+			const bool hasFence = pending.mSubmission.mFence.has_value();
+			if (hasFence || aReadySubmissions.size() - 1 == i) {
+				const auto fenceHandle = hasFence ? pending.mSubmission.mFence.value()->handle() : vk::Fence{};
+				{
+					std::scoped_lock lock{ mQueueMutex };
+					submit_to_queue(*mRoot, *mQueue, submitInfos, fenceHandle);
+				}
+				mNumSubmitCalls.fetch_add(1, std::memory_order_relaxed);
+				submitInfos.clear();
+			}
+			++pending.mSubmission.mSubmissionCount;
+		}
 	}
 
-	void submission_data::submit()
+	void submission_service::submit_thread_loop()
 	{
-		// Gather config for wait semaphores:
-		std::vector<vk::SemaphoreSubmitInfoKHR> waitSem;
-		for (auto& semWait : mSemaphoreWaits) {
-			auto& subInfo = waitSem.emplace_back(semWait.mWaitSemaphore->handle()); // TODO: What about timeline semaphores? (see 'value' param!)
-			std::visit(lambda_overload{
-				[&subInfo](const std::monostate&) {
-					subInfo.setStageMask(vk::PipelineStageFlagBits2KHR::eNone);
-				},
-				[&subInfo](const vk::PipelineStageFlags2KHR& aFixedStage) {
-					subInfo.setStageMask(aFixedStage);
-				},
-				[&subInfo, this](const avk::stage::auto_stage_t& aAutoStage) {
-					// Set something:
-					subInfo.setStageMask(vk::PipelineStageFlagBits2KHR::eAllCommands);
-					// But now try to find a tighter auto-stage:
-					auto* prevPtr = recorded_command_buffer_ptr();
-					if (nullptr != prevPtr) {
-						auto* prevPrevPtr = prevPtr->recorded_commands_ptr();
-						if (nullptr != prevPrevPtr) {
-							subInfo.setStageMask(accumulate_sync_details<vk::PipelineStageFlags2KHR>(
-								prevPrevPtr->recorded_commands_and_sync_instructions(),
-								/* Start index: within std::vector<recorded_commands_t>: */ 0,
-								/* How many steps to accumulate: */ static_cast<uint32_t>(aAutoStage),
-								/* after-wards: */  1,
-								/* If we can't determine something specific, employ a heavy access mask to ensure correctness: */ vk::PipelineStageFlagBits2KHR::eAllCommands,
-								{} // <-- For the semaphore signal, we do not want to restrict looking for specific images or buffers; everything is relevant
-							));
-						}
+		// Submissions which have been taken from mEnqueued, but whose predecessors (in terms of timeline values) have not:
+		std::map<uint64_t, std::unique_ptr<pending_submission>> outOfOrder;
+		// Submissions which have been submitted, but might not have completed yet:
+		std::deque<std::unique_ptr<pending_submission>> inFlight;
+		uint64_t nextTimelineValue = 1;
+
+		for (;;) {
+			const auto wakeUps = mWakeUpCounter.load(std::memory_order_acquire);
+			const auto stopRequested = mStopRequested.load(std::memory_order_acquire);
+
+			auto* node = mEnqueued.exchange(nullptr, std::memory_order_acquire);
+			while (nullptr != node) {
+				auto* next = node->mNext;
+				outOfOrder.emplace(node->mTimelineValue, std::unique_ptr<pending_submission>(node));
+				node = next;
+			}
+
+			std::vector<std::unique_ptr<pending_submission>> ready;
+			while (!outOfOrder.empty() && outOfOrder.begin()->first == nextTimelineValue) {
+				ready.push_back(std::move(outOfOrder.begin()->second));
+				outOfOrder.erase(outOfOrder.begin());
+				++nextTimelineValue;
+			}
+
+			try {
+				if (!ready.empty()) {
+					submit_in_order(ready);
+					for (auto& pending : ready) {
+						inFlight.push_back(std::move(pending));
 					}
 				}
-			}, semWait.mDstStage.mFlags);
-		}
 
-		// Gather config for signal semaphores:
-		std::vector<vk::SemaphoreSubmitInfoKHR> signalSem;
-		for (auto& semSig : mSemaphoreSignals) {
-			auto& subInfo = signalSem.emplace_back(semSig.mSignalSemaphore->handle()); // TODO: What about timeline semaphores? (see 'value' param!)
-			std::visit(lambda_overload{
-				[&subInfo](const std::monostate&) {
-					subInfo.setStageMask(vk::PipelineStageFlagBits2KHR::eNone);
-				},
-				[&subInfo](const vk::PipelineStageFlags2KHR& lFixedStage) {
-					subInfo.setStageMask(lFixedStage);
-				},
-				[&subInfo, this](const avk::stage::auto_stage_t& lAutoStage) {
-					// Set something:
-					subInfo.setStageMask(vk::PipelineStageFlagBits2KHR::eAllCommands);
-					// But now try to find a tighter auto-stage:
-					auto* prevPtr = recorded_command_buffer_ptr();
-					if (nullptr != prevPtr) {
-						auto* prevPrevPtr = prevPtr->recorded_commands_ptr();
-						if (nullptr != prevPrevPtr) {
-							subInfo.setStageMask(accumulate_sync_details<vk::PipelineStageFlags2KHR>(
-								prevPrevPtr->recorded_commands_and_sync_instructions(),
-								/* Start index: within std::vector<recorded_commands_t>: */ static_cast<int>(prevPrevPtr->recorded_commands_and_sync_instructions().size()) - 1,
-								/* How many steps to accumulate: */ static_cast<uint32_t>(lAutoStage),
-								/* before-wards: */  -1,
-								/* If we can't determine something specific, employ a heavy access mask to ensure correctness: */ vk::PipelineStageFlagBits2KHR::eAllCommands,
-								{} // <-- For the semaphore signal, we do not want to restrict looking for specific images or buffers; everything is relevant
-							));
-						}
+				// Release whatever the GPU is done with:
+				if (!inFlight.empty()) {
+					const auto completedValue = mTimelineSemaphore->current_value();
+					while (!inFlight.empty() && inFlight.front()->mTimelineValue <= completedValue) {
+						inFlight.pop_front();
 					}
 				}
-				}, semSig.mSrcStage.mFlags);
+			}
+			catch (const std::exception& e) {
+				AVK_LOG_ERROR(std::string("Exception in the submit thread of a submission_service: ") + e.what());
+			}
+
+			if (stopRequested && outOfOrder.empty()) {
+				break;
+			}
+			if (!ready.empty()) {
+				continue;
+			}
+			if (inFlight.empty()) {
+				mWakeUpCounter.wait(wakeUps, std::memory_order_acquire);
+				continue;
+			}
+			// Nothing to submit, but something to release => wait for the oldest in-flight submission (for a bounded time,
+			// s.t. new work is not delayed for long), instead of holding on to its resources until the next enqueue:
+			if (wakeUps == mWakeUpCounter.load(std::memory_order_acquire)) {
+				try {
+					mTimelineSemaphore->wait_until_signalled(inFlight.front()->mTimelineValue, mIdlePollIntervalNs);
+				}
+				catch (const std::exception& e) {
+					AVK_LOG_ERROR(std::string("Exception in the submit thread of a submission_service: ") + e.what());
+					mWakeUpCounter.wait(wakeUps, std::memory_order_acquire); // Do not spin on a failing wait
+				}
+			}
 		}
 
-		auto cmdBfrSubmitInfo = vk::CommandBufferSubmitInfoKHR{}
-		.setCommandBuffer(mCommandBufferToSubmit->handle());
+		if (!inFlight.empty()) {
+			mTimelineSemaphore->wait_until_signalled(inFlight.back()->mTimelineValue);
+		}
+	}
+#pragma endregion
 
-		auto submitInfo = vk::SubmitInfo2KHR{}
-			.setWaitSemaphoreInfoCount(static_cast<uint32_t>(waitSem.size()))
-			.setPWaitSemaphoreInfos(waitSem.data())
-			.setCommandBufferInfoCount(1u)
-			.setPCommandBufferInfos(&cmdBfrSubmitInfo)
-			.setSignalSemaphoreInfoCount(static_cast<uint32_t>(signalSem.size()))
-			.setPSignalSemaphoreInfos(signalSem.data());
+#pragma region worker_pool definitions
+	worker_pool::worker_pool(uint32_t aNumThreads)
+	{
+		mThreads.reserve(aNumThreads);
+		for (uint32_t i = 0; i < aNumThreads; ++i) {
+			mThreads.emplace_back([this]() { worker_loop(); });
+		}
+	}
 
-		auto fenceHandle = mFence.has_value() ? mFence.value()->handle() : vk::Fence{};
-#ifdef AVK_USE_SYNCHRONIZATION2_INSTEAD_OF_CORE
-		auto errorCode = mQueueToSubmitTo->handle().submit2KHR(1u, &submitInfo, fenceHandle, mRoot->dispatch_loader_ext());
-		if (vk::Result::eSuccess != errorCode) {
-			AVK_LOG_WARNING("submit2KHR returned " + vk::to_string(errorCode));
-	    }
-#else
-		auto errorCode = mQueueToSubmitTo->handle().submit2(1u, &submitInfo, fenceHandle, mRoot->dispatch_loader_core());
-		if (vk::Result::eSuccess != errorCode) {
-			AVK_LOG_WARNING("submit2 returned " + vk::to_string(errorCode));
+	worker_pool::~worker_pool()
+	{
+		{
+			std::scoped_lock lock{ mMutex };
+			mStopRequested = true;
 		}
-#endif
+		mCondition.notify_all();
+		for (auto& t : mThreads) {
+			if (t.joinable()) {
+				t.join();
+			}
+		}
+	}
 
-		++mSubmissionCount;
+	void worker_pool::worker_loop()
+	{
+		while (true) {
+			avk::unique_function<void()> job;
+			{
+				std::unique_lock lock{ mMutex };
+				mCondition.wait(lock, [this]() { return mStopRequested || !mJobs.empty(); });
+				if (mJobs.empty()) {
+					return; // => stop requested and nothing left to do
+				}
+				job = std::move(mJobs.front());
+				mJobs.pop_front();
+			}
+			job();
+		}
+	}
+
+	void worker_pool::run(uint32_t aNumJobs, const std::function<void(uint32_t)>& aJob)
+	{
+		if (0u == aNumJobs) {
+			return;
+		}
+
+		// Shared among all jobs of this batch; lives on this stack frame until all of them have finished:
+		struct batch_state
+		{
+			std::mutex mMutex;
+			std::condition_variable mCondition;
+			uint32_t mNumRemaining;
+			std::vector<std::exception_ptr> mErrors;
+		} batch{ {}, {}, aNumJobs, std::vector<std::exception_ptr>(aNumJobs) };
+
+		auto execute = [&batch, &aJob](uint32_t aJobIndex) {
+			try {
+				aJob(aJobIndex);
+			}
+			catch (...) {
+				batch.mErrors[aJobIndex] = std::current_exception();
+			}
+			// Notify while holding the lock, s.t. run cannot return (and destroy batch) before notify_all has returned:
+			std::scoped_lock lock{ batch.mMutex };
+			if (0u == --batch.mNumRemaining) {
+				batch.mCondition.notify_all();
+			}
+		};
+
+		if (aNumJobs > 1u) {
+			{
+				std::scoped_lock lock{ mMutex };
+				for (uint32_t j = 1u; j < aNumJobs; ++j) {
+					mJobs.emplace_back([&execute, j]() { execute(j); });
+				}
+			}
+			mCondition.notify_all();
+		}
+		execute(0u);
+
+		// Help with pending jobs instead of idling (which is also what makes run work without any threads and from within a job):
+		while (true) {
+			avk::unique_function<void()> job;
+			{
+				std::scoped_lock lock{ mMutex };
+				if (!mJobs.empty()) {
+					job = std::move(mJobs.front());
+					mJobs.pop_front();
+				}
+			}
+			if (job) {
+				job();
+				continue;
+			}
+			// All jobs of this batch have been taken => wait for the ones which are still being executed by other threads:
+			std::unique_lock lock{ batch.mMutex };
+			batch.mCondition.wait(lock, [&batch]() { return 0u == batch.mNumRemaining; });
+			break;
+		}
+
+		for (auto& e : batch.mErrors) {
+			if (e) {
+				std::rethrow_exception(e);
+			}
+		}
 	}
 
+	worker_pool& worker_pool::shared()
+	{
+		static worker_pool sSharedPool{ std::max(std::thread::hardware_concurrency(), 1u) - 1u };
+		return sSharedPool;
+	}
 #pragma endregion
-	
+
 	avk::recorded_commands root::record(std::vector<recorded_commands_t> aRecordedCommands) const
 	{
 		return avk::recorded_commands{ this, std::move(aRecordedCommands) };
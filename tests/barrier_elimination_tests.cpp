@@ -0,0 +1,129 @@
+// Exercises the resolution of auto barriers via avk::sync::resource_state_tracker and the elimination of redundant
+// barriers via avk::recorded_commands::eliminate_redundant_barriers. Nothing is recorded into a command buffer, hence,
+// no Vulkan device is required.
+#include "avk/avk.hpp"
+#include <iostream>
+
+namespace
+{
+	int gNumFailures = 0;
+
+#define AVK_TEST_CHECK(condition) \
+	do { \
+		if (!(condition)) { \
+			std::cerr << __FILE__ << ":" << __LINE__ << ": check failed: " #condition << std::endl; \
+			++gNumFailures; \
+		} \
+	} while (false)
+
+	// An action_type_command which reads and writes the given range of the given buffer in a compute shader, and says so via its sync hint:
+	avk::command::action_type_command hinted_writer(const avk::buffer_t& aBuffer, std::optional<std::tuple<vk::DeviceSize, vk::DeviceSize>> aRange = {})
+	{
+		avk::sync::sync_hint hint;
+		hint.mDstForPreviousCmds   = avk::stage_and_access_precisely{ vk::PipelineStageFlagBits2KHR::eComputeShader, vk::AccessFlagBits2KHR::eShaderStorageRead | vk::AccessFlagBits2KHR::eShaderStorageWrite };
+		hint.mSrcForSubsequentCmds = avk::stage_and_access_precisely{ vk::PipelineStageFlagBits2KHR::eComputeShader, vk::AccessFlagBits2KHR::eShaderStorageWrite };
+		hint.mBufferOffsetSizeAffected = aRange;
+		avk::command::action_type_command cmd;
+		cmd.mResourceSpecificSyncHints.emplace_back(std::variant<vk::Image, vk::Buffer>{ aBuffer.handle() }, hint);
+		cmd.infer_sync_hint_from_resource_sync_hints();
+		return cmd;
+	}
+
+	// An action_type_command which does not specify what it accesses, e.g., a dispatch that writes the buffer through a descriptor:
+	avk::command::action_type_command unhinted_command()
+	{
+		return avk::command::action_type_command{};
+	}
+
+	avk::sync::sync_type_command auto_barrier(const avk::buffer_t& aBuffer)
+	{
+		return avk::sync::buffer_memory_barrier(aBuffer, avk::stage::auto_stage >> avk::stage::auto_stage, avk::access::auto_access >> avk::access::auto_access);
+	}
+
+	size_t num_barriers(const std::vector<avk::recorded_commands_t>& aCommands)
+	{
+		return static_cast<size_t>(std::count_if(std::begin(aCommands), std::end(aCommands), [](const avk::recorded_commands_t& r) {
+			return std::holds_alternative<avk::sync::sync_type_command>(r);
+		}));
+	}
+
+	void test_covered_barrier_without_commands_in_between_is_removed()
+	{
+		avk::buffer_t buffer;
+		std::vector<avk::recorded_commands_t> commands{ hinted_writer(buffer), auto_barrier(buffer), auto_barrier(buffer), hinted_writer(buffer) };
+
+		const avk::sync::resource_state_tracker tracker{ commands };
+		AVK_TEST_CHECK(!tracker.scopes_at(1).mIsNoOp);
+		AVK_TEST_CHECK(tracker.scopes_at(2).mIsNoOp);
+
+		avk::recorded_commands recorded{ nullptr, std::move(commands) };
+		recorded.eliminate_redundant_barriers();
+		AVK_TEST_CHECK(1 == recorded.barrier_elimination_stats().num_barriers_removed());
+		std::vector<avk::recorded_commands_t> remaining;
+		recorded.move_into(remaining);
+		AVK_TEST_CHECK(1 == num_barriers(remaining));
+	}
+
+	void test_unhinted_writer_between_barriers_keeps_both()
+	{
+		// The second barrier guards the unhinted command's writes and must neither be skipped nor removed:
+		avk::buffer_t buffer;
+		std::vector<avk::recorded_commands_t> commands{ hinted_writer(buffer), auto_barrier(buffer), unhinted_command(), auto_barrier(buffer), hinted_writer(buffer) };
+
+		const avk::sync::resource_state_tracker tracker{ commands };
+		AVK_TEST_CHECK(!tracker.scopes_at(1).mIsNoOp);
+		AVK_TEST_CHECK(!tracker.scopes_at(3).mIsNoOp);
+
+		avk::recorded_commands recorded{ nullptr, std::move(commands) };
+		recorded.eliminate_redundant_barriers();
+		AVK_TEST_CHECK(0 == recorded.barrier_elimination_stats().num_barriers_removed());
+		std::vector<avk::recorded_commands_t> remaining;
+		recorded.move_into(remaining);
+		AVK_TEST_CHECK(2 == num_barriers(remaining));
+	}
+
+	void test_barrier_with_fixed_destination_scopes_is_not_skipped()
+	{
+		avk::buffer_t buffer;
+		auto fixedDst = avk::sync::buffer_memory_barrier(buffer, avk::stage::auto_stage >> avk::stage::fragment_shader, avk::access::auto_access >> avk::access::shader_storage_read);
+		std::vector<avk::recorded_commands_t> commands{ hinted_writer(buffer), auto_barrier(buffer), fixedDst, hinted_writer(buffer) };
+
+		const avk::sync::resource_state_tracker tracker{ commands };
+		AVK_TEST_CHECK(!tracker.scopes_at(2).mIsNoOp);
+	}
+
+	void test_narrowing_requires_all_commands_to_be_hinted()
+	{
+		avk::buffer_t buffer;
+		{
+			std::vector<avk::recorded_commands_t> commands{ hinted_writer(buffer, std::make_tuple(vk::DeviceSize{ 0 }, vk::DeviceSize{ 256 })), auto_barrier(buffer) };
+			const avk::sync::resource_state_tracker tracker{ commands };
+			AVK_TEST_CHECK(tracker.scopes_at(1).mNarrowedOffsetAndSize.has_value());
+			if (tracker.scopes_at(1).mNarrowedOffsetAndSize.has_value()) {
+				AVK_TEST_CHECK(0 == std::get<0>(tracker.scopes_at(1).mNarrowedOffsetAndSize.value()));
+				AVK_TEST_CHECK(256 == std::get<1>(tracker.scopes_at(1).mNarrowedOffsetAndSize.value()));
+			}
+		}
+		{
+			// The unhinted command might have written anywhere into the buffer => the barrier must stay as wide as it is:
+			std::vector<avk::recorded_commands_t> commands{ hinted_writer(buffer, std::make_tuple(vk::DeviceSize{ 0 }, vk::DeviceSize{ 256 })), unhinted_command(), auto_barrier(buffer) };
+			const avk::sync::resource_state_tracker tracker{ commands };
+			AVK_TEST_CHECK(!tracker.scopes_at(2).mNarrowedOffsetAndSize.has_value());
+		}
+	}
+}
+
+int main()
+{
+	test_covered_barrier_without_commands_in_between_is_removed();
+	test_unhinted_writer_between_barriers_keeps_both();
+	test_barrier_with_fixed_destination_scopes_is_not_skipped();
+	test_narrowing_requires_all_commands_to_be_hinted();
+
+	if (gNumFailures > 0) {
+		std::cerr << gNumFailures << " check(s) failed." << std::endl;
+		return 1;
+	}
+	std::cout << "All checks passed." << std::endl;
+	return 0;
+}
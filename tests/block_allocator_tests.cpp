@@ -0,0 +1,267 @@
+// Exercises avk::tlsf_free_list and avk::block_allocator against a made-up memory properties table,
+// i.e., without a Vulkan device: vk::DeviceMemory handles are fake, and mapped memory is backed by host allocations.
+#include "avk/avk.hpp"
+#include <cstring>
+#include <iostream>
+#include <map>
+
+namespace
+{
+	int gNumFailures = 0;
+
+#define AVK_TEST_CHECK(condition) \
+	do { \
+		if (!(condition)) { \
+			std::cerr << __FILE__ << ":" << __LINE__ << ": check failed: " #condition << std::endl; \
+			++gNumFailures; \
+		} \
+	} while (false)
+
+	constexpr vk::DeviceSize kBlockSize = 1024 * 1024;
+
+	// Memory type indices of the fake memory properties table:
+	constexpr uint32_t kDeviceLocal = 0;
+	constexpr uint32_t kHostCoherent = 1;
+	constexpr uint32_t kHostNonCoherent = 2;
+
+	vk::PhysicalDeviceMemoryProperties fake_memory_properties()
+	{
+		vk::PhysicalDeviceMemoryProperties props;
+		props.memoryHeapCount = 2;
+		props.memoryHeaps[0] = vk::MemoryHeap{ 1024 * kBlockSize, vk::MemoryHeapFlagBits::eDeviceLocal };
+		props.memoryHeaps[1] = vk::MemoryHeap{ 1024 * kBlockSize, vk::MemoryHeapFlags{} };
+		props.memoryTypeCount = 3;
+		props.memoryTypes[kDeviceLocal]     = vk::MemoryType{ vk::MemoryPropertyFlagBits::eDeviceLocal, 0 };
+		props.memoryTypes[kHostCoherent]    = vk::MemoryType{ vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent, 1 };
+		props.memoryTypes[kHostNonCoherent] = vk::MemoryType{ vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCached, 1 };
+		return props;
+	}
+
+	// Hands out fake vk::DeviceMemory handles and keeps track of them
+	struct fake_device
+	{
+		vk::DeviceMemory allocate(uint32_t aMemoryTypeIndex, vk::DeviceSize aSize, vk::MemoryAllocateFlags)
+		{
+			if (aSize > mMaxAllocationSize) {
+				throw vk::OutOfDeviceMemoryError("fake_device::allocate");
+			}
+			uint64_t value = ++mNumAllocationsEver;
+			VkDeviceMemory handle;
+			std::memcpy(&handle, &value, sizeof(handle));
+			const auto memory = vk::DeviceMemory{ handle };
+			mSizes[memory] = aSize;
+			mMemoryTypes[memory] = aMemoryTypeIndex;
+			return memory;
+		}
+
+		void free(vk::DeviceMemory aMemory)
+		{
+			AVK_TEST_CHECK(1 == mSizes.count(aMemory));
+			mSizes.erase(aMemory);
+			mMemoryTypes.erase(aMemory);
+			mMappedMemory.erase(aMemory);
+		}
+
+		void* map(vk::DeviceMemory aMemory)
+		{
+			auto& backing = mMappedMemory[aMemory];
+			backing.resize(static_cast<size_t>(mSizes.at(aMemory)));
+			return backing.data();
+		}
+
+		avk::block_allocator make_allocator(vk::DeviceSize aBufferImageGranularity, vk::DeviceSize aNonCoherentAtomSize = 64)
+		{
+			return avk::block_allocator{
+				fake_memory_properties(), aBufferImageGranularity, aNonCoherentAtomSize,
+				[this](uint32_t aMemoryTypeIndex, vk::DeviceSize aSize, vk::MemoryAllocateFlags aFlags) { return allocate(aMemoryTypeIndex, aSize, aFlags); },
+				[this](vk::DeviceMemory aMemory) { free(aMemory); },
+				[this](vk::DeviceMemory aMemory) { return map(aMemory); },
+				kBlockSize
+			};
+		}
+
+		vk::DeviceSize mMaxAllocationSize = std::numeric_limits<vk::DeviceSize>::max();
+		uint64_t mNumAllocationsEver = 0;
+		std::map<vk::DeviceMemory, vk::DeviceSize> mSizes;
+		std::map<vk::DeviceMemory, uint32_t> mMemoryTypes;
+		std::map<vk::DeviceMemory, std::vector<std::byte>> mMappedMemory;
+	};
+
+	vk::MemoryRequirements requirements(vk::DeviceSize aSize, vk::DeviceSize aAlignment, uint32_t aMemoryTypeBits = ~0u)
+	{
+		return vk::MemoryRequirements{ aSize, aAlignment, aMemoryTypeBits };
+	}
+
+	void test_free_list_allocates_aligned_ranges_and_merges_on_free()
+	{
+		avk::tlsf_free_list list{ 4096 };
+		auto a = list.allocate(100, 1);
+		auto b = list.allocate(100, 256);
+		auto c = list.allocate(1, 1024);
+		AVK_TEST_CHECK(a.has_value() && b.has_value() && c.has_value());
+		AVK_TEST_CHECK(0 == std::get<vk::DeviceSize>(*b) % 256);
+		AVK_TEST_CHECK(0 == std::get<vk::DeviceSize>(*c) % 1024);
+		AVK_TEST_CHECK(std::get<vk::DeviceSize>(*b) >= std::get<vk::DeviceSize>(*a) + 100);
+
+		list.free(std::get<uint32_t>(*b));
+		list.free(std::get<uint32_t>(*a));
+		list.free(std::get<uint32_t>(*c));
+		AVK_TEST_CHECK(list.empty());
+
+		// Everything has been merged again => the whole range can be handed out at once:
+		auto all = list.allocate_front(4096);
+		AVK_TEST_CHECK(all.has_value() && 0 == std::get<vk::DeviceSize>(*all));
+		AVK_TEST_CHECK(!list.allocate(1, 1).has_value());
+		list.free(std::get<uint32_t>(*all));
+	}
+
+	void test_free_list_allocate_front_fits_exactly()
+	{
+		// allocate() rounds up to the next size class, which does not fit into a range of exactly the requested size:
+		avk::tlsf_free_list list{ 600000 };
+		auto r = list.allocate_front(600000);
+		AVK_TEST_CHECK(r.has_value() && 0 == std::get<vk::DeviceSize>(*r));
+		AVK_TEST_CHECK(600000 == list.size_in_use());
+		AVK_TEST_CHECK(!list.allocate_front(1).has_value());
+		list.free(std::get<uint32_t>(*r));
+		AVK_TEST_CHECK(list.empty());
+	}
+
+	void test_small_allocations_share_a_block()
+	{
+		fake_device device;
+		auto allocator = device.make_allocator(1);
+		std::vector<avk::block_allocation> allocations;
+		for (int i = 0; i < 64; ++i) {
+			allocations.push_back(allocator.allocate(requirements(1000, 256), vk::MemoryPropertyFlagBits::eDeviceLocal, true));
+			AVK_TEST_CHECK(0 == allocations.back().mOffset % 256);
+			AVK_TEST_CHECK(kDeviceLocal == allocations.back().mMemoryTypeIndex);
+		}
+		AVK_TEST_CHECK(1 == allocator.statistics().mNumDeviceMemoryAllocations);
+		AVK_TEST_CHECK(64 == allocator.statistics().mNumAllocations);
+
+		// No two allocations overlap:
+		std::sort(std::begin(allocations), std::end(allocations), [](const auto& a, const auto& b) { return a.mOffset < b.mOffset; });
+		for (size_t i = 1; i < allocations.size(); ++i) {
+			AVK_TEST_CHECK(allocations[i - 1].mOffset + allocations[i - 1].mSize <= allocations[i].mOffset);
+		}
+
+		for (const auto& a : allocations) {
+			allocator.free(a);
+		}
+		AVK_TEST_CHECK(0 == allocator.statistics().mNumAllocations);
+		AVK_TEST_CHECK(0 == allocator.statistics().mUsedBytes);
+	}
+
+	void test_dedicated_allocations()
+	{
+		fake_device device;
+		auto allocator = device.make_allocator(1);
+
+		// Larger than half a block, with sizes and alignments that do not match a size class:
+		const auto a = allocator.allocate(requirements(kBlockSize / 2 + 1, 4096), vk::MemoryPropertyFlagBits::eDeviceLocal, true);
+		const auto b = allocator.allocate(requirements(3 * kBlockSize + 12345, 65536), vk::MemoryPropertyFlagBits::eDeviceLocal, false);
+		AVK_TEST_CHECK(0 == a.mOffset && 0 == b.mOffset);
+		AVK_TEST_CHECK(a.mMemory != b.mMemory);
+		AVK_TEST_CHECK(kBlockSize / 2 + 1 == device.mSizes.at(a.mMemory));
+		AVK_TEST_CHECK(3 * kBlockSize + 12345 == device.mSizes.at(b.mMemory));
+		AVK_TEST_CHECK(2 == allocator.statistics().mNumDeviceMemoryAllocations);
+
+		// Dedicated blocks are freed together with their allocation:
+		allocator.free(a);
+		allocator.free(b);
+		AVK_TEST_CHECK(0 == allocator.statistics().mNumDeviceMemoryAllocations);
+		AVK_TEST_CHECK(device.mSizes.empty());
+	}
+
+	void test_block_size_is_halved_when_out_of_memory()
+	{
+		fake_device device;
+		device.mMaxAllocationSize = kBlockSize / 4;
+		auto allocator = device.make_allocator(1);
+
+		// Fits into a quarter block, but not into the size class which allocate() would round it up to:
+		const auto a = allocator.allocate(requirements(kBlockSize / 4 - 100, 256), vk::MemoryPropertyFlagBits::eDeviceLocal, true);
+		AVK_TEST_CHECK(0 == a.mOffset);
+		AVK_TEST_CHECK(kBlockSize / 4 == device.mSizes.at(a.mMemory));
+		allocator.free(a);
+
+		// Does not fit at all:
+		bool thrown = false;
+		try {
+			allocator.allocate(requirements(kBlockSize / 4 + 1, 1), vk::MemoryPropertyFlagBits::eDeviceLocal, true);
+		}
+		catch (vk::OutOfDeviceMemoryError&) {
+			thrown = true;
+		}
+		AVK_TEST_CHECK(thrown);
+	}
+
+	void test_buffer_image_granularity()
+	{
+		{
+			fake_device device;
+			auto allocator = device.make_allocator(4096);
+			const auto linear  = allocator.allocate(requirements(100, 16), vk::MemoryPropertyFlagBits::eDeviceLocal, true);
+			const auto optimal = allocator.allocate(requirements(100, 16), vk::MemoryPropertyFlagBits::eDeviceLocal, false);
+			// Linear and optimal resources must never be neighbors within the same block:
+			AVK_TEST_CHECK(linear.mMemory != optimal.mMemory);
+			AVK_TEST_CHECK(2 == allocator.statistics().mNumDeviceMemoryAllocations);
+			allocator.free(linear);
+			allocator.free(optimal);
+		}
+		{
+			fake_device device;
+			auto allocator = device.make_allocator(1);
+			const auto linear  = allocator.allocate(requirements(100, 16), vk::MemoryPropertyFlagBits::eDeviceLocal, true);
+			const auto optimal = allocator.allocate(requirements(100, 16), vk::MemoryPropertyFlagBits::eDeviceLocal, false);
+			// Without a granularity constraint, they can share a block:
+			AVK_TEST_CHECK(linear.mMemory == optimal.mMemory);
+			AVK_TEST_CHECK(1 == allocator.statistics().mNumDeviceMemoryAllocations);
+			allocator.free(linear);
+			allocator.free(optimal);
+		}
+	}
+
+	void test_host_visible_allocations()
+	{
+		fake_device device;
+		auto allocator = device.make_allocator(1, 64);
+
+		const auto coherent = allocator.allocate(requirements(10, 4, 1u << kHostCoherent), vk::MemoryPropertyFlagBits::eHostVisible, true);
+		AVK_TEST_CHECK(kHostCoherent == coherent.mMemoryTypeIndex);
+		AVK_TEST_CHECK(nullptr != coherent.mMappedMemory);
+		AVK_TEST_CHECK(10 == coherent.mSize);
+
+		// Non-coherent ranges are padded to whole atoms:
+		const auto nonCoherent1 = allocator.allocate(requirements(10, 4, 1u << kHostNonCoherent), vk::MemoryPropertyFlagBits::eHostVisible, true);
+		const auto nonCoherent2 = allocator.allocate(requirements(10, 4, 1u << kHostNonCoherent), vk::MemoryPropertyFlagBits::eHostVisible, true);
+		AVK_TEST_CHECK(kHostNonCoherent == nonCoherent1.mMemoryTypeIndex);
+		AVK_TEST_CHECK(64 == nonCoherent1.mSize && 0 == nonCoherent1.mOffset % 64);
+		AVK_TEST_CHECK(64 == nonCoherent2.mSize && 0 == nonCoherent2.mOffset % 64);
+		AVK_TEST_CHECK(static_cast<std::byte*>(nonCoherent2.mMappedMemory) - static_cast<std::byte*>(nonCoherent1.mMappedMemory)
+			== static_cast<std::ptrdiff_t>(nonCoherent2.mOffset) - static_cast<std::ptrdiff_t>(nonCoherent1.mOffset));
+
+		allocator.free(coherent);
+		allocator.free(nonCoherent1);
+		allocator.free(nonCoherent2);
+	}
+}
+
+int main()
+{
+	test_free_list_allocates_aligned_ranges_and_merges_on_free();
+	test_free_list_allocate_front_fits_exactly();
+	test_small_allocations_share_a_block();
+	test_dedicated_allocations();
+	test_block_size_is_halved_when_out_of_memory();
+	test_buffer_image_granularity();
+	test_host_visible_allocations();
+
+	if (gNumFailures > 0) {
+		std::cerr << gNumFailures << " check(s) failed." << std::endl;
+		return 1;
+	}
+	std::cout << "All checks passed." << std::endl;
+	return 0;
+}
@@ -0,0 +1,185 @@
+// Exercises avk::inline_function: inline storage and heap fallback, copying and moving, conversions from empty callables
+// and from std::function, and access to the stored callable via target.
+#include "avk/avk.hpp"
+#include <array>
+#include <iostream>
+
+namespace
+{
+	int gNumFailures = 0;
+
+#define AVK_TEST_CHECK(condition) \
+	do { \
+		if (!(condition)) { \
+			std::cerr << __FILE__ << ":" << __LINE__ << ": check failed: " #condition << std::endl; \
+			++gNumFailures; \
+		} \
+	} while (false)
+
+	constexpr size_t kCapacity = 32;
+	using function_t = avk::inline_function<int(int), kCapacity>;
+
+	// A callable of (at least) N bytes which keeps track of how many instances of it are alive
+	template <size_t N>
+	struct counted_adder
+	{
+		static inline int sNumAlive = 0;
+
+		explicit counted_adder(int aSummand) : mSummand{ aSummand } { ++sNumAlive; }
+		counted_adder(const counted_adder& aOther) : mPadding{ aOther.mPadding }, mSummand{ aOther.mSummand } { ++sNumAlive; }
+		counted_adder(counted_adder&& aOther) noexcept : mPadding{ aOther.mPadding }, mSummand{ aOther.mSummand } { ++sNumAlive; }
+		counted_adder& operator=(const counted_adder&) = default;
+		counted_adder& operator=(counted_adder&&) noexcept = default;
+		~counted_adder() { --sNumAlive; }
+
+		int operator()(int aValue) const { return aValue + mSummand; }
+
+		std::array<std::byte, N> mPadding{};
+		int mSummand;
+	};
+
+	using small_adder = counted_adder<8>;
+	using large_adder = counted_adder<4 * kCapacity>;
+	static_assert(sizeof(small_adder) <= kCapacity);
+	static_assert(sizeof(large_adder) > kCapacity);
+
+	// A small callable which must nevertheless be stored on the heap, because moving it could throw
+	struct throwing_move_adder
+	{
+		throwing_move_adder() = default;
+		throwing_move_adder(const throwing_move_adder&) = default;
+		throwing_move_adder(throwing_move_adder&&) noexcept(false) = default;
+		int operator()(int aValue) const { return aValue + 3; }
+	};
+
+	int add_one(int aValue)
+	{
+		return aValue + 1;
+	}
+
+	template <typename Adder>
+	void check_copy_and_move()
+	{
+		{
+			function_t f{ Adder{ 5 } };
+			AVK_TEST_CHECK(static_cast<bool>(f));
+			AVK_TEST_CHECK(15 == f(10));
+			AVK_TEST_CHECK(1 == Adder::sNumAlive);
+
+			function_t copy{ f };
+			AVK_TEST_CHECK(2 == Adder::sNumAlive);
+			AVK_TEST_CHECK(15 == copy(10));
+			AVK_TEST_CHECK(15 == f(10));
+
+			function_t moved{ std::move(f) };
+			AVK_TEST_CHECK(!f);
+			AVK_TEST_CHECK(2 == Adder::sNumAlive);
+			AVK_TEST_CHECK(15 == moved(10));
+
+			function_t assigned;
+			assigned = std::move(moved);
+			AVK_TEST_CHECK(!moved);
+			AVK_TEST_CHECK(2 == Adder::sNumAlive);
+			AVK_TEST_CHECK(15 == assigned(10));
+
+			assigned = copy;
+			AVK_TEST_CHECK(2 == Adder::sNumAlive);
+
+			copy = nullptr;
+			AVK_TEST_CHECK(!copy);
+			AVK_TEST_CHECK(1 == Adder::sNumAlive);
+
+			function_t other{ add_one };
+			swap(assigned, other);
+			AVK_TEST_CHECK(2 == assigned(1));
+			AVK_TEST_CHECK(6 == other(1));
+			AVK_TEST_CHECK(1 == Adder::sNumAlive);
+		}
+		AVK_TEST_CHECK(0 == Adder::sNumAlive);
+	}
+
+	void test_small_callables_are_copied_and_moved()
+	{
+		check_copy_and_move<small_adder>();
+	}
+
+	void test_large_callables_fall_back_to_the_heap()
+	{
+		check_copy_and_move<large_adder>();
+
+		function_t f{ throwing_move_adder{} };
+		function_t moved{ std::move(f) };
+		AVK_TEST_CHECK(!f);
+		AVK_TEST_CHECK(4 == moved(1));
+	}
+
+	void test_empty_callables_become_empty_functions()
+	{
+		function_t defaulted;
+		AVK_TEST_CHECK(!defaulted);
+
+		function_t fromNullptr{ nullptr };
+		AVK_TEST_CHECK(!fromNullptr);
+
+		int (*nullFunctionPointer)(int) = nullptr;
+		function_t fromNullFunctionPointer{ nullFunctionPointer };
+		AVK_TEST_CHECK(!fromNullFunctionPointer);
+
+		function_t fromEmptyStdFunction{ std::function<int(int)>{} };
+		AVK_TEST_CHECK(!fromEmptyStdFunction);
+
+		bool thrown = false;
+		try {
+			fromEmptyStdFunction(1);
+		}
+		catch (const std::bad_function_call&) {
+			thrown = true;
+		}
+		AVK_TEST_CHECK(thrown);
+	}
+
+	void test_conversion_from_std_function()
+	{
+		std::function<int(int)> stdFunction = [](int aValue) { return 2 * aValue; };
+		function_t f{ stdFunction };
+		AVK_TEST_CHECK(static_cast<bool>(f));
+		AVK_TEST_CHECK(8 == f(4));
+
+		// The std::function has been copied:
+		stdFunction = nullptr;
+		AVK_TEST_CHECK(8 == f(4));
+	}
+
+	void test_target_returns_the_stored_callable()
+	{
+		function_t small{ small_adder{ 1 } };
+		AVK_TEST_CHECK(nullptr != small.target<small_adder>());
+		AVK_TEST_CHECK(1 == small.target<small_adder>()->mSummand);
+		AVK_TEST_CHECK(nullptr == small.target<large_adder>());
+
+		function_t large{ large_adder{ 2 } };
+		AVK_TEST_CHECK(nullptr != large.target<large_adder>());
+		AVK_TEST_CHECK(2 == large.target<large_adder>()->mSummand);
+		AVK_TEST_CHECK(nullptr == large.target<small_adder>());
+
+		function_t empty;
+		AVK_TEST_CHECK(nullptr == empty.target<small_adder>());
+		AVK_TEST_CHECK(nullptr == empty.target<int>());
+	}
+}
+
+int main()
+{
+	test_small_callables_are_copied_and_moved();
+	test_large_callables_fall_back_to_the_heap();
+	test_empty_callables_become_empty_functions();
+	test_conversion_from_std_function();
+	test_target_returns_the_stored_callable();
+
+	if (gNumFailures > 0) {
+		std::cerr << gNumFailures << " check(s) failed." << std::endl;
+		return 1;
+	}
+	std::cout << "All checks passed." << std::endl;
+	return 0;
+}